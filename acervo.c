@@ -0,0 +1,508 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "acervo.h"
+#include "hardware/sync.h"
+#include "pico/flash.h"
+
+#define MAGICA_SETOR 0x56524341u     // "ACRV"
+#define MAGICA_REGISTRO 0x4D494E41u  // "ANIM"
+#define ESTADO_CONFIRMADO 0x464E4F43u
+#define VAZIO 0xFFFFFFFFu            // Flash apagada: palavra livre, id sem registro
+
+// Espera máxima para o outro núcleo parar antes de apagar ou gravar
+#define FLASH_TIMEOUT_MS 100
+
+// Primeira página de cada setor
+typedef struct {
+    uint32_t magica;
+    uint32_t geracao;       // Cresce a cada setor aberto; o maior é o atual
+    uint32_t apagamentos;   // Desgaste do setor
+    uint32_t indice[ACERVO_MAX_ANIMACOES]; // Deslocamento do registro vivo de cada id (VAZIO: nenhum)
+    uint32_t crc;           // CRC-16 dos campos acima
+} CabecalhoSetor;
+
+// Início de cada registro, sempre no começo de uma página; os quadros vêm logo depois
+typedef struct {
+    uint32_t magica;
+    uint8_t id;
+    uint8_t fps;
+    uint16_t num_quadros;   // 0: apaga o id
+    uint16_t r, g, b;
+    uint16_t crc;           // Dos 12 bytes acima e dos quadros; gravado junto com `estado`
+    uint32_t estado;        // VAZIO enquanto grava, ESTADO_CONFIRMADO no fim
+} RegistroAcervo;
+
+#define BYTES_CRC_REGISTRO offsetof(RegistroAcervo, crc)
+
+_Static_assert(sizeof(RegistroAcervo) == ACERVO_CABECALHO_REGISTRO, "cabecalho do registro");
+_Static_assert(sizeof(CabecalhoSetor) <= FLASH_PAGE_SIZE, "cabecalho do setor cabe numa pagina");
+_Static_assert(ACERVO_INICIO % FLASH_SECTOR_SIZE == 0, "acervo alinhado a setores");
+
+static uint32_t indice[ACERVO_MAX_ANIMACOES];
+static Animacao animacoes[ACERVO_MAX_ANIMACOES];
+
+// indice[] e animacoes[] só mudam no núcleo que grava e são lidos também pelo
+// outro (comando 'a', relatório). `versao` fica ímpar enquanto o escritor mexe
+// neles; o leitor copia e repete se ela mudou no meio.
+static volatile uint32_t versao = 0;
+static uint setor_atual;
+static uint32_t geracao;    // 0: nenhum setor aberto ainda
+static uint32_t cabeca;     // Próxima página livre, em deslocamento na região
+static uint32_t lidos_boot, movidos;
+static bool movendo = false;
+
+// Página em RAM: durante a gravação a XIP está desligada, então a origem não pode
+// estar na flash
+static uint8_t pagina[FLASH_PAGE_SIZE];
+
+// Registro sendo gravado
+static struct {
+    uint32_t inicio, pos;
+    uint usados;            // Bytes em `pagina`
+    uint16_t crc;
+    uint8_t id;
+    uint16_t num_quadros;
+} gravacao;
+
+static volatile bool ativo = false;
+
+static const uint8_t *xip(uint32_t deslocamento) {
+    return (const uint8_t *)XIP_BASE + ACERVO_INICIO + deslocamento;
+}
+
+static const CabecalhoSetor *cabecalho_setor(uint s) {
+    return (const CabecalhoSetor *)xip(s * FLASH_SECTOR_SIZE);
+}
+
+static const RegistroAcervo *registro(uint32_t deslocamento) {
+    return (const RegistroAcervo *)xip(deslocamento);
+}
+
+static uint32_t fim_setor(uint s) {
+    return (s + 1) * FLASH_SECTOR_SIZE;
+}
+
+static uint32_t bytes_registro(uint num_quadros) {
+    uint32_t n = ACERVO_CABECALHO_REGISTRO + num_quadros * BYTES_POR_QUADRO;
+    return (n + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+}
+
+static uint16_t crc_setor(const CabecalhoSetor *h) {
+    return fluxo_crc16(FLUXO_CRC_INICIAL, (const uint8_t *)h, offsetof(CabecalhoSetor, crc));
+}
+
+static bool setor_valido(const CabecalhoSetor *h) {
+    return h->magica == MAGICA_SETOR && h->crc == crc_setor(h);
+}
+
+static bool registro_valido(const RegistroAcervo *r) {
+    if (r->magica != MAGICA_REGISTRO || r->estado != ESTADO_CONFIRMADO || r->id >= ACERVO_MAX_ANIMACOES
+        || r->num_quadros > ACERVO_MAX_QUADROS) {
+        return false;
+    }
+    uint16_t crc = fluxo_crc16(FLUXO_CRC_INICIAL, (const uint8_t *)r, BYTES_CRC_REGISTRO);
+    crc = fluxo_crc16(crc, (const uint8_t *)(r + 1), r->num_quadros * BYTES_POR_QUADRO);
+    return crc == r->crc;
+}
+
+static void publicacao_abrir(void) {
+    versao++;
+    __dmb();
+}
+
+static void publicacao_fechar(void) {
+    __dmb();
+    versao++;
+}
+
+// Registro do id (VAZIO se não houver) e cópia da sua Animacao, de uma versão só
+static uint32_t ler_registro(uint id, Animacao *copia) {
+    while (true) {
+        uint32_t v = versao;
+        if (v & 1) {
+            tight_loop_contents();
+            continue;
+        }
+        __dmb();
+        uint32_t d = indice[id];
+        *copia = animacoes[id];
+        __dmb();
+        if (versao == v) {
+            return d;
+        }
+    }
+}
+
+static bool pagina_livre(uint32_t deslocamento) {
+    const uint32_t *p = (const uint32_t *)xip(deslocamento);
+    for (uint i = 0; i < FLASH_PAGE_SIZE / 4; i++) {
+        if (p[i] != VAZIO) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Animacao do id a partir do índice; entradas que não apontam para um registro
+// válido desse id viram VAZIO
+static void atualizar_animacao(uint id) {
+    uint32_t d = indice[id];
+    const RegistroAcervo *r = d < ACERVO_TAMANHO ? registro(d) : NULL;
+    if (!r || !registro_valido(r) || r->id != id || r->num_quadros == 0) {
+        indice[id] = VAZIO;
+        animacoes[id] = (Animacao) { 0 };
+        return;
+    }
+    animacoes[id] = (Animacao) {
+        .frames = (const uint8_t (*)[BYTES_POR_QUADRO])(r + 1), // Direto da XIP
+        .num_frames = r->num_quadros,
+        .r = r->r,
+        .g = r->g,
+        .b = r->b,
+        .fps = r->fps,
+    };
+}
+
+// ---------------------------------------------------------------------------
+// Flash: apagar e gravar com o outro núcleo parado e as interrupções desligadas
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t deslocamento;
+    const uint8_t *dados;
+} OperacaoFlash;
+
+static void apagar_setor(void *arg) {
+    const OperacaoFlash *op = arg;
+    flash_range_erase(ACERVO_INICIO + op->deslocamento, FLASH_SECTOR_SIZE);
+}
+
+static void gravar_pagina(void *arg) {
+    const OperacaoFlash *op = arg;
+    flash_range_program(ACERVO_INICIO + op->deslocamento, op->dados, FLASH_PAGE_SIZE);
+}
+
+static bool flash(void (*f)(void *), uint32_t deslocamento, const uint8_t *dados) {
+    OperacaoFlash op = { .deslocamento = deslocamento, .dados = dados };
+    return flash_safe_execute(f, &op, FLASH_TIMEOUT_MS) == PICO_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Log
+// ---------------------------------------------------------------------------
+
+static bool mover(uint id);
+
+static bool tem_registro_vivo(uint s) {
+    for (uint id = 0; id < ACERVO_MAX_ANIMACOES; id++) {
+        if (indice[id] != VAZIO && indice[id] / FLASH_SECTOR_SIZE == s) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Apaga o próximo setor do círculo e o abre com uma cópia do índice. Os registros
+// vivos do setor seguinte são copiados para este logo em seguida (cabem: vieram
+// de um setor só), para que o seguinte possa ser apagado na sua vez. Um setor que
+// ainda tem registro vivo (cópia interrompida por falta de energia) é pulado; com
+// no máximo ACERVO_MAX_ANIMACOES registros vivos sempre sobra setor para abrir.
+static bool abrir_setor(void) {
+    uint s = (setor_atual + 1) % ACERVO_SETORES;
+    while (tem_registro_vivo(s)) {
+        s = (s + 1) % ACERVO_SETORES;
+    }
+
+    const CabecalhoSetor *antigo = cabecalho_setor(s);
+    uint32_t apagamentos = setor_valido(antigo) ? antigo->apagamentos + 1 : 1;
+    if (!flash(apagar_setor, s * FLASH_SECTOR_SIZE, NULL)) {
+        return false;
+    }
+
+    CabecalhoSetor *h = (CabecalhoSetor *)pagina;
+    memset(pagina, 0xFF, sizeof(pagina));
+    h->magica = MAGICA_SETOR;
+    h->geracao = geracao + 1;
+    h->apagamentos = apagamentos;
+    memcpy(h->indice, indice, sizeof(indice));
+    h->crc = crc_setor(h);
+    if (!flash(gravar_pagina, s * FLASH_SECTOR_SIZE, pagina)) {
+        return false;
+    }
+    setor_atual = s;
+    geracao++;
+    cabeca = s * FLASH_SECTOR_SIZE + FLASH_PAGE_SIZE;
+
+    uint seguinte = (s + 1) % ACERVO_SETORES;
+    for (uint id = 0; id < ACERVO_MAX_ANIMACOES; id++) {
+        if (indice[id] != VAZIO && indice[id] / FLASH_SECTOR_SIZE == seguinte && !mover(id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Deixa `bytes` livres a partir da cabeça, no setor atual ou nos seguintes
+static bool reservar(uint32_t bytes) {
+    for (uint tentativa = 0; tentativa <= ACERVO_SETORES; tentativa++) {
+        if (geracao != 0 && cabeca + bytes <= fim_setor(setor_atual)) {
+            return true;
+        }
+        if (movendo || !abrir_setor()) {
+            return false; // Cópia de um registro vivo não abre outro setor
+        }
+    }
+    return false; // Todos os setores cheios de registros vivos
+}
+
+static bool gravacao_abrir(uint id, uint fps, uint16_t r, uint16_t g, uint16_t b, uint num_quadros) {
+    // fps 0 só num apagamento: tocado, daria um período infinito entre os quadros
+    if (id >= ACERVO_MAX_ANIMACOES || fps > 0xFF || (fps == 0 && num_quadros > 0)
+        || num_quadros > ACERVO_MAX_QUADROS) {
+        return false;
+    }
+    uint32_t bytes = bytes_registro(num_quadros);
+    if (!reservar(bytes)) {
+        return false;
+    }
+
+    memset(pagina, 0xFF, sizeof(pagina));
+    RegistroAcervo *c = (RegistroAcervo *)pagina;
+    c->magica = MAGICA_REGISTRO;
+    c->id = (uint8_t)id;
+    c->fps = (uint8_t)fps;
+    c->num_quadros = (uint16_t)num_quadros;
+    c->r = r;
+    c->g = g;
+    c->b = b;
+
+    gravacao.inicio = gravacao.pos = cabeca;
+    gravacao.usados = sizeof(RegistroAcervo);
+    gravacao.crc = fluxo_crc16(FLUXO_CRC_INICIAL, pagina, BYTES_CRC_REGISTRO);
+    gravacao.id = (uint8_t)id;
+    gravacao.num_quadros = (uint16_t)num_quadros;
+
+    // O espaço fica ocupado mesmo se a gravação não terminar: o registro é pulado
+    cabeca += bytes;
+    return true;
+}
+
+static bool gravacao_escrever(const uint8_t *dados, uint n) {
+    gravacao.crc = fluxo_crc16(gravacao.crc, dados, n);
+    while (n > 0) {
+        uint k = FLASH_PAGE_SIZE - gravacao.usados;
+        if (k > n) {
+            k = n;
+        }
+        memcpy(pagina + gravacao.usados, dados, k);
+        gravacao.usados += k;
+        dados += k;
+        n -= k;
+        if (gravacao.usados == FLASH_PAGE_SIZE) {
+            if (!flash(gravar_pagina, gravacao.pos, pagina)) {
+                return false;
+            }
+            gravacao.pos += FLASH_PAGE_SIZE;
+            gravacao.usados = 0;
+            memset(pagina, 0xFF, sizeof(pagina));
+        }
+    }
+    return true;
+}
+
+// Grava o resto e, se `valido`, confirma o registro e atualiza o índice
+static bool gravacao_fechar(bool valido) {
+    if (gravacao.usados > 0 && !flash(gravar_pagina, gravacao.pos, pagina)) {
+        return false;
+    }
+    if (!valido) {
+        return false;
+    }
+
+    // Só os bytes ainda apagados da primeira página mudam: CRC e confirmação
+    memset(pagina, 0xFF, sizeof(pagina));
+    RegistroAcervo *c = (RegistroAcervo *)pagina;
+    c->crc = gravacao.crc;
+    c->estado = ESTADO_CONFIRMADO;
+    if (!flash(gravar_pagina, gravacao.inicio, pagina)) {
+        return false;
+    }
+    publicacao_abrir();
+    indice[gravacao.id] = gravacao.num_quadros ? gravacao.inicio : VAZIO;
+    atualizar_animacao(gravacao.id);
+    publicacao_fechar();
+    return true;
+}
+
+static bool mover(uint id) {
+    const RegistroAcervo *r = registro(indice[id]);
+    movendo = true;
+    bool ok = acervo_gravar(id, r->fps, r->r, r->g, r->b, (const uint8_t (*)[BYTES_POR_QUADRO])(r + 1),
+                            r->num_quadros);
+    movendo = false;
+    movidos += ok;
+    return ok;
+}
+
+bool acervo_gravar(uint id, uint fps, uint16_t r, uint16_t g, uint16_t b,
+                   const uint8_t (*quadros)[BYTES_POR_QUADRO], uint num_quadros) {
+    if (!gravacao_abrir(id, fps, r, g, b, num_quadros)) {
+        return false;
+    }
+    bool ok = gravacao_escrever((const uint8_t *)quadros, num_quadros * BYTES_POR_QUADRO);
+    return gravacao_fechar(ok);
+}
+
+void acervo_init(void) {
+    publicacao_abrir();
+    memset(indice, 0xFF, sizeof(indice));
+    geracao = 0;
+    lidos_boot = 0;
+
+    // Setor atual: o de maior geração
+    for (uint s = 0; s < ACERVO_SETORES; s++) {
+        const CabecalhoSetor *h = cabecalho_setor(s);
+        if (setor_valido(h) && (geracao == 0 || (int32_t)(h->geracao - geracao) > 0)) {
+            geracao = h->geracao;
+            setor_atual = s;
+        }
+    }
+
+    if (geracao == 0) {
+        setor_atual = ACERVO_SETORES - 1; // A primeira gravação abre o setor 0
+    } else {
+        // Índice do momento em que o setor foi aberto + os registros gravados nele
+        memcpy(indice, cabecalho_setor(setor_atual)->indice, sizeof(indice));
+        uint32_t fim = fim_setor(setor_atual);
+        cabeca = setor_atual * FLASH_SECTOR_SIZE + FLASH_PAGE_SIZE;
+        while (cabeca < fim && !pagina_livre(cabeca)) {
+            const RegistroAcervo *r = registro(cabeca);
+            if (r->magica != MAGICA_REGISTRO || r->num_quadros > ACERVO_MAX_QUADROS
+                || cabeca + bytes_registro(r->num_quadros) > fim) {
+                cabeca = fim; // Página estragada: o setor não recebe mais nada
+                break;
+            }
+            lidos_boot++;
+            if (registro_valido(r)) {
+                indice[r->id] = r->num_quadros ? cabeca : VAZIO;
+            }
+            cabeca += bytes_registro(r->num_quadros);
+        }
+    }
+
+    for (uint id = 0; id < ACERVO_MAX_ANIMACOES; id++) {
+        atualizar_animacao(id);
+    }
+    publicacao_fechar();
+}
+
+bool acervo_animacao(uint id, Animacao *copia) {
+    return id < ACERVO_MAX_ANIMACOES && ler_registro(id, copia) != VAZIO;
+}
+
+void acervo_estado(EstadoAcervo *e) {
+    *e = (EstadoAcervo) {
+        .setor_atual = setor_atual,
+        .geracao = geracao,
+        .livre = geracao ? fim_setor(setor_atual) - cabeca : 0,
+        .registros_lidos_boot = lidos_boot,
+        .registros_movidos = movidos,
+        .apagamentos_min = UINT32_MAX,
+    };
+    for (uint id = 0; id < ACERVO_MAX_ANIMACOES; id++) {
+        e->animacoes += indice[id] != VAZIO;
+    }
+    for (uint s = 0; s < ACERVO_SETORES; s++) {
+        const CabecalhoSetor *h = cabecalho_setor(s);
+        uint32_t n = setor_valido(h) ? h->apagamentos : 0;
+        e->apagamentos_min = n < e->apagamentos_min ? n : e->apagamentos_min;
+        e->apagamentos_max = n > e->apagamentos_max ? n : e->apagamentos_max;
+    }
+}
+
+void acervo_relatorio(void) {
+    EstadoAcervo e;
+    acervo_estado(&e);
+    printf("Acervo: %u animacoes, setor %u (geracao %lu), %lu bytes livres no setor, "
+           "%lu registros lidos no boot, %lu movidos, apagamentos por setor %lu a %lu\n",
+           e.animacoes, e.setor_atual, (unsigned long)e.geracao, (unsigned long)e.livre,
+           (unsigned long)e.registros_lidos_boot, (unsigned long)e.registros_movidos,
+           (unsigned long)e.apagamentos_min, (unsigned long)e.apagamentos_max);
+    for (uint id = 0; id < ACERVO_MAX_ANIMACOES; id++) {
+        Animacao a;
+        uint32_t d = ler_registro(id, &a);
+        if (d != VAZIO) {
+            printf("  %2u: %3d quadros a %2d fps, setor %lu\n", id, a.num_frames, a.fps,
+                   (unsigned long)(d / FLASH_SECTOR_SIZE));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Gravação pelo USB
+// ---------------------------------------------------------------------------
+
+static void responder(const PortaFluxo *p, uint8_t tipo, uint8_t id) {
+    uint8_t resposta[3] = { FLUXO_SINC0, tipo, id };
+    p->escrever(resposta, sizeof(resposta));
+}
+
+bool acervo_sessao(const PortaFluxo *p) {
+    EstatisticasFluxo e = { 0 };
+    uint8_t ola[5] = { FLUXO_SINC0, FLUXO_INICIO, ACERVO_MAX_ANIMACOES, ACERVO_MAX_QUADROS & 0xFF,
+                       ACERVO_MAX_QUADROS >> 8 };
+    p->escrever(ola, sizeof(ola));
+
+    uint8_t cabecalho[ACERVO_CABECALHO_USB]; // id, fps, n, r, g, b
+    if (!fluxo_sincronizar(p, &e) || !fluxo_ler_tudo(p, cabecalho, sizeof(cabecalho), &e)) {
+        return false;
+    }
+    uint id = cabecalho[0];
+    uint n = cabecalho[2] | (cabecalho[3] << 8);
+    uint16_t crc = fluxo_crc16(FLUXO_CRC_INICIAL, cabecalho, sizeof(cabecalho));
+
+    // Cores de 0 a 255 -> 8.8 (255 -> COR_FX(1.0))
+    bool aberto = gravacao_abrir(id, cabecalho[1], cabecalho[4] << 8, cabecalho[5] << 8, cabecalho[6] << 8, n);
+    bool ok = aberto;
+
+    // Os quadros vão para a flash enquanto chegam; sem espaço, são lidos e descartados
+    uint8_t bloco[64];
+    uint32_t restantes = n * BYTES_POR_QUADRO;
+    while (restantes > 0) {
+        uint k = restantes < sizeof(bloco) ? restantes : sizeof(bloco);
+        if (!fluxo_ler_tudo(p, bloco, (int)k, &e)) {
+            if (aberto) {
+                gravacao_fechar(false);
+            }
+            return false;
+        }
+        crc = fluxo_crc16(crc, bloco, k);
+        ok = ok && gravacao_escrever(bloco, k);
+        restantes -= k;
+    }
+
+    uint8_t crc_recebido[2];
+    if (!fluxo_ler_tudo(p, crc_recebido, sizeof(crc_recebido), &e)) {
+        ok = false;
+    } else {
+        ok = ok && crc == (crc_recebido[0] | (crc_recebido[1] << 8));
+    }
+    if (aberto) {
+        ok = gravacao_fechar(ok);
+    }
+    responder(p, ok ? ACERVO_GRAVADO : FLUXO_REJEITADO, (uint8_t)id);
+    return ok;
+}
+
+void executar_acervo_usb(void) {
+    // Como no fluxo: o laço principal para de ler o USB antes do pacote de início
+    ativo = true;
+    bool ok = acervo_sessao(&fluxo_porta_usb);
+    ativo = false;
+    printf("Acervo: %s\n", ok ? "registro gravado" : "nada gravado");
+}
+
+bool acervo_usb_ativo(void) {
+    return ativo;
+}
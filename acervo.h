@@ -0,0 +1,88 @@
+#ifndef ACERVO_H
+#define ACERVO_H
+
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "animacao.h"
+#include "fluxo_usb.h"
+
+// Acervo de animações na flash: um log só de acréscimos nos últimos
+// ACERVO_SETORES setores da flash, gravado em tempo de execução (pelo USB) e
+// tocado direto do endereço da XIP, sem cópia para a RAM: os quadros de cada
+// registro estão no formato de Animacao.frames.
+//
+// Cada setor começa com um cabeçalho (geração e uma cópia do índice id ->
+// registro no momento em que o setor foi aberto) e recebe registros em páginas
+// inteiras. Um registro só vale depois da palavra de confirmação, gravada por
+// último; a versão mais nova de cada id é a que vale, e um registro sem quadros
+// apaga o id. Os setores são usados em círculo, então o desgaste fica igual em
+// todos; ao abrir um setor, os registros ainda vivos do seguinte são copiados
+// para ele, e o seguinte pode ser apagado quando chegar a sua vez. Nenhum setor
+// com registro vivo é apagado, então uma falta de energia no meio de qualquer
+// gravação deixa no máximo o registro que estava sendo gravado incompleto.
+//
+// Na inicialização basta ler os cabeçalhos dos setores e os registros do setor
+// mais novo: o índice salvo nele cobre todos os anteriores.
+
+#define ACERVO_SETORES 32
+#define ACERVO_TAMANHO (ACERVO_SETORES * FLASH_SECTOR_SIZE)
+#define ACERVO_INICIO (PICO_FLASH_SIZE_BYTES - ACERVO_TAMANHO) // Deslocamento na flash
+
+// Ids 0..ACERVO_MAX_ANIMACOES-1; com metade dos setores é sempre possível abrir espaço
+#define ACERVO_MAX_ANIMACOES 16
+
+// Cabeçalho de um registro na flash, seguido de num_quadros x BYTES_POR_QUADRO
+#define ACERVO_CABECALHO_REGISTRO 20
+
+// Um registro ocupa no máximo um setor, sem a página do cabeçalho do setor
+#define ACERVO_MAX_QUADROS ((FLASH_SECTOR_SIZE - FLASH_PAGE_SIZE - ACERVO_CABECALHO_REGISTRO) / BYTES_POR_QUADRO)
+
+// Lê o índice da flash; chamar antes de iniciar o pipeline
+void acervo_init(void);
+
+// Copia a animação guardada no id em `copia` (false se vazio). Serve nos dois
+// núcleos: a cópia nunca mistura duas versões, mesmo com uma gravação em curso no
+// outro. Os quadros apontam para a XIP e valem até a próxima gravação no acervo,
+// então só o núcleo que grava (o de renderização) pode tocá-los.
+bool acervo_animacao(uint id, Animacao *copia);
+
+// Grava uma versão nova do id (num_quadros = 0 apaga). Cores em 8.8. Retorna
+// false se os dados forem inválidos, não houver espaço ou a flash falhar.
+bool acervo_gravar(uint id, uint fps, uint16_t r, uint16_t g, uint16_t b,
+                   const uint8_t (*quadros)[BYTES_POR_QUADRO], uint num_quadros);
+
+typedef struct {
+    uint animacoes;                 // Ids com animação
+    uint setor_atual;
+    uint32_t geracao;
+    uint32_t livre;                 // Bytes livres no setor atual
+    uint32_t registros_lidos_boot;  // Registros lidos pelo acervo_init
+    uint32_t registros_movidos;     // Cópias de registros vivos ao abrir setores
+    uint32_t apagamentos_min, apagamentos_max; // Desgaste dos setores
+} EstadoAcervo;
+
+void acervo_estado(EstadoAcervo *e);
+
+// Lista os ids, os endereços e o desgaste dos setores
+void acervo_relatorio(void);
+
+// Gravação pelo USB (comando 'u'). Ao abrir a sessão o Pico responde
+//   A5 'S' max_ids max_quadros(16 bits)
+// e recebe um registro (inteiros little-endian):
+//   A5 5A  id  fps  n(16 bits)  r g b  n x BYTES_POR_QUADRO  crc(16 bits)
+// com os níveis de 4 bits na ordem de QUADRO (animacao.h), cores de 0 a 255 e o
+// CRC-16/CCITT de fluxo_usb.h sobre tudo depois do A5 5A. n = 0 apaga o id.
+// Resposta: A5 'G' id (gravado) ou A5 'N' id (CRC, tamanho ou flash cheia).
+// Os quadros vão para a flash página a página enquanto chegam.
+#define ACERVO_GRAVADO 'G'
+#define ACERVO_CABECALHO_USB 7
+
+bool acervo_sessao(const PortaFluxo *p);
+
+// Sessão pelo stdio USB (roda no núcleo de renderização, como o fluxo de quadros)
+void executar_acervo_usb(void);
+
+// Verdadeiro enquanto a sessão usa a entrada do USB
+bool acervo_usb_ativo(void);
+
+#endif
@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include "agendador.h"
+#include "pico/platform.h"
+#include "rastro.h"
+#include "contador64.h"
+
+// Limites superiores das faixas do histograma, em microssegundos
+static const uint32_t limites_faixas[AGENDADOR_FAIXAS - 1] = {
+    10, 50, 100, 250, 500, 1000, 5000
+};
+
+static EstatisticasQuadros estatisticas = { .atraso_min_us = UINT32_MAX };
+
+static bool (*cancelamento)(void) = NULL;
+
+// Tempo dormindo nas esperas, por núcleo (lido também pelo outro núcleo)
+static Contador64 espera_us[2];
+
+// Prazo absoluto do quadro k
+static uint64_t prazo(const Agendador *ag, uint32_t k) {
+    return ag->inicio_us + ((uint64_t)k * 1000000000ull) / ag->fps_milli;
+}
+
+static void registrar_atraso(uint32_t atraso_us) {
+    estatisticas.quadros++;
+    estatisticas.atraso_soma_us += atraso_us;
+    if (atraso_us < estatisticas.atraso_min_us) {
+        estatisticas.atraso_min_us = atraso_us;
+    }
+    if (atraso_us > estatisticas.atraso_max_us) {
+        estatisticas.atraso_max_us = atraso_us;
+    }
+
+    int faixa = 0;
+    while (faixa < AGENDADOR_FAIXAS - 1 && atraso_us >= limites_faixas[faixa]) {
+        faixa++;
+    }
+    estatisticas.histograma[faixa]++;
+}
+
+void agendador_iniciar(Agendador *ag, uint32_t fps_milli) {
+    ag->inicio_us = time_us_64();
+    ag->fps_milli = fps_milli > 0 ? fps_milli : 1;
+    ag->quadro = 1;
+}
+
+void agendador_definir_cancelamento(bool (*deve_cancelar)(void)) {
+    cancelamento = deve_cancelar;
+}
+
+bool agendador_cancelado(void) {
+    return cancelamento && cancelamento();
+}
+
+bool agendador_esperar(Agendador *ag) {
+    uint64_t alvo = prazo(ag, ag->quadro);
+
+    // Se o quadro atrasou mais de um período, pula os prazos perdidos mantendo a fase
+    uint64_t agora = time_us_64();
+    while (alvo + ((uint64_t)1000000000ull / ag->fps_milli) <= agora) {
+        estatisticas.perdidos++;
+        ag->quadro++;
+        alvo = prazo(ag, ag->quadro);
+    }
+
+    if (!agendador_esperar_ate(alvo)) {
+        return false;
+    }
+    registrar_atraso((uint32_t)(time_us_64() - alvo));
+    ag->quadro++;
+    return true;
+}
+
+bool agendador_esperar_ate(uint64_t prazo_us) {
+    // Dorme em WFE até o prazo; qualquer IRQ ou SEV (ex.: varredura do teclado,
+    // comando do outro núcleo) acorda o núcleo para reavaliar o cancelamento
+    uint64_t agora = time_us_64();
+    absolute_time_t prazo_abs = from_us_since_boot(prazo_us);
+    uint nucleo = get_core_num();
+    bool cancelado = false;
+    while (!best_effort_wfe_or_timeout(prazo_abs)) {
+        if (cancelamento && cancelamento()) {
+            cancelado = true;
+            break;
+        }
+    }
+    uint64_t acordou = time_us_64();
+    contador64_somar(&espera_us[nucleo], acordou - agora);
+    RASTRO_EVENTO(RASTRO_ACORDAR, cancelado, acordou > prazo_us ? (uint32_t)(acordou - prazo_us) : 0);
+    return !cancelado;
+}
+
+uint64_t agendador_espera_us(uint nucleo) {
+    return contador64_ler(&espera_us[nucleo]);
+}
+
+const EstatisticasQuadros *agendador_estatisticas(void) {
+    return &estatisticas;
+}
+
+void agendador_zerar(void) {
+    estatisticas = (EstatisticasQuadros){ .atraso_min_us = UINT32_MAX };
+}
+
+void agendador_relatorio(void) {
+    if (estatisticas.quadros == 0) {
+        printf("Nenhum quadro agendado ainda.\n");
+        return;
+    }
+
+    printf("Quadros: %lu  perdidos: %lu\n", (unsigned long)estatisticas.quadros, (unsigned long)estatisticas.perdidos);
+    printf("Atraso (us): min %lu  max %lu  media %lu\n",
+           (unsigned long)estatisticas.atraso_min_us,
+           (unsigned long)estatisticas.atraso_max_us,
+           (unsigned long)(estatisticas.atraso_soma_us / estatisticas.quadros));
+
+    for (int i = 0; i < AGENDADOR_FAIXAS; i++) {
+        if (i < AGENDADOR_FAIXAS - 1) {
+            printf("  < %5lu us: %lu\n", (unsigned long)limites_faixas[i], (unsigned long)estatisticas.histograma[i]);
+        } else {
+            printf("  >= %4lu us: %lu\n", (unsigned long)limites_faixas[i - 1], (unsigned long)estatisticas.histograma[i]);
+        }
+    }
+}
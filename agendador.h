@@ -0,0 +1,55 @@
+#ifndef AGENDADOR_H
+#define AGENDADOR_H
+
+#include "pico/stdlib.h"
+
+// Faixas do histograma de atraso, em microssegundos (a última é "acima de")
+#define AGENDADOR_FAIXAS 8
+
+// Agenda quadros em prazos absolutos: o prazo do quadro k é inicio + k / fps,
+// calculado sem arredondamento acumulado, então o ritmo não deriva
+typedef struct {
+    uint64_t inicio_us;
+    uint32_t fps_milli;   // Quadros por segundo x 1000 (permite taxas fracionárias)
+    uint32_t quadro;      // Índice do próximo prazo
+} Agendador;
+
+// Atraso dos quadros (momento em que a espera terminou menos o prazo)
+typedef struct {
+    uint32_t quadros;
+    uint32_t perdidos;    // Prazos que já tinham passado e foram pulados
+    uint32_t atraso_min_us;
+    uint32_t atraso_max_us;
+    uint64_t atraso_soma_us;
+    uint32_t histograma[AGENDADOR_FAIXAS];
+} EstatisticasQuadros;
+
+// Começa a contar os prazos a partir de agora
+void agendador_iniciar(Agendador *ag, uint32_t fps_milli);
+
+// Espera até o prazo do próximo quadro e registra o atraso.
+// Retorna false se a espera foi interrompida pela condição de cancelamento.
+bool agendador_esperar(Agendador *ag);
+
+// Espera até o instante absoluto prazo_us (no relógio de time_us_64), com o mesmo
+// cancelamento; não entra nas estatísticas de quadros. Usada por quem calcula os
+// próprios prazos (ex.: o sequenciador).
+bool agendador_esperar_ate(uint64_t prazo_us);
+
+// Condição verificada durante as esperas (ex.: tecla pendente); NULL desativa
+void agendador_definir_cancelamento(bool (*deve_cancelar)(void));
+
+// Avalia a mesma condição fora das esperas, para laços que não dormem no agendador
+bool agendador_cancelado(void);
+
+// Estatísticas acumuladas desde o último agendador_zerar()
+const EstatisticasQuadros *agendador_estatisticas(void);
+void agendador_zerar(void);
+
+// Tempo total que o núcleo passou dormindo em agendador_esperar()
+uint64_t agendador_espera_us(uint nucleo);
+
+// Imprime mín/máx/média e o histograma no stdio (USB)
+void agendador_relatorio(void);
+
+#endif
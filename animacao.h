@@ -0,0 +1,39 @@
+#ifndef ANIMACAO_H
+#define ANIMACAO_H
+
+#include "pico/stdlib.h"
+#include "saida_led.h"
+#include "cores.h"
+
+// Dois pixels por byte: pixel par no nibble baixo, pixel ímpar no nibble alto
+#define BYTES_POR_QUADRO ((NUM_PIXELS + 1) / 2)
+
+// Quantiza uma intensidade 0.0-1.0 em tempo de compilação
+#define Q4(v) ((uint8_t)((v) * NIVEIS_INTENSIDADE + 0.5))
+#define P2(a, b) (uint8_t)(Q4(a) | (Q4(b) << 4))
+
+// Empacota um quadro de 25 intensidades escritas como 0.0-1.0
+#define QUADRO(p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22, p23, p24) \
+    { P2(p0, p1), P2(p2, p3), P2(p4, p5), P2(p6, p7), P2(p8, p9), P2(p10, p11), P2(p12, p13), P2(p14, p15), P2(p16, p17), P2(p18, p19), P2(p20, p21), P2(p22, p23), P2(p24, 0.0) }
+
+// Empacota um quadro de 25 níveis inteiros (0..15), ex.: índices de paleta (paleta.h)
+#define N2(a, b) (uint8_t)((a) | ((b) << 4))
+#define QUADRO_NIVEIS(p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22, p23, p24) \
+    { N2(p0, p1), N2(p2, p3), N2(p4, p5), N2(p6, p7), N2(p8, p9), N2(p10, p11), N2(p12, p13), N2(p14, p15), N2(p16, p17), N2(p18, p19), N2(p20, p21), N2(p22, p23), N2(p24, 0) }
+
+// Estrutura para armazenar dados de uma animação
+// Os quadros ficam em flash (XIP) e cada animação tem o seu próprio número de quadros
+typedef struct {
+    const uint8_t (*frames)[BYTES_POR_QUADRO];
+    int num_frames;
+    uint16_t r, g, b; // Cor em ponto fixo 8.8 (use COR_FX)
+    int fps;
+} Animacao;
+
+// Lê o nível de intensidade (0..15) de um pixel de um quadro empacotado
+static inline uint8_t nivel_pixel(const Animacao *anim, int frame, int i) {
+    uint8_t par = anim->frames[frame][i >> 1];
+    return (i & 1) ? (par >> 4) : (par & 0x0F);
+}
+
+#endif
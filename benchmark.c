@@ -0,0 +1,492 @@
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "benchmark.h"
+#include "ciclos.h"
+#include "compactacao.h"
+#include "procedural.h"
+#include "compositor.h"
+#include "interpolacao.h"
+#include "paleta.h"
+#include "espectro.h"
+#include "microfone.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+
+// Repetições de cada quadro, para diluir o custo da medição
+#define REPETICOES 8
+
+// Caminho antigo, mantido só como referência: matrix_rgb em double e três
+// multiplicações em double por pixel
+static uint32_t __attribute__((noinline)) matrix_rgb_double(double b, double r, double g) {
+    unsigned char R = r * 255;
+    unsigned char G = g * 255;
+    unsigned char B = b * 255;
+    return (G << 24) | (R << 16) | (B << 8);
+}
+
+static void __attribute__((noinline)) quadro_double(const Animacao *anim, int frame, uint32_t *quadro) {
+    double r = anim->r / 65280.0, g = anim->g / 65280.0, b = anim->b / 65280.0;
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        double intensidade = nivel_pixel(anim, frame, i) / (double)NIVEIS_INTENSIDADE;
+        quadro[i] = matrix_rgb_double(b * intensidade, r * intensidade, g * intensidade);
+    }
+}
+
+static void __attribute__((noinline)) quadro_tabela(const Animacao *anim, int frame, const uint32_t *tabela, uint32_t *quadro) {
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        quadro[i] = tabela[nivel_pixel(anim, frame, i)];
+    }
+}
+
+void benchmark_cores(const Animacao *anim) {
+    uint32_t antes[NUM_PIXELS], depois[NUM_PIXELS];
+    uint32_t tabela[NIVEIS_INTENSIDADE + 1];
+    uint64_t total_double = 0, total_tabela = 0, total_preparo = 0;
+    int diferencas = 0;
+
+    ciclos_init();
+    uint32_t status = save_and_disable_interrupts();
+
+    // A tabela é montada uma vez por animação (ou por troca de cor)
+    uint32_t t0 = ciclos_agora();
+    tabela_niveis(tabela, anim->r, anim->g, anim->b);
+    total_preparo = ciclos_desde(t0);
+
+    for (int frame = 0; frame < anim->num_frames; frame++) {
+        for (int k = 0; k < REPETICOES; k++) {
+            t0 = ciclos_agora();
+            quadro_double(anim, frame, antes);
+            total_double += ciclos_desde(t0);
+
+            t0 = ciclos_agora();
+            quadro_tabela(anim, frame, tabela, depois);
+            total_tabela += ciclos_desde(t0);
+        }
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            diferencas += antes[i] != depois[i];
+        }
+    }
+
+    restore_interrupts(status);
+
+    uint32_t medidas = anim->num_frames * REPETICOES;
+    uint32_t por_quadro_double = total_double / medidas;
+    uint32_t por_quadro_tabela = total_tabela / medidas;
+    printf("Cores (%d quadros x %d): double %lu ciclos/quadro, tabela %lu ciclos/quadro (+%lu por tabela), %lux mais rapido\n",
+           anim->num_frames, REPETICOES,
+           (unsigned long)por_quadro_double, (unsigned long)por_quadro_tabela, (unsigned long)total_preparo,
+           (unsigned long)(por_quadro_tabela ? por_quadro_double / por_quadro_tabela : 0));
+    printf("Palavras GRB diferentes entre os caminhos: %d\n", diferencas);
+}
+
+// Ciclos para decodificar todos os quadros de uma passada do leitor
+static uint32_t ciclos_passada(LeitorQuadros *l) {
+    uint32_t total = 0;
+    for (int frame = 0; frame < l->anim->num_frames; frame++) {
+        uint32_t t0 = ciclos_agora();
+        leitor_proximo(l);
+        total += ciclos_desde(t0);
+    }
+    return total;
+}
+
+void benchmark_compactacao(const Animacao *const *lista, int quantidade) {
+    size_t total_bruto = 0, total_compactado = 0;
+
+    ciclos_init();
+    for (int k = 0; k < quantidade; k++) {
+        const Animacao *anim = lista[k];
+        size_t bruto = anim->num_frames * BYTES_POR_QUADRO;
+        size_t compactado = bruto;
+        bool tem_fluxo = compactacao_buscar(anim, &compactado) != NULL;
+
+        LeitorQuadros empacotado, delta;
+        leitor_iniciar(&empacotado, anim);
+        empacotado.inicio = empacotado.pos = NULL; // Força a leitura dos quadros empacotados
+        leitor_iniciar(&delta, anim);
+
+        // Conta os quadros sem mudança (a saída não os retransmite)
+        int repetidos = 0;
+        for (int frame = 0; frame < anim->num_frames; frame++) {
+            if (leitor_proximo(&delta) == 0 && frame > 0) {
+                repetidos++;
+            }
+        }
+
+        uint32_t status = save_and_disable_interrupts();
+        uint32_t ciclos_bruto = 0, ciclos_delta = 0;
+        for (int r = 0; r < REPETICOES; r++) {
+            ciclos_bruto += ciclos_passada(&empacotado);
+            ciclos_delta += ciclos_passada(&delta);
+        }
+        restore_interrupts(status);
+
+        uint32_t medidas = anim->num_frames * REPETICOES;
+        printf("Animacao %d: %d quadros, %u -> %u bytes%s, %d repetidos, decodificar %lu -> %lu ciclos/quadro\n",
+               k, anim->num_frames, (unsigned)bruto, (unsigned)compactado, tem_fluxo ? "" : " (sem ganho, empacotado)",
+               repetidos, (unsigned long)(ciclos_bruto / medidas), (unsigned long)(ciclos_delta / medidas));
+        total_bruto += bruto;
+        total_compactado += compactado;
+    }
+    printf("Total: %u -> %u bytes\n", (unsigned)total_bruto, (unsigned)total_compactado);
+}
+
+// Quadros renderizados por gerador: cobre várias voltas da fase
+#define QUADROS_PROCEDURAL 64
+
+void benchmark_procedural(const AnimacaoProcedural *const *lista, int quantidade) {
+    uint32_t quadro[MATRIZ_LARGURA * MATRIZ_ALTURA];
+
+    ciclos_init();
+    for (int k = 0; k < quantidade; k++) {
+        const AnimacaoProcedural *a = lista[k];
+        uint32_t orcamento = clock_get_hz(clk_sys) / a->fps;
+        uint32_t total = 0, maximo = 0;
+
+        uint32_t status = save_and_disable_interrupts();
+        for (int frame = 0; frame < QUADROS_PROCEDURAL; frame++) {
+            uint32_t t0 = ciclos_agora();
+            procedural_renderizar(a, (uint32_t)frame * 1000 / a->fps, quadro, MATRIZ_LARGURA, MATRIZ_ALTURA);
+            uint32_t gasto = ciclos_desde(t0);
+            total += gasto;
+            if (gasto > maximo) {
+                maximo = gasto;
+            }
+        }
+        restore_interrupts(status);
+
+        printf("%-10s %2d fps: media %lu  max %lu ciclos/quadro, orcamento %lu (%lu.%02lu%%) %s\n",
+               a->nome, a->fps, (unsigned long)(total / QUADROS_PROCEDURAL), (unsigned long)maximo,
+               (unsigned long)orcamento, (unsigned long)(maximo * 100 / orcamento),
+               (unsigned long)(maximo * 10000 / orcamento % 100), maximo <= orcamento ? "OK" : "ESTOURA");
+    }
+
+    // Medição feita durante a última execução, no núcleo de renderização
+    const OrcamentoProcedural *o = procedural_orcamento();
+    if (o->quadros) {
+        printf("Ultima execucao (%s): %lu quadros, media %lu  max %lu ciclos, %lu acima do orcamento\n",
+               o->nome, (unsigned long)o->quadros, (unsigned long)(o->soma_ciclos / o->quadros),
+               (unsigned long)o->max_ciclos, (unsigned long)o->estouros);
+    }
+}
+
+// Referência do compositor, canal a canal, com a mesma aritmética dos kernels SWAR
+static inline uint32_t canal(uint32_t p, int desloc) {
+    return (p >> desloc) & 0xFF;
+}
+
+static void __attribute__((noinline)) misturar_canais(uint32_t *destino, const uint32_t *camada, uint n,
+                                                      ModoMistura modo, uint32_t peso) {
+    for (uint i = 0; i < n; i++) {
+        uint32_t d = destino[i], c = camada[i], r = 0;
+        for (int desloc = 0; desloc < 32; desloc += 8) {
+            uint32_t dc = canal(d, desloc), cc = canal(c, desloc), v;
+            if (modo == MISTURA_SOMA) {
+                v = dc + ((cc * peso) >> 8);
+                v = v > 255 ? 255 : v;
+            } else {
+                if (modo == MISTURA_MULTIPLICA) {
+                    uint32_t t = dc * cc + 128;
+                    cc = desloc ? (t + (t >> 8)) >> 8 : 0;
+                }
+                v = (cc * peso + dc * (256 - peso)) >> 8;
+            }
+            r |= v << desloc;
+        }
+        destino[i] = r;
+    }
+}
+
+static void misturar_swar(uint32_t *destino, const uint32_t *camada, uint n, ModoMistura modo, uint32_t peso) {
+    switch (modo) {
+    case MISTURA_SOBRE: misturar_sobre(destino, camada, n, peso, false); break;
+    case MISTURA_SOMA: misturar_soma(destino, camada, n, peso); break;
+    case MISTURA_MULTIPLICA: misturar_multiplica(destino, camada, n, peso); break;
+    }
+}
+
+void benchmark_compositor(void) {
+    static uint32_t fundo[SAIDA_MAX_PIXELS], camada[SAIDA_MAX_PIXELS];
+    static uint32_t swar[SAIDA_MAX_PIXELS], referencia[SAIDA_MAX_PIXELS];
+    static const char *const nomes[] = { "sobre", "soma", "multiplica" };
+    static const uint tamanhos[] = { NUM_PIXELS, SAIDA_MAX_PIXELS };
+
+    // Pixels pseudoaleatórios com o byte baixo zerado, como as palavras GRB da saída
+    uint32_t x = 0x2545F491;
+    for (uint i = 0; i < SAIDA_MAX_PIXELS; i++) {
+        x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+        fundo[i] = x & 0xFFFFFF00u;
+        x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+        camada[i] = x & 0xFFFFFF00u;
+    }
+
+    ciclos_init();
+    uint32_t orcamento = clock_get_hz(clk_sys) / 30;
+    for (uint t = 0; t < count_of(tamanhos); t++) {
+        uint n = tamanhos[t];
+        for (int modo = MISTURA_SOBRE; modo <= MISTURA_MULTIPLICA; modo++) {
+            uint32_t ciclos_swar = 0, ciclos_canais = 0;
+            int diferencas = 0;
+            uint32_t status = save_and_disable_interrupts();
+            for (int r = 0; r < REPETICOES; r++) {
+                uint32_t peso = 32 * r + 32; // 32..256
+                memcpy(swar, fundo, n * sizeof(uint32_t));
+                memcpy(referencia, fundo, n * sizeof(uint32_t));
+
+                uint32_t t0 = ciclos_agora();
+                misturar_swar(swar, camada, n, (ModoMistura)modo, peso);
+                ciclos_swar += ciclos_desde(t0);
+
+                t0 = ciclos_agora();
+                misturar_canais(referencia, camada, n, (ModoMistura)modo, peso);
+                ciclos_canais += ciclos_desde(t0);
+
+                for (uint i = 0; i < n; i++) {
+                    diferencas += swar[i] != referencia[i];
+                }
+            }
+            restore_interrupts(status);
+
+            uint32_t por_camada = ciclos_swar / REPETICOES;
+            printf("Compositor %3u px %-10s: %5lu ciclos/camada (%lu.%02lu por pixel), canal a canal %5lu, "
+                   "%lu camadas por quadro a 30 fps, %d diferencas\n",
+                   n, nomes[modo], (unsigned long)por_camada,
+                   (unsigned long)(por_camada / n), (unsigned long)(por_camada * 100 / n % 100),
+                   (unsigned long)(ciclos_canais / REPETICOES),
+                   (unsigned long)(por_camada ? orcamento / por_camada : 0), diferencas);
+        }
+    }
+}
+
+// Quadro de saída interpolado como o reprodutor faz: pesos das três curvas e mistura
+static void __attribute__((noinline)) quadro_interpolado(uint32_t *destino, const uint32_t *de, const uint32_t *para,
+                                                         uint n, const ConfigInterpolacao *c, uint32_t fase) {
+    interpolar_quadro(destino, de, para, n, peso_curva(c->curva_r, fase), peso_curva(c->curva_g, fase),
+                      peso_curva(c->curva_b, fase));
+}
+
+void benchmark_interpolacao(const ConfigInterpolacao *lista, int quantidade) {
+    static uint32_t de[SAIDA_MAX_PIXELS], para[SAIDA_MAX_PIXELS], saida[SAIDA_MAX_PIXELS];
+    static const uint tamanhos[] = { NUM_PIXELS, SAIDA_MAX_PIXELS };
+
+    uint32_t x = 0x9E3779B9;
+    for (uint i = 0; i < SAIDA_MAX_PIXELS; i++) {
+        x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+        de[i] = x & 0xFFFFFF00u;
+        x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+        para[i] = x & 0xFFFFFF00u;
+    }
+
+    ciclos_init();
+    uint32_t hz = clock_get_hz(clk_sys);
+    uint32_t periodo = hz / INTERPOLACAO_HZ;
+    for (int k = 0; k < quantidade; k++) {
+        const ConfigInterpolacao *c = &lista[k];
+        for (uint t = 0; t < count_of(tamanhos); t++) {
+            uint n = tamanhos[t];
+            uint32_t total = 0;
+            int diferencas = 0;
+            for (int r = 0; r < REPETICOES; r++) {
+                uint32_t fase = 32 * r + 16; // Meio de cada oitavo da transição
+
+                uint32_t status = save_and_disable_interrupts();
+                uint32_t t0 = ciclos_agora();
+                quadro_interpolado(saida, de, para, n, c, fase);
+                total += ciclos_desde(t0);
+                restore_interrupts(status);
+
+                // Peso por byte da palavra, do baixo (W, que segue o B) ao alto (G)
+                uint32_t pesos[4] = { peso_curva(c->curva_b, fase), peso_curva(c->curva_b, fase),
+                                      peso_curva(c->curva_r, fase), peso_curva(c->curva_g, fase) };
+                for (uint i = 0; i < n; i++) {
+                    uint32_t esperado = 0;
+                    for (int desloc = 0; desloc < 32; desloc += 8) {
+                        uint32_t peso = pesos[desloc / 8];
+                        uint32_t v = (canal(para[i], desloc) * peso + canal(de[i], desloc) * (256 - peso)) >> 8;
+                        esperado |= v << desloc;
+                    }
+                    diferencas += saida[i] != esperado;
+                }
+            }
+
+            uint32_t por_quadro = total / REPETICOES;
+            uint32_t decimos_us = (uint32_t)((uint64_t)por_quadro * 10000000 / hz);
+            printf("Interpolacao %-9s %3u px: %5lu ciclos/quadro (%lu.%lu us), %lu.%02lu%% do periodo a %d Hz, %d diferencas\n",
+                   c->nome, n, (unsigned long)por_quadro, (unsigned long)(decimos_us / 10),
+                   (unsigned long)(decimos_us % 10), (unsigned long)(por_quadro * 100 / periodo),
+                   (unsigned long)(por_quadro * 10000 / periodo % 100), INTERPOLACAO_HZ, diferencas);
+        }
+    }
+}
+
+// Troca de cor como a sirene fazia antes do quadro com paleta: cada pixel
+// recalculado em double pelo seu nível
+static void __attribute__((noinline)) troca_double(uint32_t *destino, const uint8_t *niveis, uint n,
+                                                   uint16_t r, uint16_t g, uint16_t b) {
+    double cr = r / 65280.0, cg = g / 65280.0, cb = b / 65280.0;
+    for (uint i = 0; i < n; i++) {
+        double intensidade = niveis[i] / (double)NIVEIS_INTENSIDADE;
+        destino[i] = matrix_rgb_double(cb * intensidade, cr * intensidade, cg * intensidade);
+    }
+}
+
+void benchmark_paleta(void) {
+    static uint8_t niveis[SAIDA_MAX_PIXELS], indices[SAIDA_MAX_PIXELS / 2];
+    static uint32_t antes[SAIDA_MAX_PIXELS], depois[SAIDA_MAX_PIXELS];
+    static const uint tamanhos[] = { NUM_PIXELS, SAIDA_MAX_PIXELS };
+    uint32_t cores[PALETA_CORES];
+
+    uint32_t x = 0x6A09E667;
+    for (uint i = 0; i < SAIDA_MAX_PIXELS; i++) {
+        x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+        niveis[i] = x & 0x0F;
+    }
+    for (uint i = 0; i < SAIDA_MAX_PIXELS; i += 2) {
+        indices[i / 2] = (uint8_t)(niveis[i] | (niveis[i + 1] << 4));
+    }
+
+    ciclos_init();
+    for (uint t = 0; t < count_of(tamanhos); t++) {
+        uint n = tamanhos[t];
+        uint32_t ciclos_double = 0, ciclos_cores = 0, ciclos_expansao = 0;
+        int diferencas = 0;
+        uint32_t status = save_and_disable_interrupts();
+        for (int r = 0; r < REPETICOES; r++) {
+            // Vermelho e azul alternados (sirene), cada vez mais fracos (fade)
+            uint16_t v = COR_FX(1.0) - (uint16_t)(r / 2) * COR_FX(0.2);
+            uint16_t cr = (r & 1) ? 0 : v, cb = (r & 1) ? v : 0;
+
+            uint32_t t0 = ciclos_agora();
+            troca_double(antes, niveis, n, cr, 0, cb);
+            ciclos_double += ciclos_desde(t0);
+
+            t0 = ciclos_agora();
+            tabela_niveis(cores, cr, 0, cb);
+            ciclos_cores += ciclos_desde(t0);
+
+            t0 = ciclos_agora();
+            paleta_expandir(depois, indices, n, cores);
+            ciclos_expansao += ciclos_desde(t0);
+
+            // Referência: a consulta pixel a pixel na tabela da cor, como antes da paleta
+            for (uint i = 0; i < n; i++) {
+                diferencas += depois[i] != cores[niveis[i]];
+            }
+        }
+        restore_interrupts(status);
+
+        uint32_t por_double = ciclos_double / REPETICOES;
+        uint32_t por_cores = ciclos_cores / REPETICOES, por_expansao = ciclos_expansao / REPETICOES;
+        printf("Paleta %3u px: troca de cor em double %6lu ciclos/quadro, paleta %4lu + expansao %4lu "
+               "(%lu.%02lu por pixel), %lux mais rapido, %d diferencas\n",
+               n, (unsigned long)por_double, (unsigned long)por_cores, (unsigned long)por_expansao,
+               (unsigned long)(por_expansao / n), (unsigned long)(por_expansao * 100 / n % 100),
+               (unsigned long)(por_cores + por_expansao ? por_double / (por_cores + por_expansao) : 0),
+               diferencas);
+    }
+}
+
+// Mesma FFT de espectro_fft em float, só como referência de custo
+static void __attribute__((noinline)) fft_float(float *re, float *im) {
+    for (uint i = 1, j = 0; i < ESPECTRO_N; i++) {
+        uint bit = ESPECTRO_N >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            float t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+            t = im[i];
+            im[i] = im[j];
+            im[j] = t;
+        }
+    }
+    for (uint tamanho = 2; tamanho <= ESPECTRO_N; tamanho <<= 1) {
+        uint meio = tamanho / 2;
+        for (uint k = 0; k < meio; k++) {
+            float angulo = -6.28318531f * (float)k / (float)tamanho;
+            float wr = cosf(angulo), wi = sinf(angulo);
+            for (uint i = k; i < ESPECTRO_N; i += tamanho) {
+                uint j = i + meio;
+                float tr = wr * re[j] - wi * im[j];
+                float ti = wr * im[j] + wi * re[j];
+                re[j] = re[i] - tr;
+                im[j] = im[i] - ti;
+                re[i] += tr;
+                im[i] += ti;
+            }
+        }
+    }
+}
+
+void benchmark_espectro(void) {
+    static uint16_t amostras[ESPECTRO_N];
+    static int16_t re[ESPECTRO_N], im[ESPECTRO_N];
+    static float fre[ESPECTRO_N], fim[ESPECTRO_N];
+    uint32_t quadro[MATRIZ_LARGURA * MATRIZ_ALTURA];
+    uint16_t alturas[ESPECTRO_BANDAS] = { 0 };
+    uint32_t energia[ESPECTRO_BANDAS];
+
+    // Ruído de 12 bits em volta do meio da escala: energia em todas as bandas
+    uint32_t x = 0xBB67AE85;
+    for (uint i = 0; i < ESPECTRO_N; i++) {
+        x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+        amostras[i] = (uint16_t)(1536 + (x & 0x3FF));
+    }
+
+    espectro_init();
+    ciclos_init();
+    uint32_t ciclos_bandas = 0, ciclos_fft = 0, ciclos_float = 0, ciclos_barras = 0, ciclos_desenho = 0;
+    uint32_t status = save_and_disable_interrupts();
+    for (int r = 0; r < REPETICOES; r++) {
+        uint32_t t0 = ciclos_agora();
+        espectro_bandas(amostras, energia);
+        ciclos_bandas += ciclos_desde(t0);
+
+        t0 = ciclos_agora();
+        espectro_suavizar(alturas, energia);
+        ciclos_barras += ciclos_desde(t0);
+
+        t0 = ciclos_agora();
+        espectro_desenhar(quadro, alturas);
+        ciclos_desenho += ciclos_desde(t0);
+
+        for (uint i = 0; i < ESPECTRO_N; i++) {
+            re[i] = (int16_t)((amostras[i] - 2048) * 8);
+            im[i] = 0;
+            fre[i] = (float)re[i];
+            fim[i] = 0;
+        }
+        t0 = ciclos_agora();
+        espectro_fft(re, im);
+        ciclos_fft += ciclos_desde(t0);
+
+        t0 = ciclos_agora();
+        fft_float(fre, fim);
+        ciclos_float += ciclos_desde(t0);
+    }
+    restore_interrupts(status);
+
+    uint32_t orcamento = (uint32_t)((uint64_t)clock_get_hz(clk_sys) * ESPECTRO_N / ESPECTRO_TAXA_HZ);
+    uint32_t por_bandas = ciclos_bandas / REPETICOES, por_barras = ciclos_barras / REPETICOES;
+    uint32_t por_desenho = ciclos_desenho / REPETICOES, total = por_bandas + por_barras + por_desenho;
+    printf("Espectro %u amostras: janela + FFT + bandas %lu, barras %lu, desenho %lu ciclos/bloco\n",
+           ESPECTRO_N, (unsigned long)por_bandas, (unsigned long)por_barras, (unsigned long)por_desenho);
+    printf("Total %lu de %lu ciclos por bloco (%lu.%02lu%%) %s\n", (unsigned long)total, (unsigned long)orcamento,
+           (unsigned long)(total * 100 / orcamento), (unsigned long)(total * 10000 / orcamento % 100),
+           total <= orcamento ? "OK" : "ESTOURA");
+    printf("FFT em Q15 %lu ciclos, em float %lu ciclos (%lux)\n", (unsigned long)(ciclos_fft / REPETICOES),
+           (unsigned long)(ciclos_float / REPETICOES),
+           (unsigned long)(ciclos_fft ? ciclos_float / ciclos_fft : 0));
+
+    // Captura feita durante a última execução do visualizador
+    const EstatisticasMicrofone *m = microfone_estatisticas();
+    if (m->processados) {
+        printf("Ultima execucao: %lu blocos, %lu perdidos, %lu quadros, media %lu  max %lu ciclos/bloco\n",
+               (unsigned long)m->blocos, (unsigned long)m->perdidos, (unsigned long)m->processados,
+               (unsigned long)(m->ciclos_soma / m->processados), (unsigned long)m->ciclos_max);
+    }
+}
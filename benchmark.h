@@ -0,0 +1,45 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "animacao.h"
+#include "procedural.h"
+#include "interpolacao.h"
+
+// Mede, com o SysTick, os ciclos por quadro para converter `anim` em palavras GRB:
+// caminho antigo em double (soft-float) contra o caminho inteiro por tabela.
+// Também confere se os dois caminhos geram as mesmas palavras.
+void benchmark_cores(const Animacao *anim);
+
+// Para cada animação: bytes dos quadros empacotados contra o formato compactado,
+// quadros repetidos e ciclos por quadro para decodificar nos dois formatos
+void benchmark_compactacao(const Animacao *const *lista, int quantidade);
+
+// Ciclos por quadro (média e pior caso) de cada gerador procedural, comparados com
+// o orçamento de um período de quadro no FPS da animação, e a medição da última
+// execução no núcleo de renderização
+void benchmark_procedural(const AnimacaoProcedural *const *lista, int quantidade);
+
+// Ciclos por camada de cada modo de mistura do compositor (kernels SWAR contra a
+// referência canal a canal), para a matriz e para o quadro máximo da saída, e
+// quantas camadas cabem num quadro a 30 fps. Confere se os dois caminhos batem.
+void benchmark_compositor(void);
+
+// Ciclos por quadro de saída da interpolação entre quadros-chave em cada conjunto
+// de curvas (pesos das três curvas + mistura), para a matriz e para o quadro
+// máximo, em microssegundos e em fração do período a INTERPOLACAO_HZ. Confere o
+// resultado com a referência canal a canal.
+void benchmark_interpolacao(const ConfigInterpolacao *lista, int quantidade);
+
+// Custo de uma troca de cor na saída (sirene, fades): o caminho antigo, que
+// recalculava cada pixel em double, contra o quadro com paleta (16 entradas novas
+// e a expansão dos índices), para a matriz e para o quadro máximo. Confere a
+// expansão com a consulta pixel a pixel na tabela da cor.
+void benchmark_paleta(void);
+
+// Ciclos por bloco de ESPECTRO_N amostras do visualizador de áudio, etapa a
+// etapa (janela + FFT + bandas, barras, desenho), contra o orçamento de um bloco
+// (ESPECTRO_N / ESPECTRO_TAXA_HZ), e a FFT em Q15 contra a mesma FFT em float
+// (soft-float). Também mostra a captura da última execução do visualizador.
+void benchmark_espectro(void);
+
+#endif
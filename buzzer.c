@@ -0,0 +1,269 @@
+#include "buzzer.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "pico/platform.h"
+#include "fila_spsc.h"
+#include "energia.h"
+#include "rastro.h"
+
+typedef struct {
+    uint16_t frequency;
+    uint16_t duration_ms;
+} Nota;
+
+static uint slice;
+static uint canal_pwm;
+
+// Fila circular de notas: escrita pelo código principal, consumida pelo alarme
+static Nota fila[BUZZER_FILA];
+static volatile uint fila_inicio = 0;
+static volatile uint fila_fim = 0;
+
+static alarm_id_t alarme_nota = 0;
+static volatile bool tocando = false;
+
+// Pedidos vindos do núcleo 1, atendidos pelo núcleo 0 em buzzer_processar()
+typedef struct {
+    bool enfileirar;
+    Nota nota;
+} PedidoSom;
+
+static PedidoSom buffer_pedidos[BUZZER_FILA];
+static FilaSpsc pedidos;
+
+// Canal de DMA e timer de ritmo usados no modo de amostras
+static int canal_dma = -1;
+static int timer_dma = -1;
+
+// O que está soando, para refazer divisor e wrap quando o clk_sys muda:
+// frequência do tom (0 = mudo) e taxa das amostras (0 = fora do modo de amostras)
+static uint freq_atual = 0;
+static uint taxa_amostras = 0;
+
+static void silenciar(void) {
+    pwm_set_chan_level(slice, canal_pwm, 0);
+    freq_atual = 0;
+}
+
+// Ajusta divisor e wrap do PWM para gerar uma onda quadrada de `frequency` Hz
+static void configurar_tom(uint frequency) {
+    uint64_t clk16 = (uint64_t)clock_get_hz(clk_sys) * 16;
+
+    // Menor divisor (em 1/16) que mantém o wrap dentro de 16 bits
+    uint64_t div16 = (clk16 + (uint64_t)frequency * 65536 - 1) / ((uint64_t)frequency * 65536);
+    if (div16 < 16) {
+        div16 = 16;
+    } else if (div16 > 0xFFF) {
+        div16 = 0xFFF;
+    }
+
+    uint64_t wrap = clk16 / (div16 * frequency);
+    if (wrap > 0) {
+        wrap--;
+    }
+    if (wrap > 0xFFFF) {
+        wrap = 0xFFFF;
+    }
+
+    pwm_set_clkdiv_int_frac(slice, div16 / 16, div16 & 0xF);
+    pwm_set_wrap(slice, wrap);
+    pwm_set_chan_level(slice, canal_pwm, wrap / 2);
+    freq_atual = frequency;
+}
+
+// Timer de DMA na taxa de amostragem: clk_sys * 1 / den
+static void configurar_taxa(uint sample_rate_hz) {
+    uint32_t den = (clock_get_hz(clk_sys) + sample_rate_hz / 2) / sample_rate_hz;
+    dma_timer_set_fraction(timer_dma, 1, den > 0xFFFF ? 0xFFFF : den);
+}
+
+// Depois de uma troca do clk_sys o tom e a taxa das amostras continuam os mesmos.
+// A portadora do modo de amostras (clk_sys / 256) só muda de frequência, e segue
+// bem acima da faixa audível.
+static void mudanca_clock(EtapaClock etapa) {
+    if (etapa != CLOCK_DEPOIS) {
+        return;
+    }
+    uint32_t status = save_and_disable_interrupts();
+    if (dma_channel_is_busy(canal_dma)) {
+        configurar_taxa(taxa_amostras);
+    } else if (freq_atual > 0) {
+        configurar_tom(freq_atual);
+    }
+    restore_interrupts(status);
+}
+
+static int64_t proxima_nota(alarm_id_t id, void *user_data);
+
+// Toca a próxima nota da fila, ou silencia se ela estiver vazia. Notas de 0 ms são
+// puladas aqui: um alarme de 0 ms dispararia dentro do add_alarm_in_us, antes de
+// alarme_nota receber o id.
+static void avancar_fila(void) {
+    alarme_nota = 0;
+    Nota nota;
+    do {
+        if (fila_inicio == fila_fim) {
+            silenciar();
+            tocando = false;
+            return;
+        }
+        nota = fila[fila_inicio];
+        fila_inicio = (fila_inicio + 1) % BUZZER_FILA;
+    } while (nota.duration_ms == 0);
+
+    tocando = true;
+    if (nota.frequency > 0) {
+        configurar_tom(nota.frequency);
+    } else {
+        silenciar();
+    }
+    alarme_nota = add_alarm_in_us((uint64_t)nota.duration_ms * 1000, proxima_nota, NULL, true);
+}
+
+static int64_t proxima_nota(alarm_id_t id, void *user_data) {
+    avancar_fila();
+    return 0;
+}
+
+// Fim das amostras: volta ao modo de tom e continua a fila
+static void amostras_concluidas(void) {
+    if (!dma_channel_get_irq1_status(canal_dma)) {
+        return;
+    }
+    dma_channel_acknowledge_irq1(canal_dma);
+    avancar_fila();
+}
+
+// Interrompe o que estiver tocando, sem mexer na fila
+static void interromper(void) {
+    if (alarme_nota) {
+        cancel_alarm(alarme_nota);
+        alarme_nota = 0;
+    }
+    if (dma_channel_is_busy(canal_dma)) {
+        // O abort pode gerar uma IRQ de conclusão espúria; ela é descartada aqui
+        dma_channel_set_irq1_enabled(canal_dma, false);
+        dma_channel_abort(canal_dma);
+        dma_channel_acknowledge_irq1(canal_dma);
+        dma_channel_set_irq1_enabled(canal_dma, true);
+    }
+    silenciar();
+    tocando = false;
+}
+
+void buzzer_init(uint pin) {
+    slice = pwm_gpio_to_slice_num(pin);
+    canal_pwm = pwm_gpio_to_channel(pin);
+
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    pwm_config cfg = pwm_get_default_config();
+    pwm_init(slice, &cfg, true);
+    silenciar();
+
+    fila_spsc_init(&pedidos, buffer_pedidos, sizeof(PedidoSom), BUZZER_FILA);
+
+    canal_dma = dma_claim_unused_channel(true);
+    timer_dma = dma_claim_unused_timer(true);
+    // A DMA_IRQ_0 é do núcleo de renderização (saida_led.c); esta linha fica só
+    // neste núcleo, que é o dono da fila de notas
+    irq_add_shared_handler(DMA_IRQ_1, amostras_concluidas, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    dma_channel_set_irq1_enabled(canal_dma, true);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    energia_observar(mudanca_clock);
+}
+
+void buzzer_processar(void) {
+    PedidoSom p;
+    while (fila_spsc_retirar(&pedidos, &p)) {
+        if (p.enfileirar) {
+            buzzer_queue_tone(p.nota.frequency, p.nota.duration_ms);
+        } else {
+            buzzer_tone(p.nota.frequency, p.nota.duration_ms);
+        }
+    }
+}
+
+// O áudio pertence ao núcleo 0; no núcleo 1 o pedido só é repassado
+static bool repassar(bool enfileirar, uint frequency, uint duration_ms) {
+    PedidoSom p = { .enfileirar = enfileirar, .nota = { frequency, duration_ms } };
+    return fila_spsc_inserir(&pedidos, &p);
+}
+
+void buzzer_tone(uint frequency, uint duration_ms) {
+    uint32_t t0 = RASTRO_INICIO();
+    if (get_core_num() != 0) {
+        repassar(false, frequency, duration_ms);
+        RASTRO_FIM(RASTRO_BUZZER, frequency, t0);
+        return;
+    }
+
+    uint32_t status = save_and_disable_interrupts();
+    interromper();
+    fila_inicio = fila_fim;
+    restore_interrupts(status);
+
+    buzzer_queue_tone(frequency, duration_ms);
+    RASTRO_FIM(RASTRO_BUZZER, frequency, t0);
+}
+
+bool buzzer_queue_tone(uint frequency, uint duration_ms) {
+    if (get_core_num() != 0) {
+        return repassar(true, frequency, duration_ms);
+    }
+
+    uint32_t status = save_and_disable_interrupts();
+    uint proximo = (fila_fim + 1) % BUZZER_FILA;
+    if (proximo == fila_inicio) {
+        restore_interrupts(status);
+        return false;
+    }
+
+    fila[fila_fim].frequency = frequency;
+    fila[fila_fim].duration_ms = duration_ms;
+    fila_fim = proximo;
+
+    // Se nada estiver tocando, a nota começa agora
+    if (!tocando) {
+        avancar_fila();
+    }
+    restore_interrupts(status);
+    return true;
+}
+
+void buzzer_play_samples(const uint16_t *samples, uint num_samples, uint sample_rate_hz) {
+    uint32_t status = save_and_disable_interrupts();
+    interromper();
+    tocando = true;
+    restore_interrupts(status);
+
+    // Portadora de clk_sys / (BUZZER_PCM_MAX + 1), bem acima da faixa audível
+    pwm_set_clkdiv_int_frac(slice, 1, 0);
+    pwm_set_wrap(slice, BUZZER_PCM_MAX);
+
+    taxa_amostras = sample_rate_hz;
+    configurar_taxa(sample_rate_hz);
+
+    // Escritas de 16 bits são replicadas nas duas metades do registrador CC,
+    // então o nível vale para o canal A e para o canal B do slice
+    dma_channel_config c = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, dma_get_timer_dreq(timer_dma));
+    dma_channel_configure(canal_dma, &c, &pwm_hw->slice[slice].cc, samples, num_samples, true);
+}
+
+void buzzer_stop(void) {
+    uint32_t status = save_and_disable_interrupts();
+    interromper();
+    fila_inicio = fila_fim;
+    restore_interrupts(status);
+}
+
+bool buzzer_busy(void) {
+    return tocando || fila_inicio != fila_fim;
+}
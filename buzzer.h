@@ -0,0 +1,37 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include "pico/stdlib.h"
+
+// Tamanho da fila de notas (potência de 2)
+#define BUZZER_FILA 16
+
+// Resolução do PWM no modo de amostras: cada amostra vai de 0 a BUZZER_PCM_MAX
+#define BUZZER_PCM_MAX 255
+
+// Configura o pino do buzzer como saída PWM e reserva o canal de DMA das amostras.
+// Deve ser chamada no núcleo 0, que fica responsável pelo áudio.
+void buzzer_init(uint pin);
+
+// Atende os pedidos de som feitos pelo núcleo 1 (chamar no laço do núcleo 0).
+// buzzer_tone() e buzzer_queue_tone() chamadas no núcleo 1 só enfileiram o pedido.
+void buzzer_processar(void);
+
+// Começa a tocar um tom imediatamente, descartando o que estiver tocando ou na fila.
+// Retorna na hora; o tom é desligado por um alarme após duration_ms.
+void buzzer_tone(uint frequency, uint duration_ms);
+
+// Coloca uma nota no fim da fila (frequency 0 é uma pausa). Retorna false se a fila estiver cheia.
+bool buzzer_queue_tone(uint frequency, uint duration_ms);
+
+// Toca amostras de 0 a BUZZER_PCM_MAX a sample_rate_hz, enviadas ao PWM por DMA.
+// O buffer precisa continuar válido até o fim da reprodução.
+void buzzer_play_samples(const uint16_t *samples, uint num_samples, uint sample_rate_hz);
+
+// Silencia o buzzer e esvazia a fila
+void buzzer_stop(void);
+
+// Indica se há algo tocando ou na fila
+bool buzzer_busy(void);
+
+#endif
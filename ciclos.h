@@ -0,0 +1,26 @@
+#ifndef CICLOS_H
+#define CICLOS_H
+
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+
+// Contador de ciclos do núcleo usando o SysTick (24 bits, contando para baixo, no
+// clock do processador). Cada núcleo tem o seu; chame ciclos_init() no núcleo que mede.
+// Intervalos maiores que 2^24 ciclos (~134 ms a 125 MHz) dão a volta.
+#define CICLOS_MASCARA 0x00FFFFFFu
+
+static inline void ciclos_init(void) {
+    systick_hw->rvr = CICLOS_MASCARA;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // CLKSOURCE = processador, ENABLE, sem interrupção
+}
+
+static inline uint32_t ciclos_agora(void) {
+    return systick_hw->cvr;
+}
+
+static inline uint32_t ciclos_desde(uint32_t inicio) {
+    return (inicio - systick_hw->cvr) & CICLOS_MASCARA;
+}
+
+#endif
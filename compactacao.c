@@ -0,0 +1,257 @@
+#include <string.h>
+#include "compactacao.h"
+
+// Trechos repetidos a partir deste tamanho viram CMD_REPETIR (2 bytes)
+#define MIN_REPETICAO 3
+// Lacunas sem mudança a partir deste tamanho viram CMD_PULAR (1 byte)
+#define MIN_PULO 2
+
+typedef struct {
+    const Animacao *anim;
+    const uint8_t *dados;
+    uint16_t tamanho;
+} AnimacaoCompactada;
+
+static uint8_t arena[COMPACTACAO_ARENA];
+static size_t arena_usada = 0;
+static AnimacaoCompactada registro[COMPACTACAO_MAX_ANIMACOES];
+static int num_registradas = 0;
+
+// Escritor com limite: depois de estourar, só conta
+typedef struct {
+    uint8_t *dados;
+    size_t capacidade;
+    size_t tamanho;
+} Escritor;
+
+static void escrever(Escritor *e, uint8_t byte) {
+    if (e->tamanho < e->capacidade) {
+        e->dados[e->tamanho] = byte;
+    }
+    e->tamanho++;
+}
+
+static void escrever_literal(Escritor *e, const uint8_t *niveis, int inicio, int fim) {
+    while (inicio < fim) {
+        int n = MIN(fim - inicio, CMD_N(0xFF));
+        escrever(e, CMD_LITERAL | n);
+        for (int k = 0; k < n; k += 2) {
+            uint8_t alto = (k + 1 < n) ? niveis[inicio + k + 1] : 0;
+            escrever(e, niveis[inicio + k] | (alto << 4));
+        }
+        inicio += n;
+    }
+}
+
+// Codifica os pixels [inicio, fim) com literais e repetições
+static void escrever_trecho(Escritor *e, const uint8_t *niveis, int inicio, int fim) {
+    int literal = inicio;
+    int i = inicio;
+    while (i < fim) {
+        int n = 1;
+        while (i + n < fim && n < CMD_N(0xFF) && niveis[i + n] == niveis[i]) {
+            n++;
+        }
+        if (n >= MIN_REPETICAO) {
+            escrever_literal(e, niveis, literal, i);
+            escrever(e, CMD_REPETIR | n);
+            escrever(e, niveis[i]);
+            i += n;
+            literal = i;
+        } else {
+            i += n;
+        }
+    }
+    escrever_literal(e, niveis, literal, fim);
+}
+
+// Só os trechos que mudaram; lacunas curtas entram no trecho para não custar um comando
+static void escrever_delta(Escritor *e, const uint8_t *anterior, const uint8_t *niveis) {
+    int cursor = 0;
+    int i = 0;
+    while (true) {
+        while (i < NUM_PIXELS && niveis[i] == anterior[i]) {
+            i++;
+        }
+        if (i == NUM_PIXELS) {
+            break; // O resto é igual: o fim do quadro já basta
+        }
+        for (int pulo = i - cursor; pulo > 0; pulo -= CMD_N(0xFF)) {
+            escrever(e, CMD_PULAR | MIN(pulo, CMD_N(0xFF)));
+        }
+
+        int fim = i;
+        int iguais = 0;
+        for (int j = i; j < NUM_PIXELS && iguais < MIN_PULO; j++) {
+            if (niveis[j] == anterior[j]) {
+                iguais++;
+            } else {
+                iguais = 0;
+                fim = j + 1;
+            }
+        }
+        escrever_trecho(e, niveis, i, fim);
+        cursor = i = fim;
+    }
+}
+
+static void ler_niveis(const Animacao *anim, int frame, uint8_t *niveis) {
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        niveis[i] = nivel_pixel(anim, frame, i);
+    }
+}
+
+// Primeiro quadro com o mesmo conteúdo de `frame` (o próprio, se for o primeiro)
+static int primeira_ocorrencia(const Animacao *anim, int frame) {
+    for (int k = 0; k < frame; k++) {
+        if (memcmp(anim->frames[k], anim->frames[frame], BYTES_POR_QUADRO) == 0) {
+            return k;
+        }
+    }
+    return frame;
+}
+
+static bool reaparece(const Animacao *anim, int frame) {
+    for (int k = frame + 1; k < anim->num_frames; k++) {
+        if (memcmp(anim->frames[k], anim->frames[frame], BYTES_POR_QUADRO) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t compactar_animacao(const Animacao *anim, uint8_t *saida, size_t capacidade) {
+    Escritor e = { .dados = saida, .capacidade = capacidade, .tamanho = 0 };
+    uint8_t anterior[NUM_PIXELS];
+    uint8_t niveis[NUM_PIXELS];
+    uint16_t deslocamento[COMPACTACAO_MAX_QUADROS]; // Onde cada quadro-chave começa
+    if (anim->num_frames > COMPACTACAO_MAX_QUADROS) {
+        return 0;
+    }
+
+    for (int frame = 0; frame < anim->num_frames; frame++) {
+        ler_niveis(anim, frame, niveis);
+
+        // Mede o delta sem escrever e compara com as outras formas
+        size_t tamanho_delta = SIZE_MAX;
+        if (frame > 0) {
+            Escritor medida = { .dados = NULL, .capacidade = 0, .tamanho = 0 };
+            escrever_delta(&medida, anterior, niveis);
+            tamanho_delta = medida.tamanho + 1;
+        }
+        Escritor medida = { .dados = NULL, .capacidade = 0, .tamanho = 0 };
+        escrever_trecho(&medida, niveis, 0, NUM_PIXELS);
+        size_t tamanho_chave = medida.tamanho + 2;
+
+        int original = primeira_ocorrencia(anim, frame);
+        if (original < frame && tamanho_delta > 3) {
+            // Quadro que volta: aponta para o quadro-chave da primeira ocorrência
+            escrever(&e, CMD_REFERENCIA);
+            escrever(&e, deslocamento[original] & 0xFF);
+            escrever(&e, deslocamento[original] >> 8);
+        } else if (tamanho_delta <= tamanho_chave && !(reaparece(anim, frame) && original == frame)) {
+            escrever_delta(&e, anterior, niveis);
+            escrever(&e, CMD_FIM);
+        } else {
+            deslocamento[frame] = (uint16_t)e.tamanho;
+            escrever(&e, CMD_CHAVE);
+            escrever_trecho(&e, niveis, 0, NUM_PIXELS);
+            escrever(&e, CMD_FIM);
+        }
+        memcpy(anterior, niveis, sizeof(niveis));
+    }
+
+    return e.tamanho <= capacidade ? e.tamanho : 0;
+}
+
+void compactacao_init(const Animacao *const *lista, int quantidade) {
+    for (int k = 0; k < quantidade && num_registradas < COMPACTACAO_MAX_ANIMACOES; k++) {
+        size_t tamanho = compactar_animacao(lista[k], arena + arena_usada, sizeof(arena) - arena_usada);
+        if (tamanho == 0 || tamanho >= (size_t)lista[k]->num_frames * BYTES_POR_QUADRO) {
+            continue;
+        }
+        registro[num_registradas++] = (AnimacaoCompactada) {
+            .anim = lista[k], .dados = arena + arena_usada, .tamanho = (uint16_t)tamanho
+        };
+        arena_usada += tamanho;
+    }
+}
+
+const uint8_t *compactacao_buscar(const Animacao *anim, size_t *tamanho) {
+    for (int k = 0; k < num_registradas; k++) {
+        if (registro[k].anim == anim) {
+            if (tamanho) {
+                *tamanho = registro[k].tamanho;
+            }
+            return registro[k].dados;
+        }
+    }
+    return NULL;
+}
+
+void leitor_iniciar(LeitorQuadros *l, const Animacao *anim) {
+    l->anim = anim;
+    l->inicio = l->pos = compactacao_buscar(anim, NULL);
+    l->quadro = 0;
+    memset(l->niveis, 0, sizeof(l->niveis));
+}
+
+static inline int atualizar(uint8_t *nivel, uint8_t novo) {
+    int mudou = *nivel != novo;
+    *nivel = novo;
+    return mudou;
+}
+
+int leitor_proximo(LeitorQuadros *l) {
+    if (l->quadro == l->anim->num_frames) {
+        l->quadro = 0;
+        l->pos = l->inicio; // O primeiro quadro é sempre quadro-chave
+    }
+
+    int mudaram = 0;
+    if (!l->inicio) {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            mudaram += atualizar(&l->niveis[i], nivel_pixel(l->anim, l->quadro, i));
+        }
+        l->quadro++;
+        return mudaram;
+    }
+
+    const uint8_t *p = l->pos;
+    const uint8_t *retorno = NULL; // Depois de um quadro referenciado, segue daqui
+    int cursor = 0;
+    while (true) {
+        uint8_t cmd = *p++;
+        int n = CMD_N(cmd);
+        switch (CMD_TIPO(cmd)) {
+        case CMD_PULAR:
+            cursor += n;
+            break;
+        case CMD_LITERAL:
+            for (int k = 0; k < n; k++) {
+                uint8_t par = p[k >> 1];
+                mudaram += atualizar(&l->niveis[cursor++], (k & 1) ? (par >> 4) : (par & 0x0F));
+            }
+            p += (n + 1) / 2;
+            break;
+        case CMD_REPETIR: {
+            uint8_t nivel = *p++;
+            for (int k = 0; k < n; k++) {
+                mudaram += atualizar(&l->niveis[cursor++], nivel);
+            }
+            break;
+        }
+        default:
+            if (cmd == CMD_FIM) {
+                l->pos = retorno ? retorno : p;
+                l->quadro++;
+                return mudaram;
+            }
+            if (cmd == CMD_REFERENCIA) {
+                retorno = p + 2;
+                p = l->inicio + (p[0] | (p[1] << 8));
+            }
+            break; // CMD_CHAVE só marca o ponto de entrada
+        }
+    }
+}
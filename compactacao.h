@@ -0,0 +1,61 @@
+#ifndef COMPACTACAO_H
+#define COMPACTACAO_H
+
+#include "animacao.h"
+
+// Formato compactado: cada quadro é uma sequência de comandos de um byte aplicados
+// sobre o quadro anterior, com um cursor de pixel que começa em 0 em cada quadro.
+//   00nnnnnn             pula n pixels (iguais ao quadro anterior)
+//   01nnnnnn + bytes     n níveis literais, dois por byte (como em QUADRO)
+//   10nnnnnn + nível     n pixels seguidos com o mesmo nível (run-length)
+//   11000001             quadro-chave: não depende do quadro anterior
+//   11000010 + 2 bytes   quadro igual a um quadro-chave anterior, no deslocamento
+//                        dado (little-endian); ocupa o quadro inteiro
+//   11000000             fim do quadro; o resto fica igual ao quadro anterior
+// Um quadro idêntico ao anterior ocupa só o byte de fim, e um quadro que volta
+// (animações que alternam dois quadros) ocupa 3 bytes.
+#define CMD_PULAR      0x00
+#define CMD_LITERAL    0x40
+#define CMD_REPETIR    0x80
+#define CMD_CHAVE      0xC1
+#define CMD_REFERENCIA 0xC2
+#define CMD_FIM        0xC0
+#define CMD_TIPO(c)    ((c) & 0xC0)
+#define CMD_N(c)       ((c) & 0x3F)
+
+// Espaço em RAM para as animações compactadas na inicialização
+#define COMPACTACAO_MAX_ANIMACOES 16
+#define COMPACTACAO_ARENA 2048
+
+// Quadros por animação compactada; acima disso ela fica nos quadros empacotados
+#define COMPACTACAO_MAX_QUADROS 64
+
+// Compacta os quadros de `anim` em `saida`. Um quadro vira quadro-chave quando o
+// delta não fica menor ou quando ele volta mais adiante. Retorna o tamanho, ou 0
+// se não couber em `capacidade` ou se tiver mais que COMPACTACAO_MAX_QUADROS.
+size_t compactar_animacao(const Animacao *anim, uint8_t *saida, size_t capacidade);
+
+// Compacta as animações na arena; chamar antes de iniciar o pipeline.
+// As que não couberem ou não ficarem menores continuam sendo lidas dos quadros
+// empacotados.
+void compactacao_init(const Animacao *const *lista, int quantidade);
+
+// Fluxo compactado de `anim` (NULL se não foi compactada)
+const uint8_t *compactacao_buscar(const Animacao *anim, size_t *tamanho);
+
+// Leitor de quadros: decodifica um quadro por vez sobre `niveis`, no lugar,
+// e volta ao primeiro quadro depois do último
+typedef struct {
+    const Animacao *anim;
+    const uint8_t *inicio;  // Fluxo compactado (NULL: lê os quadros empacotados)
+    const uint8_t *pos;
+    int quadro;
+    uint8_t niveis[NUM_PIXELS];
+} LeitorQuadros;
+
+void leitor_iniciar(LeitorQuadros *l, const Animacao *anim);
+
+// Avança para o próximo quadro. Retorna quantos pixels mudaram (0 = quadro repetido).
+int leitor_proximo(LeitorQuadros *l);
+
+#endif
@@ -0,0 +1,143 @@
+#include <string.h>
+#include "compositor.h"
+#include "agendador.h"
+#include "raster.h"
+
+// Canais alternados de uma palavra GRB: R e o byte baixo (W) em PARES, G e B em
+// (p >> 8) & PARES. Cada canal fica sozinho numa metade de 16 bits, com 8 bits
+// de folga para o produto por um peso de até 256.
+#define PARES 0x00FF00FFu
+#define ESTOUROS 0x01000100u
+
+// (c * peso + d * (256 - peso)) / 256 nos quatro canais, com duas multiplicações
+// por par de canais
+static inline uint32_t interpolar(uint32_t d, uint32_t c, uint32_t peso) {
+    uint32_t inverso = 256 - peso;
+    uint32_t rw = (((c & PARES) * peso + (d & PARES) * inverso) >> 8) & PARES;
+    uint32_t gb = (((c >> 8) & PARES) * peso + ((d >> 8) & PARES) * inverso) & ~PARES;
+    return rw | gb;
+}
+
+static inline uint32_t escalar(uint32_t c, uint32_t peso) {
+    uint32_t rw = (((c & PARES) * peso) >> 8) & PARES;
+    uint32_t gb = (((c >> 8) & PARES) * peso) & ~PARES;
+    return rw | gb;
+}
+
+// Soma com saturação: o estouro de cada metade (bit 8) vira 0xFF no canal
+static inline uint32_t somar_saturado(uint32_t d, uint32_t c) {
+    uint32_t rw = (d & PARES) + (c & PARES);
+    uint32_t gb = ((d >> 8) & PARES) + ((c >> 8) & PARES);
+    uint32_t e_rw = rw & ESTOUROS, e_gb = gb & ESTOUROS;
+    rw = (rw | (e_rw - (e_rw >> 8))) & PARES;
+    gb = (gb | (e_gb - (e_gb >> 8))) & PARES;
+    return rw | (gb << 8);
+}
+
+// a * b / 255 arredondado, exato para 0..255
+static inline uint32_t multiplicar_canal(uint32_t a, uint32_t b) {
+    uint32_t t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+void misturar_sobre(uint32_t *destino, const uint32_t *camada, uint n, uint32_t peso, bool chave_preta) {
+    if (peso == 0) {
+        return;
+    }
+    for (uint i = 0; i < n; i++) {
+        uint32_t c = camada[i];
+        if (chave_preta && c == 0) {
+            continue;
+        }
+        destino[i] = interpolar(destino[i], c, peso);
+    }
+}
+
+void misturar_soma(uint32_t *destino, const uint32_t *camada, uint n, uint32_t peso) {
+    if (peso == 0) {
+        return;
+    }
+    for (uint i = 0; i < n; i++) {
+        destino[i] = somar_saturado(destino[i], peso == 256 ? camada[i] : escalar(camada[i], peso));
+    }
+}
+
+void misturar_multiplica(uint32_t *destino, const uint32_t *camada, uint n, uint32_t peso) {
+    if (peso == 0) {
+        return;
+    }
+    for (uint i = 0; i < n; i++) {
+        uint32_t d = destino[i], c = camada[i];
+        // Os produtos não cabem dois por palavra (cada canal multiplica por um
+        // valor diferente), então G, R e B vão um a um; a opacidade volta a ser SWAR
+        uint32_t m = (multiplicar_canal(d >> 24, c >> 24) << 24)
+                   | (multiplicar_canal((d >> 16) & 0xFF, (c >> 16) & 0xFF) << 16)
+                   | (multiplicar_canal((d >> 8) & 0xFF, (c >> 8) & 0xFF) << 8);
+        destino[i] = interpolar(d, m, peso);
+    }
+}
+
+void compor(uint32_t *destino, const Camada *camadas, uint num_camadas, uint num_pixels) {
+    memset(destino, 0, num_pixels * sizeof(uint32_t));
+    for (uint k = 0; k < num_camadas; k++) {
+        const Camada *c = &camadas[k];
+        uint32_t peso = peso_opacidade(c->opacidade);
+        switch (c->modo) {
+        case MISTURA_SOBRE:
+            misturar_sobre(destino, c->pixels, num_pixels, peso, c->chave_preta);
+            break;
+        case MISTURA_SOMA:
+            misturar_soma(destino, c->pixels, num_pixels, peso);
+            break;
+        case MISTURA_MULTIPLICA:
+            misturar_multiplica(destino, c->pixels, num_pixels, peso);
+            break;
+        }
+    }
+}
+
+void executar_composicao(const Composicao *c) {
+    static uint32_t pixels[COMPOSITOR_MAX_CAMADAS][NUM_PIXELS];
+    uint32_t tabelas[COMPOSITOR_MAX_CAMADAS][NIVEIS_INTENSIDADE + 1];
+    int quadro_atual[COMPOSITOR_MAX_CAMADAS];
+    Camada camadas[COMPOSITOR_MAX_CAMADAS];
+
+    uint n = c->num_camadas < COMPOSITOR_MAX_CAMADAS ? c->num_camadas : COMPOSITOR_MAX_CAMADAS;
+    for (uint k = 0; k < n; k++) {
+        const CamadaAnimada *ca = &c->camadas[k];
+        tabela_niveis(tabelas[k], ca->anim->r, ca->anim->g, ca->anim->b);
+        quadro_atual[k] = -1;
+        camadas[k] = (Camada) { .pixels = pixels[k], .modo = ca->modo, .chave_preta = ca->chave_preta };
+    }
+
+    uint32_t num_quadros = c->duracao_ms * c->fps / 1000;
+    Agendador ag;
+    agendador_iniciar(&ag, c->fps * 1000);
+    for (uint32_t q = 0; q < num_quadros; q++) {
+        uint32_t t_ms = q * 1000 / c->fps;
+        for (uint k = 0; k < n; k++) {
+            const CamadaAnimada *ca = &c->camadas[k];
+
+            // Cada camada no seu FPS; só redesenha quando o quadro dela muda
+            int quadro = (int)(t_ms * ca->anim->fps / 1000 % ca->anim->num_frames);
+            if (quadro != quadro_atual[k]) {
+                uint8_t niveis[NUM_PIXELS];
+                for (int i = 0; i < NUM_PIXELS; i++) {
+                    niveis[i] = nivel_pixel(ca->anim, quadro, i);
+                }
+                raster_niveis(pixels[k], niveis, tabelas[k], tabelas[k]);
+                quadro_atual[k] = quadro;
+            }
+
+            int delta = ca->opacidade_fim - ca->opacidade_inicio;
+            uint32_t passos = num_quadros > 1 ? num_quadros - 1 : 1;
+            camadas[k].opacidade = (uint8_t)(ca->opacidade_inicio + delta * (int)q / (int)passos);
+        }
+
+        compor(saida_led_quadro(), camadas, n, NUM_PIXELS);
+        saida_led_enviar();
+        if (!agendador_esperar(&ag)) {
+            break; // Outra tecla foi pressionada
+        }
+    }
+}
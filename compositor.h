@@ -0,0 +1,64 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "pico/stdlib.h"
+#include "animacao.h"
+
+// Compositor: junta várias camadas de pixels (palavras GRB, como as da saída) num
+// quadro só, cada uma com opacidade e modo de mistura. Os kernels trabalham na
+// palavra inteira, dois canais por vez em metades de 16 bits (SWAR): uma
+// multiplicação de 32 bits mistura dois canais, sem separar byte a byte.
+
+// Camadas de uma composição
+#define COMPOSITOR_MAX_CAMADAS 4
+
+typedef enum {
+    MISTURA_SOBRE,       // Cobre o que está embaixo na proporção da opacidade
+    MISTURA_SOMA,        // Soma com saturação em 255 (luz sobre luz)
+    MISTURA_MULTIPLICA,  // Multiplica canal a canal (escurece; branco não muda nada)
+} ModoMistura;
+
+// Opacidade 0..255 -> peso 0..256 dos kernels (255 vira 256: cobre por inteiro)
+static inline uint32_t peso_opacidade(uint8_t opacidade) {
+    return opacidade + (opacidade >> 7);
+}
+
+// Kernels: destino = mistura(destino, camada) nos n pixels, com peso 0..256.
+// Em MISTURA_SOBRE, chave_preta faz os pixels pretos (0) da camada não cobrirem
+// nada, como uma máscara (ex.: dígitos sobre um fundo).
+void misturar_sobre(uint32_t *destino, const uint32_t *camada, uint n, uint32_t peso, bool chave_preta);
+void misturar_soma(uint32_t *destino, const uint32_t *camada, uint n, uint32_t peso);
+void misturar_multiplica(uint32_t *destino, const uint32_t *camada, uint n, uint32_t peso);
+
+// Uma camada pronta para compor
+typedef struct {
+    const uint32_t *pixels;
+    ModoMistura modo;
+    uint8_t opacidade;
+    bool chave_preta;
+} Camada;
+
+// Compõe as camadas em ordem (a primeira é o fundo, misturada sobre preto)
+void compor(uint32_t *destino, const Camada *camadas, uint num_camadas, uint num_pixels);
+
+// Camada tirada de uma animação, que avança no seu próprio FPS. A opacidade vai
+// de opacidade_inicio a opacidade_fim ao longo da composição (iguais = fixa;
+// diferentes = fade, ex.: transição entre duas animações).
+typedef struct {
+    const Animacao *anim;
+    ModoMistura modo;
+    uint8_t opacidade_inicio, opacidade_fim;
+    bool chave_preta;
+} CamadaAnimada;
+
+typedef struct {
+    const CamadaAnimada *camadas;
+    uint num_camadas;
+    uint16_t fps;           // Taxa da composição (cada camada troca de quadro no seu FPS)
+    uint32_t duracao_ms;
+} Composicao;
+
+// Toca a composição na saída; para antes se outra tecla for pressionada
+void executar_composicao(const Composicao *c);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef CONTADOR64_H
+#define CONTADOR64_H
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+// Contador de 64 bits escrito por um núcleo e lido pelo outro. No M0+ um uint64_t
+// são duas palavras, e uma leitura no meio da virada dos 32 bits de baixo pegaria
+// uma metade antiga com a outra nova. O escritor grava alto1, baixo e alto2, nessa
+// ordem; o leitor lê alto2, baixo e alto1 e repete enquanto os dois altos não
+// baterem.
+typedef struct {
+    volatile uint32_t alto1;
+    volatile uint32_t baixo;
+    volatile uint32_t alto2;
+} Contador64;
+
+// Só no núcleo que escreve
+static inline void contador64_somar(Contador64 *c, uint64_t delta) {
+    uint64_t v = (((uint64_t)c->alto2 << 32) | c->baixo) + delta;
+    c->alto1 = (uint32_t)(v >> 32);
+    __dmb();
+    c->baixo = (uint32_t)v;
+    __dmb();
+    c->alto2 = (uint32_t)(v >> 32);
+}
+
+// Em qualquer núcleo
+static inline uint64_t contador64_ler(const Contador64 *c) {
+    while (true) {
+        uint32_t alto2 = c->alto2;
+        __dmb();
+        uint32_t baixo = c->baixo;
+        __dmb();
+        uint32_t alto1 = c->alto1;
+        if (alto1 == alto2) {
+            return ((uint64_t)alto1 << 32) | baixo;
+        }
+    }
+}
+
+#endif
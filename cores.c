@@ -0,0 +1,15 @@
+#include <math.h>
+#include "cores.h"
+
+void tabela_niveis(uint32_t tabela[NIVEIS_INTENSIDADE + 1], uint16_t r, uint16_t g, uint16_t b) {
+    for (uint n = 0; n <= NIVEIS_INTENSIDADE; n++) {
+        tabela[n] = matrix_rgb(escalar_componente(b, n), escalar_componente(r, n), escalar_componente(g, n));
+    }
+}
+
+void gamma_tabela(uint16_t tabela[256], float gamma) {
+    // Calculada uma vez na inicialização; o ponto flutuante não entra no caminho quente
+    for (int i = 0; i < 256; i++) {
+        tabela[i] = (uint16_t)(powf(i / 255.0f, gamma) * 65280.0f + 0.5f);
+    }
+}
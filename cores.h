@@ -0,0 +1,40 @@
+#ifndef CORES_H
+#define CORES_H
+
+#include "pico/stdlib.h"
+
+// Intensidades quantizadas em 4 bits (0..15); 15 representa 1.0, então os passos de 0.2 são exatos
+#define NIVEIS_INTENSIDADE 15
+
+// Componente de cor em ponto fixo 8.8: 0..255 com 8 bits de fração (1.0 -> 255 << 8).
+// A fração guarda valores como 0.5 * 255 = 127.5 sem arredondar antes da hora.
+#define COR_FX(v) ((uint16_t)((v) * 255.0 * 256.0 + 0.5))
+
+// Função para criar cor RGB (componentes de 0 a 255)
+static inline uint32_t matrix_rgb(uint8_t b, uint8_t r, uint8_t g) {
+    return ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8);
+}
+
+// Componente 8.8 escalada por um nível de intensidade, truncada para 8 bits
+static inline uint8_t escalar_componente(uint16_t c, uint n) {
+    return (uint8_t)(((uint32_t)c * n / NIVEIS_INTENSIDADE) >> 8);
+}
+
+// Cor 8.8 escalada por uma intensidade 0..255 (255 -> cor cheia), já como palavra GRB
+static inline uint32_t cor_escalada(uint16_t r, uint16_t g, uint16_t b, uint8_t n) {
+    uint32_t m = (uint32_t)n + 1;
+    return matrix_rgb((b * m) >> 16, (r * m) >> 16, (g * m) >> 16);
+}
+
+// Preenche a tabela nível (0..15) -> palavra GRB de uma cor; depois disso cada pixel
+// custa só uma consulta, sem multiplicações por pixel
+void tabela_niveis(uint32_t tabela[NIVEIS_INTENSIDADE + 1], uint16_t r, uint16_t g, uint16_t b);
+
+// Gama usada pelo modo de alta taxa da saída
+#define GAMMA_PADRAO 2.2f
+
+// Tabela 0..255 -> brilho com gama, em ponto fixo 8.8 (255 -> 255 << 8).
+// A parte fracionária é o que o dithering temporal reproduz.
+void gamma_tabela(uint16_t tabela[256], float gamma);
+
+#endif
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include "energia.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "teclado.h"
+
+static ObservadorClock observadores[ENERGIA_MAX_OBSERVADORES];
+static volatile uint num_observadores = 0;
+
+static bool ligado = true;
+static uint32_t hz_cheio;       // clk_sys do boot, direto do PLL_SYS
+static uint32_t hz_atual;
+static uint32_t trocas = 0;
+
+// Render parado desde (0 = ocupado ou o clock já está baixo)
+static uint64_t parado_desde_us = 0;
+
+// Contabilidade do laço do núcleo 0: o tempo entre duas marcas vai para ativo ou
+// ocioso, e vira ciclos no clock que valia naquele trecho
+static uint64_t marca_us;
+static uint64_t inicio_us;
+static uint64_t ativo_us = 0, ocioso_us = 0, baixo_us = 0;
+static uint64_t ciclos_ativos = 0, ciclos_ociosos = 0;
+
+// Voltas do laço: total e a taxa na última janela de 1 s
+static uint32_t voltas = 0;
+static uint32_t voltas_janela = 0;
+static uint64_t inicio_janela_us;
+static uint32_t voltas_por_segundo = 0;
+
+static void contabilizar(bool dormindo) {
+    uint64_t agora = time_us_64();
+    uint64_t dt = agora - marca_us;
+    uint64_t ciclos = dt * hz_atual / 1000000;
+    if (dormindo) {
+        ocioso_us += dt;
+        ciclos_ociosos += ciclos;
+    } else {
+        ativo_us += dt;
+        ciclos_ativos += ciclos;
+    }
+    if (hz_atual != hz_cheio) {
+        baixo_us += dt;
+    }
+    marca_us = agora;
+}
+
+static void contar_volta(void) {
+    voltas++;
+    voltas_janela++;
+    uint64_t decorrido = marca_us - inicio_janela_us;
+    if (decorrido >= 1000000) {
+        voltas_por_segundo = (uint32_t)((uint64_t)voltas_janela * 1000000 / decorrido);
+        voltas_janela = 0;
+        inicio_janela_us = marca_us;
+    }
+}
+
+// Troca só o divisor do clk_sys (fonte auxiliar PLL_SYS), com os observadores
+// avisados antes e depois
+static void trocar_clock(uint32_t hz) {
+    if (hz == hz_atual) {
+        return;
+    }
+    contabilizar(false);
+
+    uint n = num_observadores;
+    for (uint i = 0; i < n; i++) {
+        observadores[i](CLOCK_ANTES);
+    }
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS, hz_cheio, hz);
+    hz_atual = hz;
+    trocas++;
+    for (uint i = 0; i < n; i++) {
+        observadores[i](CLOCK_DEPOIS);
+    }
+}
+
+void energia_init(void) {
+    hz_cheio = hz_atual = clock_get_hz(clk_sys);
+    inicio_us = marca_us = inicio_janela_us = time_us_64();
+    teclado_definir_espera_borda(ligado);
+}
+
+void energia_observar(ObservadorClock observador) {
+    uint32_t status = save_and_disable_interrupts();
+    if (num_observadores < ENERGIA_MAX_OBSERVADORES) {
+        observadores[num_observadores] = observador;
+        __dmb(); // O observador está na tabela antes de a contagem o incluir
+        num_observadores++;
+    }
+    restore_interrupts(status);
+}
+
+void energia_definir(bool novo) {
+    if (!novo) {
+        trocar_clock(hz_cheio);
+    }
+    ligado = novo;
+    parado_desde_us = 0;
+    teclado_definir_espera_borda(novo);
+}
+
+bool energia_ligada(void) {
+    return ligado;
+}
+
+void energia_acordar(void) {
+    parado_desde_us = 0;
+    trocar_clock(hz_cheio);
+}
+
+void energia_dormir(bool render_parado) {
+    if (!ligado) {
+        // O laço gira como antes: cada volta conta, sem dormir
+        contabilizar(false);
+        contar_volta();
+        return;
+    }
+
+    uint64_t agora = time_us_64();
+    uint64_t prazo = 0;
+    if (!render_parado) {
+        parado_desde_us = 0;
+    } else if (hz_atual == hz_cheio) {
+        if (parado_desde_us == 0) {
+            parado_desde_us = agora;
+        }
+        prazo = parado_desde_us + ENERGIA_ATRASO_US;
+        if (agora >= prazo) {
+            trocar_clock(hz_cheio / ENERGIA_DIVISOR);
+            prazo = 0;
+        }
+    }
+
+    contabilizar(false);
+    if (prazo) {
+        // Acorda no fim do atraso para baixar o clock, se nada chegar antes
+        best_effort_wfe_or_timeout(from_us_since_boot(prazo));
+    } else {
+        __wfe(); // Eventos da fila do teclado, da fila de pedidos e dos semáforos fazem SEV
+    }
+    contabilizar(true);
+    contar_volta();
+}
+
+static void imprimir_trecho(const char *nome, uint64_t us, uint64_t ciclos, uint64_t total_us) {
+    printf("  %-7s %8lu ms  %10lu kciclos  %3lu%%\n", nome, (unsigned long)(us / 1000),
+           (unsigned long)(ciclos / 1000), (unsigned long)(total_us ? us * 100 / total_us : 0));
+}
+
+void energia_relatorio(void) {
+    contabilizar(false);
+    uint64_t total = ativo_us + ocioso_us;
+
+    printf("Modo ocioso: %s  clk_sys %lu.%lu MHz (cheio %lu.%lu, ocioso /%d)  trocas %lu\n",
+           ligado ? "ligado" : "desligado",
+           (unsigned long)(hz_atual / 1000000), (unsigned long)(hz_atual / 100000 % 10),
+           (unsigned long)(hz_cheio / 1000000), (unsigned long)(hz_cheio / 100000 % 10),
+           ENERGIA_DIVISOR, (unsigned long)trocas);
+    printf("Nucleo 0 em %lu ms:\n", (unsigned long)((marca_us - inicio_us) / 1000));
+    imprimir_trecho("ativo", ativo_us, ciclos_ativos, total);
+    imprimir_trecho("dormindo", ocioso_us, ciclos_ociosos, total);
+    printf("  clock baixo %lu%% do tempo\n", (unsigned long)(total ? baixo_us * 100 / total : 0));
+    printf("Voltas do laco: %lu/s no ultimo segundo, %lu no total\n",
+           (unsigned long)voltas_por_segundo, (unsigned long)voltas);
+    printf("Teclado: %s, %lu bordas\n", teclado_varrendo() ? "varrendo" : "parado esperando borda",
+           (unsigned long)teclado_bordas());
+}
@@ -0,0 +1,60 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include "pico/stdlib.h"
+
+// Modo ocioso do núcleo 0: sem comando nem tecla, o laço principal dorme em WFE até
+// a próxima IRQ (timer do teclado, borda de uma coluna, alarme do buzzer, USB) ou
+// SEV do outro núcleo, em vez de girar em volta de getchar e detect_key. Com o
+// núcleo de renderização parado (nenhuma animação, ou uma cor fixa já nos LEDs)
+// por ENERGIA_ATRASO_US, o clk_sys cai para PLL_SYS / ENERGIA_DIVISOR e volta ao
+// clock cheio antes do próximo comando.
+//
+// Só o divisor do clk_sys muda: o PLL continua travado e a troca leva poucos
+// ciclos. O timer de 1 MHz vem do clk_ref, então os tempos em us não mudam; quem
+// depende do clk_sys (divisor do PIO dos LEDs, tom e taxa de amostras do buzzer)
+// se registra em energia_observar e é recalculado a cada troca.
+
+// Divisor do clk_sys no modo ocioso (inteiro, sem jitter). 125 MHz / 2 = 62,5 MHz:
+// o USB do stdio pede o clk_sys acima dos 48 MHz do clk_usb. Sem USB dá para ir a 5.
+#ifndef ENERGIA_DIVISOR
+#define ENERGIA_DIVISOR 2
+#endif
+
+// Tempo com o núcleo de renderização parado antes de baixar o clock; evita trocar
+// entre duas teclas seguidas
+#define ENERGIA_ATRASO_US 100000
+
+#define ENERGIA_MAX_OBSERVADORES 4
+
+typedef enum {
+    CLOCK_ANTES,    // Ainda no clock antigo: parar o que não pode ver a troca
+    CLOCK_DEPOIS    // clock_get_hz(clk_sys) já é o novo: recalcular os tempos
+} EtapaClock;
+
+typedef void (*ObservadorClock)(EtapaClock etapa);
+
+// Guarda o clock cheio (o do boot) e começa a contar os ciclos do laço
+void energia_init(void);
+
+// Chamado nas duas etapas de cada troca do clk_sys, no núcleo 0
+void energia_observar(ObservadorClock observador);
+
+// Liga/desliga o modo ocioso. Desligado, o laço gira no clock cheio como antes
+// e o teclado é varrido sem parar.
+void energia_definir(bool ligado);
+bool energia_ligada(void);
+
+// Há trabalho (comando ou tecla): volta ao clock cheio. Chamar antes de mandar
+// qualquer tarefa ao núcleo de renderização.
+void energia_acordar(void);
+
+// Nada a fazer nesta volta do laço: baixa o clock se o núcleo de renderização
+// estiver parado há ENERGIA_ATRASO_US e dorme até a próxima IRQ ou SEV. Conta a
+// volta e o tempo (e os ciclos) ativo e dormindo.
+void energia_dormir(bool render_parado);
+
+// Clock atual, ciclos ativo x ocioso, voltas do laço por segundo no stdio (USB)
+void energia_relatorio(void);
+
+#endif
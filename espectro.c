@@ -0,0 +1,139 @@
+#include <math.h>
+#include "espectro.h"
+#include "cores.h"
+
+_Static_assert(ESPECTRO_N == 1 << ESPECTRO_LOG2_N, "ESPECTRO_N e ESPECTRO_LOG2_N");
+_Static_assert(ESPECTRO_BANDAS == 5, "uma banda de oitava por coluna da matriz");
+
+// Oitavas de 125 Hz a 2 kHz e o resto até 6 kHz; os bins 0 e 1 (DC e zumbido da rede) ficam de fora
+const uint8_t espectro_limites[ESPECTRO_BANDAS + 1] = { 2, 4, 8, 16, 32, 96 };
+
+#define DOIS_PI 6.28318531f
+
+// seno[k] = sen(2πk / N) em Q15; o cosseno é seno[k + N/4]
+static int16_t seno[ESPECTRO_N * 3 / 4];
+static int16_t janela[ESPECTRO_N];
+
+// Cor de cada linha da barra, de baixo para cima, em 8.8
+static const uint16_t cores_linha[MATRIZ_ALTURA][3] = {
+    { COR_FX(0.0), COR_FX(0.5), COR_FX(0.0) },
+    { COR_FX(0.0), COR_FX(0.5), COR_FX(0.0) },
+    { COR_FX(0.4), COR_FX(0.4), COR_FX(0.0) },
+    { COR_FX(0.5), COR_FX(0.2), COR_FX(0.0) },
+    { COR_FX(0.5), COR_FX(0.0), COR_FX(0.0) },
+};
+
+void espectro_init(void) {
+    for (uint k = 0; k < count_of(seno); k++) {
+        seno[k] = (int16_t)lroundf(32767.0f * sinf(DOIS_PI * (float)k / ESPECTRO_N));
+    }
+    for (uint i = 0; i < ESPECTRO_N; i++) {
+        janela[i] = (int16_t)lroundf(32767.0f * 0.5f * (1.0f - cosf(DOIS_PI * (float)i / ESPECTRO_N)));
+    }
+}
+
+void espectro_fft(int16_t *re, int16_t *im) {
+    // Ordem dos índices com os bits invertidos
+    for (uint i = 1, j = 0; i < ESPECTRO_N; i++) {
+        uint bit = ESPECTRO_N >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            int16_t t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+            t = im[i];
+            im[i] = im[j];
+            im[j] = t;
+        }
+    }
+
+    // Borboletas de raiz 2, estágio a estágio; cada estágio divide por 2
+    for (uint tamanho = 2, passo = ESPECTRO_N / 2; tamanho <= ESPECTRO_N; tamanho <<= 1, passo >>= 1) {
+        uint meio = tamanho / 2;
+        for (uint k = 0; k < meio; k++) {
+            int32_t wr = seno[k * passo + ESPECTRO_N / 4], wi = -seno[k * passo];
+            for (uint i = k; i < ESPECTRO_N; i += tamanho) {
+                uint j = i + meio;
+                int32_t tr = (wr * re[j] - wi * im[j]) >> 15;
+                int32_t ti = (wr * im[j] + wi * re[j]) >> 15;
+                int32_t ar = re[i], ai = im[i];
+                re[j] = (int16_t)((ar - tr) >> 1);
+                im[j] = (int16_t)((ai - ti) >> 1);
+                re[i] = (int16_t)((ar + tr) >> 1);
+                im[i] = (int16_t)((ai + ti) >> 1);
+            }
+        }
+    }
+}
+
+void espectro_bandas(const uint16_t *amostras, uint32_t energia[ESPECTRO_BANDAS]) {
+    static int16_t re[ESPECTRO_N], im[ESPECTRO_N];
+
+    uint32_t soma = 0;
+    for (uint i = 0; i < ESPECTRO_N; i++) {
+        soma += amostras[i] & 0x0FFF;
+    }
+    int32_t media = (int32_t)(soma >> ESPECTRO_LOG2_N);
+
+    // 12 bits sem o DC -> Q15, com a janela
+    for (uint i = 0; i < ESPECTRO_N; i++) {
+        int32_t x = ((int32_t)(amostras[i] & 0x0FFF) - media) * 8;
+        re[i] = (int16_t)((x * janela[i]) >> 15);
+        im[i] = 0;
+    }
+    espectro_fft(re, im);
+
+    for (uint b = 0; b < ESPECTRO_BANDAS; b++) {
+        uint32_t e = 0;
+        for (uint k = espectro_limites[b]; k < espectro_limites[b + 1]; k++) {
+            e += (uint32_t)(re[k] * re[k]) + (uint32_t)(im[k] * im[k]);
+        }
+        energia[b] = e;
+    }
+}
+
+// 16 * log2(x), com a fração pelos 4 bits seguintes ao mais alto
+static uint log2_16(uint32_t x) {
+    uint n = 31 - (uint)__builtin_clz(x);
+    uint32_t fracao = n >= 4 ? x >> (n - 4) : x << (4 - n);
+    return n * 16 + (fracao & 0x0F);
+}
+
+uint espectro_altura(uint32_t energia) {
+    if (energia == 0) {
+        return 0;
+    }
+    int nivel = (int)log2_16(energia) - ESPECTRO_PISO_LOG2 * 16;
+    if (nivel <= 0) {
+        return 0;
+    }
+    uint altura = (uint)nivel * ESPECTRO_ALTURA_MAX / ((ESPECTRO_TETO_LOG2 - ESPECTRO_PISO_LOG2) * 16);
+    return altura < ESPECTRO_ALTURA_MAX ? altura : ESPECTRO_ALTURA_MAX;
+}
+
+void espectro_suavizar(uint16_t alturas[ESPECTRO_BANDAS], const uint32_t energia[ESPECTRO_BANDAS]) {
+    for (uint b = 0; b < ESPECTRO_BANDAS; b++) {
+        uint nova = espectro_altura(energia[b]);
+        uint caindo = alturas[b] > ESPECTRO_QUEDA ? alturas[b] - ESPECTRO_QUEDA : 0;
+        alturas[b] = (uint16_t)(nova > caindo ? nova : caindo);
+    }
+}
+
+void espectro_desenhar(uint32_t *quadro, const uint16_t alturas[ESPECTRO_BANDAS]) {
+    raster_preencher(quadro, 0);
+    for (uint x = 0; x < ESPECTRO_BANDAS; x++) {
+        for (uint linha = 0; linha < MATRIZ_ALTURA; linha++) {
+            uint acesa = alturas[x] > linha * 16 ? alturas[x] - linha * 16 : 0;
+            if (acesa == 0) {
+                break;
+            }
+            // Linha cheia com brilho 255; a do topo, proporcional à fração
+            uint8_t brilho = acesa >= 16 ? 255 : (uint8_t)(acesa * 17);
+            const uint16_t *c = cores_linha[linha];
+            quadro[raster_indice(x, MATRIZ_ALTURA - 1 - linha)] = cor_escalada(c[0], c[1], c[2], brilho);
+        }
+    }
+}
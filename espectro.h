@@ -0,0 +1,52 @@
+#ifndef ESPECTRO_H
+#define ESPECTRO_H
+
+#include "pico/stdlib.h"
+#include "raster.h"
+
+// Espectro do microfone para o visualizador: cada bloco de amostras do ADC passa
+// por uma janela de Hann e uma FFT em ponto fixo (Q15), e a energia dos bins vira
+// uma barra por banda de oitava. Só inteiros: roda igual no Pico e no PC.
+
+#define ESPECTRO_N 256              // Amostras por bloco (potência de 2)
+#define ESPECTRO_LOG2_N 8
+#define ESPECTRO_TAXA_HZ 16000      // 62,5 blocos por segundo: um quadro por bloco
+#define ESPECTRO_BANDAS MATRIZ_LARGURA
+
+// Alturas das barras em 1/16 de linha (o pixel do topo acende em fração)
+#define ESPECTRO_ALTURA_MAX (MATRIZ_ALTURA * 16)
+
+// Descida das barras por bloco (1/16 de linha): sobem na hora e caem devagar
+#define ESPECTRO_QUEDA 3
+
+// Faixa mostrada, em log2 da energia da banda: abaixo do piso a barra fica
+// apagada (ruído do ADC), no teto ela enche (um seno perto do fundo de escala)
+#define ESPECTRO_PISO_LOG2 11
+#define ESPECTRO_TETO_LOG2 24
+
+// Bins de cada banda: a banda b soma os bins de espectro_limites[b] até
+// espectro_limites[b + 1] - 1 (cada bin tem ESPECTRO_TAXA_HZ / ESPECTRO_N = 62,5 Hz)
+extern const uint8_t espectro_limites[ESPECTRO_BANDAS + 1];
+
+// Tabelas de seno e da janela; chamar uma vez antes do resto
+void espectro_init(void);
+
+// FFT complexa no lugar, em Q15, com metade da escala a cada estágio: o resultado
+// é a transformada dividida por ESPECTRO_N, sem estouro para nenhuma entrada
+void espectro_fft(int16_t *re, int16_t *im);
+
+// Energia de cada banda (soma de re² + im² dos bins) de um bloco de ESPECTRO_N
+// amostras de 12 bits do ADC; o nível médio (DC) do bloco é descontado
+void espectro_bandas(const uint16_t *amostras, uint32_t energia[ESPECTRO_BANDAS]);
+
+// Altura (0..ESPECTRO_ALTURA_MAX) da barra de uma energia, em escala logarítmica
+uint espectro_altura(uint32_t energia);
+
+// Atualiza as barras com as energias de um bloco novo
+void espectro_suavizar(uint16_t alturas[ESPECTRO_BANDAS], const uint32_t energia[ESPECTRO_BANDAS]);
+
+// Desenha as barras (uma coluna por banda, de baixo para cima, do verde ao
+// vermelho) num quadro de palavras GRB, ex.: saida_led_quadro()
+void espectro_desenhar(uint32_t *quadro, const uint16_t alturas[ESPECTRO_BANDAS]);
+
+#endif
@@ -0,0 +1,37 @@
+#include <string.h>
+#include "fila_spsc.h"
+#include "hardware/sync.h"
+
+void fila_spsc_init(FilaSpsc *f, void *dados, uint16_t tamanho_item, uint16_t capacidade) {
+    f->dados = dados;
+    f->tamanho_item = tamanho_item;
+    f->capacidade = capacidade;
+    f->escrita = 0;
+    f->leitura = 0;
+}
+
+bool fila_spsc_inserir(FilaSpsc *f, const void *item) {
+    uint32_t escrita = f->escrita;
+    if (escrita - f->leitura >= f->capacidade) {
+        return false;
+    }
+
+    memcpy(f->dados + (escrita & (f->capacidade - 1)) * f->tamanho_item, item, f->tamanho_item);
+    __dmb(); // O item precisa estar visível antes do índice
+    f->escrita = escrita + 1;
+    __sev();
+    return true;
+}
+
+bool fila_spsc_retirar(FilaSpsc *f, void *item) {
+    uint32_t leitura = f->leitura;
+    if (leitura == f->escrita) {
+        return false;
+    }
+
+    __dmb(); // Lê o item só depois de ver o índice do produtor
+    memcpy(item, f->dados + (leitura & (f->capacidade - 1)) * f->tamanho_item, f->tamanho_item);
+    __dmb(); // Termina a cópia antes de liberar a posição
+    f->leitura = leitura + 1;
+    return true;
+}
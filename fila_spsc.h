@@ -0,0 +1,34 @@
+#ifndef FILA_SPSC_H
+#define FILA_SPSC_H
+
+#include "pico/stdlib.h"
+
+// Fila circular sem travas para um produtor e um consumidor (podem estar em núcleos
+// diferentes). Os índices crescem livremente e são mascarados na hora do acesso;
+// cada um é escrito por um só lado, então não é preciso desabilitar interrupções.
+typedef struct {
+    uint8_t *dados;
+    uint16_t tamanho_item;
+    uint16_t capacidade;        // Potência de 2
+    volatile uint32_t escrita;  // Só o produtor altera
+    volatile uint32_t leitura;  // Só o consumidor altera
+} FilaSpsc;
+
+// `dados` precisa ter espaço para capacidade * tamanho_item bytes
+void fila_spsc_init(FilaSpsc *f, void *dados, uint16_t tamanho_item, uint16_t capacidade);
+
+// Copia o item para a fila e acorda o outro núcleo (SEV); false se estiver cheia
+bool fila_spsc_inserir(FilaSpsc *f, const void *item);
+
+// Copia o item mais antigo para `item`; false se estiver vazia
+bool fila_spsc_retirar(FilaSpsc *f, void *item);
+
+static inline bool fila_spsc_vazia(const FilaSpsc *f) {
+    return f->escrita == f->leitura;
+}
+
+static inline uint32_t fila_spsc_ocupacao(const FilaSpsc *f) {
+    return f->escrita - f->leitura;
+}
+
+#endif
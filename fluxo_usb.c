@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <string.h>
+#include "fluxo_usb.h"
+#include "saida_led.h"
+#include "agendador.h"
+
+// Fatia das leituras: entre uma e outra a sessão confere o cancelamento
+#define FATIA_US 10000
+
+static volatile bool ativo = false;
+
+bool fluxo_ler_tudo(const PortaFluxo *p, uint8_t *buf, int n, EstatisticasFluxo *e) {
+    uint32_t ocioso = 0;
+    int lidos = 0;
+    while (lidos < n) {
+        int r = p->ler(buf + lidos, n - lidos, FATIA_US);
+        if (r > 0) {
+            lidos += r;
+            ocioso = 0;
+            continue;
+        }
+        if (p->cancelar && p->cancelar()) {
+            return false;
+        }
+        ocioso += FATIA_US;
+        if (ocioso >= FLUXO_OCIOSO_US) {
+            return false;
+        }
+    }
+    e->bytes += n;
+    return true;
+}
+
+static void responder(const PortaFluxo *p, uint8_t tipo, uint8_t seq) {
+    uint8_t resposta[3] = { FLUXO_SINC0, tipo, seq };
+    p->escrever(resposta, sizeof(resposta));
+}
+
+bool fluxo_sincronizar(const PortaFluxo *p, EstatisticasFluxo *e) {
+    uint8_t anterior = 0, c;
+    while (fluxo_ler_tudo(p, &c, 1, e)) {
+        if (anterior == FLUXO_SINC0 && c == FLUXO_SINC1) {
+            return true;
+        }
+        anterior = c;
+    }
+    return false;
+}
+
+// Os pixels chegam como G R B nos últimos 3n bytes do buffer de 4n e viram
+// palavras da frente para trás. A palavra i ocupa os bytes 4i..4i+3, antes do
+// próximo pixel ainda não lido (n+3i+3), então a conversão não sobrescreve nada e
+// o quadro não passa por nenhum buffer intermediário.
+static void expandir(uint32_t *quadro, uint n) {
+    const uint8_t *pixels = (const uint8_t *)quadro + n;
+    for (uint i = 0; i < n; i++, pixels += 3) {
+        quadro[i] = ((uint32_t)pixels[0] << 24) | ((uint32_t)pixels[1] << 16) | ((uint32_t)pixels[2] << 8);
+    }
+}
+
+void fluxo_sessao(const PortaFluxo *p, EstatisticasFluxo *e) {
+    uint max_pixels = p->num_pixels();
+    uint64_t inicio = time_us_64();
+    *e = (EstatisticasFluxo) { 0 };
+
+    uint8_t ola[5] = { FLUXO_SINC0, FLUXO_INICIO, FLUXO_JANELA, max_pixels & 0xFF, max_pixels >> 8 };
+    p->escrever(ola, sizeof(ola));
+
+    while (fluxo_sincronizar(p, e)) {
+        uint8_t cabecalho[3]; // seq, n
+        if (!fluxo_ler_tudo(p, cabecalho, sizeof(cabecalho), e)) {
+            break;
+        }
+        uint8_t seq = cabecalho[0];
+        uint n = cabecalho[1] | (cabecalho[2] << 8);
+        if (n == 0) {
+            responder(p, FLUXO_FIM, seq);
+            break;
+        }
+        if (n > max_pixels) {
+            e->rejeitados++;
+            responder(p, FLUXO_REJEITADO, seq);
+            continue; // Ressincroniza no próximo quadro
+        }
+
+        uint32_t *quadro = p->quadro();
+        uint8_t *pixels = (uint8_t *)quadro + n;
+        uint8_t crc_recebido[2];
+        if (!fluxo_ler_tudo(p, pixels, (int)(3 * n), e) || !fluxo_ler_tudo(p, crc_recebido, sizeof(crc_recebido), e)) {
+            break;
+        }
+        uint16_t crc = fluxo_crc16(FLUXO_CRC_INICIAL, cabecalho, sizeof(cabecalho));
+        crc = fluxo_crc16(crc, pixels, 3 * n);
+        if (crc != (crc_recebido[0] | (crc_recebido[1] << 8))) {
+            e->rejeitados++;
+            responder(p, FLUXO_REJEITADO, seq);
+            continue;
+        }
+
+        expandir(quadro, n);
+        if (n < max_pixels) {
+            memset(quadro + n, 0, (max_pixels - n) * sizeof(uint32_t)); // Resto apagado
+        }
+        p->publicar();
+        e->quadros++;
+        responder(p, FLUXO_ACEITO, seq);
+    }
+    e->duracao_us = time_us_64() - inicio;
+}
+
+// ---------------------------------------------------------------------------
+// Porta do firmware: stdio USB e saida_led
+// ---------------------------------------------------------------------------
+
+static int ler_usb(uint8_t *buf, int n, uint32_t timeout_us) {
+    int r = stdio_get_until((char *)buf, n, make_timeout_time_us(timeout_us));
+    return r > 0 ? r : 0;
+}
+
+static void escrever_usb(const uint8_t *buf, int n) {
+    stdio_put_string((const char *)buf, n, false, false); // Sem tradução de \n
+    stdio_flush();
+}
+
+const PortaFluxo fluxo_porta_usb = {
+    .ler = ler_usb,
+    .escrever = escrever_usb,
+    .quadro = saida_led_quadro,
+    .num_pixels = saida_led_num_pixels,
+    .publicar = saida_led_enviar,
+    .cancelar = agendador_cancelado,
+};
+
+void executar_fluxo_usb(void) {
+    // No modo de dois núcleos o laço principal para de ler o USB antes do pacote
+    // de início sair; o PC só manda quadros depois de recebê-lo
+    ativo = true;
+    EstatisticasFluxo e;
+    fluxo_sessao(&fluxo_porta_usb, &e);
+    ativo = false;
+
+    uint32_t ms = (uint32_t)(e.duracao_us / 1000);
+    printf("Fluxo USB: %lu quadros, %lu rejeitados, %llu bytes em %lu ms\n",
+           (unsigned long)e.quadros, (unsigned long)e.rejeitados, (unsigned long long)e.bytes, (unsigned long)ms);
+}
+
+bool fluxo_usb_ativo(void) {
+    return ativo;
+}
@@ -0,0 +1,94 @@
+#ifndef FLUXO_USB_H
+#define FLUXO_USB_H
+
+#include "pico/stdlib.h"
+
+// Fluxo de quadros binário pelo USB (CDC): um programa no PC manda quadros
+// prontos e o firmware os publica na saída assim que chegam, sem FPS próprio.
+//
+// O comando 's' abre a sessão; o firmware responde com o pacote de início e daí
+// em diante lê só quadros até receber o quadro de fim, ficar FLUXO_OCIOSO_US sem
+// dados ou outra tecla ser pressionada.
+//
+// PC -> Pico, um quadro (inteiros little-endian):
+//   A5 5A  seq  n(16 bits)  n x (G R B)  crc(16 bits)
+// O CRC-16/CCITT cobre seq, n e os pixels. n = 0 encerra a sessão.
+//
+// Pico -> PC, respostas de 3 bytes:
+//   A5 'K' seq    quadro publicado
+//   A5 'N' seq    quadro rejeitado (CRC ou tamanho); não foi publicado
+//   A5 'F' seq    fim da sessão
+// e, ao abrir a sessão, A5 'S' janela n_max(16 bits).
+//
+// Controle de fluxo: o PC pode ter no máximo `janela` quadros sem resposta. O
+// 'K' só sai depois que o quadro entrou no DMA, então a janela limita também a
+// latência entre o envio e os LEDs.
+
+#define FLUXO_SINC0 0xA5
+#define FLUXO_SINC1 0x5A
+#define FLUXO_INICIO 'S'
+#define FLUXO_ACEITO 'K'
+#define FLUXO_REJEITADO 'N'
+#define FLUXO_FIM 'F'
+
+// Bytes antes e depois dos pixels
+#define FLUXO_CABECALHO 5
+#define FLUXO_RODAPE 2
+
+// Quadros em trânsito: um sendo recebido no buffer de trás, outro na fila do USB
+#define FLUXO_JANELA 2
+
+// Sessão encerrada depois deste tempo sem nenhum byte
+#define FLUXO_OCIOSO_US 1000000
+
+static inline uint16_t fluxo_crc16(uint16_t crc, const uint8_t *dados, uint n) {
+    for (uint i = 0; i < n; i++) {
+        crc ^= (uint16_t)dados[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+#define FLUXO_CRC_INICIAL 0xFFFF
+
+// Onde a sessão lê, escreve e publica. No firmware é o stdio USB e a saida_led;
+// no PC (host/loopback_fluxo.c) um pty e uma saída simulada.
+typedef struct {
+    // Lê até n bytes, esperando no máximo timeout_us; retorna quantos leu (0 se nenhum)
+    int (*ler)(uint8_t *buf, int n, uint32_t timeout_us);
+    void (*escrever)(const uint8_t *buf, int n);
+    uint32_t *(*quadro)(void);  // Buffer de trás da saída
+    uint (*num_pixels)(void);
+    void (*publicar)(void);     // Troca os buffers e começa a transmitir
+    bool (*cancelar)(void);     // Outra tecla pressionada; NULL = nunca
+} PortaFluxo;
+
+typedef struct {
+    uint32_t quadros;
+    uint32_t rejeitados;
+    uint64_t bytes;
+    uint64_t duracao_us;
+} EstatisticasFluxo;
+
+// Roda uma sessão completa sobre a porta: início, quadros e fim
+void fluxo_sessao(const PortaFluxo *p, EstatisticasFluxo *e);
+
+// Lê exatamente n bytes; false se a sessão acabou antes (ociosa ou cancelada)
+bool fluxo_ler_tudo(const PortaFluxo *p, uint8_t *buf, int n, EstatisticasFluxo *e);
+
+// Procura o par de sincronismo; bytes fora de um quadro são descartados
+bool fluxo_sincronizar(const PortaFluxo *p, EstatisticasFluxo *e);
+
+// Porta do firmware: stdio USB e saida_led (também usada pelo acervo.h)
+extern const PortaFluxo fluxo_porta_usb;
+
+// Sessão pelo USB, publicando na saida_led (roda no núcleo de renderização)
+void executar_fluxo_usb(void);
+
+// Verdadeiro enquanto a sessão usa a entrada do USB: o laço principal não deve
+// ler caracteres nesse intervalo
+bool fluxo_usb_ativo(void);
+
+#endif
@@ -0,0 +1,151 @@
+// -------------------------------------------------------------- //
+// Gerado por compilar_animacoes a partir de animacoes.txt; nao edite!
+// -------------------------------------------------------------- //
+
+#pragma once
+
+#include "quadros_prontos.h"
+#include "raster.h"
+
+_Static_assert(NUM_PIXELS == 25, "quadros gerados para 5x5");
+_Static_assert(MATRIZ_PAINEL == 0, "quadros gerados para outro layout de painel");
+
+// coracao: 6 quadros a 6 fps, 600 bytes
+static const uint32_t coracao_quadros[6][NUM_PIXELS] = {
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+     0x00000000, 0x00000000, 0x00440d00, 0x00000000, 0x00000000,
+     0x00000000, 0x00440d00, 0x00440d00, 0x00440d00, 0x00000000,
+     0x00000000, 0x00440d00, 0x00000000, 0x00440d00, 0x00000000,
+     0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00ff3300, 0x00000000, 0x00000000,
+     0x00000000, 0x00ff3300, 0x00ff3300, 0x00ff3300, 0x00000000,
+     0x00ff3300, 0x00ff3300, 0x00ff3300, 0x00ff3300, 0x00ff3300,
+     0x00ff3300, 0x00ff3300, 0x00ff3300, 0x00ff3300, 0x00ff3300,
+     0x00000000, 0x00ff3300, 0x00000000, 0x00ff3300, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+     0x00000000, 0x00000000, 0x00881b00, 0x00000000, 0x00000000,
+     0x00000000, 0x00881b00, 0x00881b00, 0x00881b00, 0x00000000,
+     0x00881b00, 0x00881b00, 0x00881b00, 0x00881b00, 0x00881b00,
+     0x00000000, 0x00881b00, 0x00000000, 0x00881b00, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00cc2800, 0x00000000, 0x00000000,
+     0x00000000, 0x00cc2800, 0x00cc2800, 0x00cc2800, 0x00000000,
+     0x00cc2800, 0x00cc2800, 0x00cc2800, 0x00cc2800, 0x00cc2800,
+     0x00cc2800, 0x00cc2800, 0x00cc2800, 0x00cc2800, 0x00cc2800,
+     0x00000000, 0x00cc2800, 0x00000000, 0x00cc2800, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+     0x00000000, 0x00000000, 0x00440d00, 0x00000000, 0x00000000,
+     0x00000000, 0x00440d00, 0x00440d00, 0x00440d00, 0x00000000,
+     0x00440d00, 0x00440d00, 0x00440d00, 0x00440d00, 0x00440d00,
+     0x00000000, 0x00440d00, 0x00000000, 0x00440d00, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+     0x00000000, 0x00000000, 0x00220600, 0x00000000, 0x00000000,
+     0x00000000, 0x00220600, 0x00220600, 0x00220600, 0x00000000,
+     0x00000000, 0x00220600, 0x00000000, 0x00220600, 0x00000000,
+     0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+};
+static const uint16_t coracao_tons[6][2] = {
+    { 0, 0 }, { 220, 60 }, { 0, 0 }, { 196, 60 }, { 0, 0 }, { 0, 0 },
+};
+static const AnimacaoPronta animacao_pronta_coracao = {
+    .nome = "coracao",
+    .quadros = coracao_quadros,
+    .num_quadros = 6,
+    .fps = 6,
+    .tons = coracao_tons,
+};
+
+// chuva: 6 quadros a 10 fps, 600 bytes
+static const uint32_t chuva_quadros[6][NUM_PIXELS] = {
+    { 0x4c00ff00, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+     0x00000000, 0x4c00ff00, 0x00000000, 0x00000000, 0x21006e00,
+     0x0c002800, 0x00000000, 0x4c00ff00, 0x21006e00, 0x00000000,
+     0x00000000, 0x0c002800, 0x21006e00, 0x4c00ff00, 0x00000000,
+     0x00000000, 0x21006e00, 0x0c002800, 0x00000000, 0x4c00ff00 },
+    { 0x21006e00, 0x00000000, 0x00000000, 0x4c00ff00, 0x00000000,
+     0x00000000, 0x21006e00, 0x4c00ff00, 0x00000000, 0x0c002800,
+     0x00000000, 0x4c00ff00, 0x21006e00, 0x0c002800, 0x00000000,
+     0x4c00ff00, 0x00000000, 0x0c002800, 0x21006e00, 0x00000000,
+     0x00000000, 0x0c002800, 0x00000000, 0x00000000, 0x21006e00 },
+    { 0x00000000, 0x00000000, 0x4c00ff00, 0x21006e00, 0x00000000,
+     0x00000000, 0x0c002800, 0x21006e00, 0x4c00ff00, 0x00000000,
+     0x00000000, 0x21006e00, 0x0c002800, 0x00000000, 0x4c00ff00,
+     0x21006e00, 0x00000000, 0x00000000, 0x0c002800, 0x00000000,
+     0x4c00ff00, 0x00000000, 0x00000000, 0x00000000, 0x0c002800 },
+    { 0x00000000, 0x4c00ff00, 0x21006e00, 0x00000000, 0x00000000,
+     0x4c00ff00, 0x00000000, 0x0c002800, 0x21006e00, 0x00000000,
+     0x00000000, 0x0c002800, 0x00000000, 0x00000000, 0x21006e00,
+     0x0c002800, 0x00000000, 0x00000000, 0x00000000, 0x4c00ff00,
+     0x21006e00, 0x00000000, 0x00000000, 0x4c00ff00, 0x00000000 },
+    { 0x00000000, 0x21006e00, 0x00000000, 0x00000000, 0x4c00ff00,
+     0x21006e00, 0x00000000, 0x00000000, 0x0c002800, 0x00000000,
+     0x4c00ff00, 0x00000000, 0x00000000, 0x00000000, 0x0c002800,
+     0x00000000, 0x4c00ff00, 0x00000000, 0x00000000, 0x21006e00,
+     0x0c002800, 0x00000000, 0x4c00ff00, 0x21006e00, 0x00000000 },
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x21006e00,
+     0x0c002800, 0x00000000, 0x00000000, 0x00000000, 0x4c00ff00,
+     0x21006e00, 0x00000000, 0x00000000, 0x4c00ff00, 0x00000000,
+     0x00000000, 0x21006e00, 0x4c00ff00, 0x00000000, 0x0c002800,
+     0x00000000, 0x4c00ff00, 0x21006e00, 0x0c002800, 0x00000000 },
+};
+static const AnimacaoPronta animacao_pronta_chuva = {
+    .nome = "chuva",
+    .quadros = chuva_quadros,
+    .num_quadros = 6,
+    .fps = 10,
+    .tons = NULL,
+};
+
+// arco_iris: 8 quadros a 8 fps, 800 bytes
+static const uint32_t arco_iris_quadros[8][NUM_PIXELS] = {
+    { 0x00660000, 0x00664d00, 0x00336600, 0x1a006600, 0x66006600,
+     0x66001a00, 0x66006600, 0x1a006600, 0x00336600, 0x00664d00,
+     0x00336600, 0x1a006600, 0x66006600, 0x66001a00, 0x66330000,
+     0x4d660000, 0x66330000, 0x66001a00, 0x66006600, 0x1a006600,
+     0x66006600, 0x66001a00, 0x66330000, 0x4d660000, 0x00660000 },
+    { 0x4d660000, 0x00660000, 0x00664d00, 0x00336600, 0x1a006600,
+     0x66006600, 0x1a006600, 0x00336600, 0x00664d00, 0x00660000,
+     0x00664d00, 0x00336600, 0x1a006600, 0x66006600, 0x66001a00,
+     0x66330000, 0x66001a00, 0x66006600, 0x1a006600, 0x00336600,
+     0x1a006600, 0x66006600, 0x66001a00, 0x66330000, 0x4d660000 },
+    { 0x66330000, 0x4d660000, 0x00660000, 0x00664d00, 0x00336600,
+     0x1a006600, 0x00336600, 0x00664d00, 0x00660000, 0x4d660000,
+     0x00660000, 0x00664d00, 0x00336600, 0x1a006600, 0x66006600,
+     0x66001a00, 0x66006600, 0x1a006600, 0x00336600, 0x00664d00,
+     0x00336600, 0x1a006600, 0x66006600, 0x66001a00, 0x66330000 },
+    { 0x66001a00, 0x66330000, 0x4d660000, 0x00660000, 0x00664d00,
+     0x00336600, 0x00664d00, 0x00660000, 0x4d660000, 0x66330000,
+     0x4d660000, 0x00660000, 0x00664d00, 0x00336600, 0x1a006600,
+     0x66006600, 0x1a006600, 0x00336600, 0x00664d00, 0x00660000,
+     0x00664d00, 0x00336600, 0x1a006600, 0x66006600, 0x66001a00 },
+    { 0x66006600, 0x66001a00, 0x66330000, 0x4d660000, 0x00660000,
+     0x00664d00, 0x00660000, 0x4d660000, 0x66330000, 0x66001a00,
+     0x66330000, 0x4d660000, 0x00660000, 0x00664d00, 0x00336600,
+     0x1a006600, 0x00336600, 0x00664d00, 0x00660000, 0x4d660000,
+     0x00660000, 0x00664d00, 0x00336600, 0x1a006600, 0x66006600 },
+    { 0x1a006600, 0x66006600, 0x66001a00, 0x66330000, 0x4d660000,
+     0x00660000, 0x4d660000, 0x66330000, 0x66001a00, 0x66006600,
+     0x66001a00, 0x66330000, 0x4d660000, 0x00660000, 0x00664d00,
+     0x00336600, 0x00664d00, 0x00660000, 0x4d660000, 0x66330000,
+     0x4d660000, 0x00660000, 0x00664d00, 0x00336600, 0x1a006600 },
+    { 0x00336600, 0x1a006600, 0x66006600, 0x66001a00, 0x66330000,
+     0x4d660000, 0x66330000, 0x66001a00, 0x66006600, 0x1a006600,
+     0x66006600, 0x66001a00, 0x66330000, 0x4d660000, 0x00660000,
+     0x00664d00, 0x00660000, 0x4d660000, 0x66330000, 0x66001a00,
+     0x66330000, 0x4d660000, 0x00660000, 0x00664d00, 0x00336600 },
+    { 0x00664d00, 0x00336600, 0x1a006600, 0x66006600, 0x66001a00,
+     0x66330000, 0x66001a00, 0x66006600, 0x1a006600, 0x00336600,
+     0x1a006600, 0x66006600, 0x66001a00, 0x66330000, 0x4d660000,
+     0x00660000, 0x4d660000, 0x66330000, 0x66001a00, 0x66006600,
+     0x66001a00, 0x66330000, 0x4d660000, 0x00660000, 0x00664d00 },
+};
+static const uint16_t arco_iris_tons[8][2] = {
+    { 880, 20 }, { 880, 20 }, { 880, 20 }, { 880, 20 }, { 880, 20 }, { 880, 20 },
+    { 880, 20 }, { 880, 20 },
+};
+static const AnimacaoPronta animacao_pronta_arco_iris = {
+    .nome = "arco_iris",
+    .quadros = arco_iris_quadros,
+    .num_quadros = 8,
+    .fps = 8,
+    .tons = arco_iris_tons,
+};
@@ -71,3 +71,173 @@ static inline void matriz_led_program_init(PIO pio, uint sm, uint offset, uint p
 
 #endif
 
+// ------------------- //
+// matriz_led_paralelo //
+// ------------------- //
+
+#define matriz_led_paralelo_wrap_target 0
+#define matriz_led_paralelo_wrap 3
+#define matriz_led_paralelo_pio_version 0
+
+static const uint16_t matriz_led_paralelo_program_instructions[] = {
+            //     .wrap_target
+    0x6028, //  0: out    x, 8                       
+    0xa20b, //  1: mov    pins, !null            [2] 
+    0xa201, //  2: mov    pins, x                [2] 
+    0xa203, //  3: mov    pins, null             [2] 
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program matriz_led_paralelo_program = {
+    .instructions = matriz_led_paralelo_program_instructions,
+    .length = 4,
+    .origin = -1,
+    .pio_version = matriz_led_paralelo_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config matriz_led_paralelo_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + matriz_led_paralelo_wrap_target, offset + matriz_led_paralelo_wrap);
+    return c;
+}
+
+static inline void matriz_led_paralelo_program_init(PIO pio, uint sm, uint offset, uint pin_base, uint pin_count)
+{
+    pio_sm_config c = matriz_led_paralelo_program_get_default_config(offset);
+    // The strips are written together by mov pins, i.e. the out pin group
+    sm_config_set_out_pins(&c, pin_base, pin_count);
+    for (uint i = 0; i < pin_count; i++) {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, sm, pin_base, pin_count, true);
+    // Same 8MHz clock as the serial program: 10 cycles per bit
+    float div = clock_get_hz(clk_sys) / 8000000.0;
+    sm_config_set_clkdiv(&c, div);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+    // Shift to the left, autopull every 32 bits (4 bit slots per word)
+    sm_config_set_out_shift(&c, false, true, 32);
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+#endif
+
+
+// -------------- //
+// ws2812_sideset //
+// -------------- //
+
+#define ws2812_sideset_wrap_target 0
+#define ws2812_sideset_wrap 3
+#define ws2812_sideset_pio_version 0
+
+#define ws2812_sideset_T1 2
+#define ws2812_sideset_T2 5
+#define ws2812_sideset_T3 3
+
+static const uint16_t ws2812_sideset_program_instructions[] = {
+            //     .wrap_target
+    0x6221, //  0: out    x, 1            side 0 [2] 
+    0x1123, //  1: jmp    !x, 3           side 1 [1] 
+    0x1400, //  2: jmp    0               side 1 [4] 
+    0xa442, //  3: nop                    side 0 [4] 
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program ws2812_sideset_program = {
+    .instructions = ws2812_sideset_program_instructions,
+    .length = 4,
+    .origin = -1,
+    .pio_version = ws2812_sideset_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config ws2812_sideset_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + ws2812_sideset_wrap_target, offset + ws2812_sideset_wrap);
+    sm_config_set_sideset(&c, 1, false, false);
+    return c;
+}
+
+// Cycles of each bit phase and the PIO clock divider that produce them
+typedef struct {
+    uint t1, t2, t3;
+    float clkdiv;
+} ws2812_sideset_timing;
+
+// Delay field of this program: 4 bits, since side-set takes the 5th
+#define WS2812_SIDESET_MAX_DELAY 16
+
+// Finds the smallest integer clock divider (no fractional jitter) whose cycle
+// fits T0H, T1H - T0H and period - T1H (in ns) in the delay fields, rounding each
+// phase to the nearest cycle. Returns false if no divider fits.
+static inline bool ws2812_sideset_timing_from_ns(uint t0h_ns, uint t1h_ns, uint period_ns, ws2812_sideset_timing *t)
+{
+    if (t0h_ns == 0 || t1h_ns <= t0h_ns || period_ns <= t1h_ns) {
+        return false;
+    }
+    uint64_t hz = clock_get_hz(clk_sys);
+    for (uint div = 1; div <= 0xFFFF; div++) {
+        // Cycle length in ps, so the rounding stays exact at 125 MHz
+        uint64_t cycle_ps = div * 1000000000000ull / hz;
+        uint t1 = (uint)((t0h_ns * 1000ull + cycle_ps / 2) / cycle_ps);
+        uint t12 = (uint)((t1h_ns * 1000ull + cycle_ps / 2) / cycle_ps);
+        uint total = (uint)((period_ns * 1000ull + cycle_ps / 2) / cycle_ps);
+        if (t1 > WS2812_SIDESET_MAX_DELAY) {
+            continue; // Cycle too short: try a slower clock
+        }
+        if (t1 == 0 || t12 <= t1 || total <= t12) {
+            return false; // Cycle too long to resolve the phases
+        }
+        if (t12 - t1 <= WS2812_SIDESET_MAX_DELAY && total - t12 <= WS2812_SIDESET_MAX_DELAY) {
+            t->t1 = t1;
+            t->t2 = t12 - t1;
+            t->t3 = total - t12;
+            t->clkdiv = (float)div;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Copies the program into `instructions` (length entries) with the delays of `t`
+static inline struct pio_program ws2812_sideset_program_with_timing(const ws2812_sideset_timing *t, uint16_t *instructions)
+{
+    static const uint8_t phase[] = { 3, 1, 2, 2 }; // T3, T1, T2, T2
+    for (uint i = 0; i < ws2812_sideset_program.length; i++) {
+        uint delay = phase[i] == 1 ? t->t1 : phase[i] == 2 ? t->t2 : t->t3;
+        instructions[i] = (ws2812_sideset_program_instructions[i] & ~0x0F00) | ((delay - 1) << 8);
+    }
+    struct pio_program p = ws2812_sideset_program;
+    p.instructions = instructions;
+    return p;
+}
+
+static inline void ws2812_sideset_program_init(PIO pio, uint sm, uint offset, uint pin, float clkdiv, uint bits_per_pixel)
+{
+    pio_sm_config c = ws2812_sideset_program_get_default_config(offset);
+
+    // The data line is driven only by side-set
+    sm_config_set_sideset_pins(&c, pin);
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+
+    sm_config_set_clkdiv(&c, clkdiv);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+
+    // Shift to the left, autopull every pixel: 24 bits for GRB, 32 for GRBW
+    sm_config_set_out_shift(&c, false, true, bits_per_pixel);
+
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+#endif
+
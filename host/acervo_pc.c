@@ -0,0 +1,122 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include "acervo_pc.h"
+#include "acervo.h"
+#include "fluxo_pc.h"
+#include "raster.h"
+
+#define ESPERA_INICIO_MS 3000
+#define ESPERA_GRAVACAO_MS 5000     // Apagar setores e copiar registros vivos leva um tempo
+
+int acervo_ler_grade(const char *caminho, uint8_t (*quadros)[BYTES_POR_QUADRO], int max_quadros) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        perror(caminho);
+        return -1;
+    }
+
+    char texto[256];
+    int numero = 0, linhas = 0;
+    while (fgets(texto, sizeof(texto), f)) {
+        numero++;
+        texto[strcspn(texto, "\r\n")] = '\0';
+        if (texto[0] == '\0' || texto[0] == '#') {
+            continue;
+        }
+        if ((int)strlen(texto) != MATRIZ_LARGURA) {
+            fprintf(stderr, "%s:%d: a linha tem que ter %d pixels\n", caminho, numero, MATRIZ_LARGURA);
+            fclose(f);
+            return -1;
+        }
+        int q = linhas / MATRIZ_ALTURA, y = linhas % MATRIZ_ALTURA;
+        if (q == max_quadros) {
+            fprintf(stderr, "%s: mais de %d quadros\n", caminho, max_quadros);
+            fclose(f);
+            return -1;
+        }
+        if (y == 0) {
+            memset(quadros[q], 0, BYTES_POR_QUADRO);
+        }
+        for (int x = 0; x < MATRIZ_LARGURA; x++) {
+            int c = (unsigned char)texto[x], nivel;
+            if (c == '.') {
+                nivel = 0;
+            } else if (isxdigit(c)) {
+                nivel = isdigit(c) ? c - '0' : toupper(c) - 'A' + 10;
+            } else {
+                fprintf(stderr, "%s:%d: pixel '%c' invalido\n", caminho, numero, c);
+                fclose(f);
+                return -1;
+            }
+            // Pixel par no nibble baixo, na ordem em que os quadros são escritos
+            uint i = raster_indice_autoria((uint)x, (uint)y);
+            quadros[q][i / 2] |= (uint8_t)(nivel << ((i & 1) * 4));
+        }
+        linhas++;
+    }
+    fclose(f);
+
+    if (linhas % MATRIZ_ALTURA) {
+        fprintf(stderr, "%s: o ultimo quadro tem %d de %d linhas\n", caminho, linhas % MATRIZ_ALTURA, MATRIZ_ALTURA);
+        return -1;
+    }
+    return linhas / MATRIZ_ALTURA;
+}
+
+size_t acervo_montar_registro(uint8_t *buf, uint8_t id, uint8_t fps, uint8_t r, uint8_t g, uint8_t b,
+                              const uint8_t (*quadros)[BYTES_POR_QUADRO], uint16_t num_quadros) {
+    uint8_t *p = buf;
+    *p++ = FLUXO_SINC0;
+    *p++ = FLUXO_SINC1;
+    *p++ = id;
+    *p++ = fps;
+    *p++ = num_quadros & 0xFF;
+    *p++ = num_quadros >> 8;
+    *p++ = r;
+    *p++ = g;
+    *p++ = b;
+    memcpy(p, quadros, (size_t)num_quadros * BYTES_POR_QUADRO);
+    p += (size_t)num_quadros * BYTES_POR_QUADRO;
+    uint16_t crc = fluxo_crc16(FLUXO_CRC_INICIAL, buf + 2, (uint)(p - buf - 2));
+    *p++ = crc & 0xFF;
+    *p++ = crc >> 8;
+    return (size_t)(p - buf);
+}
+
+bool acervo_enviar(int fd, uint8_t id, uint8_t fps, uint8_t r, uint8_t g, uint8_t b,
+                   const uint8_t (*quadros)[BYTES_POR_QUADRO], uint16_t num_quadros) {
+    tcflush(fd, TCIFLUSH);
+
+    uint8_t dados[3];
+    uint8_t abrir = 'u';
+    fluxo_escrever_tudo(fd, &abrir, 1);
+    if (fluxo_ler_resposta(fd, dados, sizeof(dados), ESPERA_INICIO_MS) != FLUXO_INICIO) {
+        fprintf(stderr, "acervo: o Pico nao abriu a sessao\n");
+        return false;
+    }
+    uint max_ids = dados[0], max_quadros = dados[1] | (dados[2] << 8);
+    if (id >= max_ids || num_quadros > max_quadros) {
+        fprintf(stderr, "acervo: o Pico aceita ids de 0 a %u e ate %u quadros\n", max_ids - 1, max_quadros);
+        return false;
+    }
+
+    size_t tamanho = ACERVO_CABECALHO_USB + 2 + (size_t)num_quadros * BYTES_POR_QUADRO + FLUXO_RODAPE;
+    uint8_t *buf = malloc(tamanho);
+    size_t n = acervo_montar_registro(buf, id, fps, r, g, b, quadros, num_quadros);
+    bool ok = fluxo_escrever_tudo(fd, buf, n);
+    free(buf);
+    if (!ok) {
+        perror("acervo");
+        return false;
+    }
+
+    int tipo = fluxo_ler_resposta(fd, dados, sizeof(dados), ESPERA_GRAVACAO_MS);
+    if (tipo != ACERVO_GRAVADO) {
+        fprintf(stderr, "acervo: %s\n", tipo ? "o Pico recusou o registro" : "sem resposta");
+        return false;
+    }
+    return true;
+}
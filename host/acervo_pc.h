@@ -0,0 +1,26 @@
+#ifndef ACERVO_PC_H
+#define ACERVO_PC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "animacao.h"
+
+// Lado do PC do acervo (acervo.h): lê uma grade de texto e grava a animação na
+// flash do Pico pelo USB ('u').
+
+// Grade de texto como as de animacoes/ (ex.: coracao.txt): MATRIZ_ALTURA linhas de
+// MATRIZ_LARGURA níveis em hexadecimal ('.' = 0) por quadro; linhas vazias e '#'
+// são ignoradas. Retorna quantos quadros leu (na ordem de QUADRO) ou -1 em erro.
+int acervo_ler_grade(const char *caminho, uint8_t (*quadros)[BYTES_POR_QUADRO], int max_quadros);
+
+// Registro do protocolo de acervo.h (A5 5A ... crc) em buf; retorna o tamanho
+size_t acervo_montar_registro(uint8_t *buf, uint8_t id, uint8_t fps, uint8_t r, uint8_t g, uint8_t b,
+                              const uint8_t (*quadros)[BYTES_POR_QUADRO], uint16_t num_quadros);
+
+// Abre a sessão ('u'), manda o registro e espera a resposta. Retorna false se o
+// Pico não responder ou recusar o registro.
+bool acervo_enviar(int fd, uint8_t id, uint8_t fps, uint8_t r, uint8_t g, uint8_t b,
+                   const uint8_t (*quadros)[BYTES_POR_QUADRO], uint16_t num_quadros);
+
+#endif
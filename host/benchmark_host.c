@@ -0,0 +1,112 @@
+// Mede o firmware simulado tecla por tecla: cada tecla roda por um trecho fixo de
+// tempo virtual e, para cada trecho, mostra quadros por segundo (virtuais),
+// palavras por quadro e tempo de CPU do PC por quadro. O atraso dos quadros não
+// aparece: no relógio virtual o firmware nunca perde um prazo.
+//
+//   benchmark_host [teclas] [ms_por_tecla]
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "simulacao.h"
+
+#define TECLAS_PADRAO "0123456789ABCD#EFGHI"
+#define TRECHO_PADRAO_MS 3000
+// A primeira tecla é pressionada depois da inicialização
+#define INICIO_MS 100
+#define DURACAO_TECLA_MS 60
+
+typedef struct {
+    char tecla;
+    uint32_t quadros;
+    uint64_t palavras;
+    uint64_t primeiro_us;   // Tempo virtual do primeiro e do último quadro
+    uint64_t ultimo_us;
+    double cpu_s;
+} Trecho;
+
+static Trecho trechos[64];
+static int num_trechos = 0;
+static int atual = -1;
+static double cpu_inicio = 0;
+
+static double cpu_agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void fechar_trecho(void) {
+    if (atual < 0) {
+        return;
+    }
+    trechos[atual].cpu_s = cpu_agora() - cpu_inicio;
+}
+
+static void ao_quadro(uint64_t tempo_us, uint pio, uint sm, const uint32_t *dados, uint num_palavras) {
+    if (atual >= 0) {
+        Trecho *tr = &trechos[atual];
+        if (tr->quadros++ == 0) {
+            tr->primeiro_us = tempo_us;
+        }
+        tr->ultimo_us = tempo_us;
+        tr->palavras += num_palavras;
+    }
+}
+
+// O trecho de uma tecla começa quando ela é pressionada (o firmware ainda leva o
+// tempo do debounce para reagir, que entra no trecho)
+static void ao_evento_tecla(uint64_t tempo_us, char tecla, bool pressionada) {
+    if (!pressionada) {
+        return;
+    }
+    fechar_trecho();
+    atual = num_trechos++;
+    trechos[atual] = (Trecho) { .tecla = tecla };
+    cpu_inicio = cpu_agora();
+}
+
+int main(int argc, char **argv) {
+    const char *teclas = argc > 1 ? argv[1] : TECLAS_PADRAO;
+    uint32_t trecho_ms = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : TRECHO_PADRAO_MS;
+    if (strlen(teclas) > count_of(trechos) || trecho_ms == 0) {
+        fprintf(stderr, "uso: %s [teclas (max %zu)] [ms_por_tecla]\n", argv[0], count_of(trechos));
+        return 1;
+    }
+
+    // Teclas do teclado matricial passam pelo debounce; as outras vão pelo USB
+    uint64_t t = INICIO_MS * 1000ull;
+    for (const char *c = teclas; *c; c++) {
+        if (strchr("0123456789ABCD#", *c)) {
+            sim_tecla(t, *c, DURACAO_TECLA_MS);
+        } else {
+            sim_usb(t, *c);
+        }
+        t += trecho_ms * 1000ull;
+    }
+    sim_fim(t);
+
+    sim_iniciar(NULL);
+    sim_observar_quadros(ao_quadro);
+    sim_observar_teclas(ao_evento_tecla);
+
+    // A saída do firmware (mensagens de cada tecla) não interessa aqui
+    FILE *saida = freopen("/dev/null", "w", stdout);
+    sim_executar(firmware_main);
+    fechar_trecho();
+    if (saida) {
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "Tecla  quadros/s  palavras/quadro  CPU do PC/quadro (us)\n");
+    for (int i = 0; i < num_trechos; i++) {
+        const Trecho *tr = &trechos[i];
+        // Do primeiro ao último quadro: o debounce e as pausas no fim da
+        // animação não entram na taxa
+        double fps = tr->quadros > 1 && tr->ultimo_us > tr->primeiro_us
+                   ? (tr->quadros - 1) * 1e6 / (tr->ultimo_us - tr->primeiro_us) : 0;
+        double cpu_quadro = tr->quadros ? tr->cpu_s * 1e6 / tr->quadros : 0;
+        fprintf(stderr, "  %c    %8.1f  %15.1f  %21.2f\n", tr->tecla, fps,
+                tr->quadros ? (double)tr->palavras / tr->quadros : 0.0, cpu_quadro);
+    }
+    return 0;
+}
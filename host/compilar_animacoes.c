@@ -0,0 +1,414 @@
+// Compilador de animações: lê um manifesto e as imagens que ele cita e gera um
+// header C com os quadros já em palavras GRB (as mesmas de cores.h), prontos para
+// ir da flash para a saída. Roda no PC durante o build, como o pioasm.
+//
+//   compilar_animacoes <manifesto> <header de saída>
+//
+// Manifesto (um comando por linha, '#' começa comentário; caminhos relativos ao
+// manifesto):
+//   animacao <nome>              começa uma animação (identificador C)
+//   imagem <arquivo>             .ppm (cor), .pgm (intensidade) ou .txt (grade)
+//   fps <n>
+//   cor <r> <g> <b>              0.0-1.0; tinge .pgm e .txt (padrão branco)
+//   tom <Hz> <ms>                toca em todos os quadros
+//   tom_quadro <q> <Hz> <ms>     toca só no quadro q (sobrepõe o tom geral)
+//
+// Imagens: folha de sprites com quadros de MATRIZ_LARGURA x MATRIZ_ALTURA lidos
+// da esquerda para a direita e de cima para baixo. PPM/PGM em ASCII (P3/P2) ou
+// binário (P6/P5). Grade de texto: MATRIZ_ALTURA linhas de MATRIZ_LARGURA
+// caracteres por quadro, um dígito hexadecimal (0-F, nível de 0 a 15) ou '.'
+// (apagado) por pixel, com uma linha em branco entre quadros.
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cores.h"
+#include "raster.h"
+#include "saida_led.h"
+
+#define MAX_ANIMACOES 32
+#define MAX_QUADROS 256
+#define MAX_NOME 48
+#define MAX_CAMINHO 512
+
+typedef struct {
+    char nome[MAX_NOME];
+    char imagem[MAX_CAMINHO];
+    int fps;
+    uint16_t r, g, b;
+    uint16_t tom[2];
+    uint16_t tons[MAX_QUADROS][2];
+    bool tem_tom_quadro[MAX_QUADROS];
+    uint32_t quadros[MAX_QUADROS][NUM_PIXELS];
+    int num_quadros;
+    int linha;  // Linha do manifesto, para as mensagens de erro
+} Animacao;
+
+static Animacao animacoes[MAX_ANIMACOES];
+static int num_animacoes = 0;
+static const char *manifesto;
+
+static void erro(int linha, const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    fprintf(stderr, "%s:%d: ", manifesto, linha);
+    vfprintf(stderr, formato, args);
+    fputc('\n', stderr);
+    va_end(args);
+    exit(1);
+}
+
+static uint16_t componente(int linha, const char *texto) {
+    char *fim;
+    double v = strtod(texto, &fim);
+    if (*fim || v < 0.0 || v > 1.0) {
+        erro(linha, "componente de cor '%s' fora de 0.0-1.0", texto);
+    }
+    return COR_FX(v);
+}
+
+// ---------------------------------------------------------------------------
+// Imagens
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int largura, altura;
+    bool colorida;
+    uint8_t *pixels;    // 3 bytes (RGB) ou 1 (cinza) por pixel, já em 0..255
+} Imagem;
+
+static int ler_inteiro_pnm(FILE *f) {
+    int c;
+    do {
+        c = fgetc(f);
+        if (c == '#') {
+            while (c != '\n' && c != EOF) {
+                c = fgetc(f);
+            }
+        }
+    } while (c != EOF && isspace(c));
+    int v = 0;
+    bool algum = false;
+    while (c != EOF && isdigit(c)) {
+        v = v * 10 + (c - '0');
+        algum = true;
+        c = fgetc(f);
+    }
+    return algum ? v : -1;
+}
+
+static bool ler_pnm(const char *caminho, Imagem *img) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) {
+        return false;
+    }
+    char magico[3] = {0};
+    if (fread(magico, 1, 2, f) != 2 || magico[0] != 'P' || !strchr("2356", magico[1])) {
+        fclose(f);
+        return false;
+    }
+    bool binario = magico[1] == '5' || magico[1] == '6';
+    img->colorida = magico[1] == '3' || magico[1] == '6';
+    img->largura = ler_inteiro_pnm(f);
+    img->altura = ler_inteiro_pnm(f);
+    int maximo = ler_inteiro_pnm(f);
+    if (img->largura <= 0 || img->altura <= 0 || maximo <= 0 || maximo > 255) {
+        fclose(f);
+        return false;
+    }
+
+    int canais = img->colorida ? 3 : 1;
+    size_t n = (size_t)img->largura * img->altura * canais;
+    img->pixels = malloc(n);
+    for (size_t i = 0; i < n; i++) {
+        int v = binario ? fgetc(f) : ler_inteiro_pnm(f);
+        if (v < 0) {
+            fclose(f);
+            return false;
+        }
+        img->pixels[i] = (uint8_t)((v * 255 + maximo / 2) / maximo);
+    }
+    fclose(f);
+    return true;
+}
+
+// Grade de texto: cada quadro vira uma faixa da imagem, um embaixo do outro, com
+// os níveis 0..15 levados para 0..255
+static bool ler_grade(const char *caminho, Imagem *img, int linha_manifesto) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        return false;
+    }
+    img->largura = MATRIZ_LARGURA;
+    img->altura = 0;
+    img->colorida = false;
+    img->pixels = malloc((size_t)MAX_QUADROS * MATRIZ_ALTURA * MATRIZ_LARGURA);
+
+    char texto[256];
+    int numero = 0;
+    while (fgets(texto, sizeof(texto), f)) {
+        numero++;
+        texto[strcspn(texto, "\r\n")] = '\0';
+        if (texto[0] == '\0' || texto[0] == '#') {
+            continue;
+        }
+        if ((int)strlen(texto) != MATRIZ_LARGURA) {
+            erro(linha_manifesto, "%s:%d: a linha tem que ter %d pixels", caminho, numero, MATRIZ_LARGURA);
+        }
+        if (img->altura == MAX_QUADROS * MATRIZ_ALTURA) {
+            erro(linha_manifesto, "%s: mais de %d quadros", caminho, MAX_QUADROS);
+        }
+        for (int x = 0; x < MATRIZ_LARGURA; x++) {
+            int nivel;
+            if (texto[x] == '.') {
+                nivel = 0;
+            } else if (isxdigit((unsigned char)texto[x])) {
+                nivel = isdigit((unsigned char)texto[x]) ? texto[x] - '0' : toupper((unsigned char)texto[x]) - 'A' + 10;
+            } else {
+                erro(linha_manifesto, "%s:%d: pixel '%c' invalido", caminho, numero, texto[x]);
+            }
+            img->pixels[img->altura * MATRIZ_LARGURA + x] = (uint8_t)(nivel * 255 / NIVEIS_INTENSIDADE);
+        }
+        img->altura++;
+    }
+    fclose(f);
+    return true;
+}
+
+// Recorta os quadros da folha de sprites e converte cada pixel para a palavra
+// GRB na posição da cadeia de LEDs
+static void converter(Animacao *a, const Imagem *img) {
+    if (img->largura % MATRIZ_LARGURA || img->altura % MATRIZ_ALTURA) {
+        erro(a->linha, "%s: %dx%d nao e multiplo de %dx%d", a->imagem, img->largura, img->altura,
+             MATRIZ_LARGURA, MATRIZ_ALTURA);
+    }
+    int colunas = img->largura / MATRIZ_LARGURA;
+    int linhas = img->altura / MATRIZ_ALTURA;
+    if (colunas * linhas > MAX_QUADROS) {
+        erro(a->linha, "%s: mais de %d quadros", a->imagem, MAX_QUADROS);
+    }
+
+    uint32_t tabela[NIVEIS_INTENSIDADE + 1];
+    tabela_niveis(tabela, a->r, a->g, a->b);
+
+    a->num_quadros = 0;
+    for (int lq = 0; lq < linhas; lq++) {
+        for (int cq = 0; cq < colunas; cq++) {
+            uint32_t *quadro = a->quadros[a->num_quadros++];
+            for (int y = 0; y < MATRIZ_ALTURA; y++) {
+                for (int x = 0; x < MATRIZ_LARGURA; x++) {
+                    size_t p = (size_t)(lq * MATRIZ_ALTURA + y) * img->largura + cq * MATRIZ_LARGURA + x;
+                    uint32_t grb;
+                    if (img->colorida) {
+                        const uint8_t *rgb = &img->pixels[p * 3];
+                        grb = matrix_rgb(rgb[2], rgb[0], rgb[1]);
+                    } else if (strstr(a->imagem, ".txt")) {
+                        // Mesma conversão das animações de matriz_led.c: nível 0..15 pela tabela
+                        grb = tabela[img->pixels[p] * NIVEIS_INTENSIDADE / 255];
+                    } else {
+                        grb = cor_escalada(a->r, a->g, a->b, img->pixels[p]);
+                    }
+                    quadro[raster_indice(x, y)] = grb; // Na ordem da cadeia do painel (MATRIZ_PAINEL)
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Manifesto
+// ---------------------------------------------------------------------------
+
+static bool identificador_valido(const char *s) {
+    if (!isalpha((unsigned char)*s) && *s != '_') {
+        return false;
+    }
+    for (; *s; s++) {
+        if (!isalnum((unsigned char)*s) && *s != '_') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void ler_manifesto(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        fprintf(stderr, "%s: nao foi possivel abrir\n", caminho);
+        exit(1);
+    }
+
+    // Diretório do manifesto, para os caminhos das imagens
+    char diretorio[MAX_CAMINHO];
+    snprintf(diretorio, sizeof(diretorio), "%s", caminho);
+    char *barra = strrchr(diretorio, '/');
+    if (barra) {
+        barra[1] = '\0';
+    } else {
+        diretorio[0] = '\0';
+    }
+
+    char texto[256];
+    int numero = 0;
+    Animacao *a = NULL;
+    while (fgets(texto, sizeof(texto), f)) {
+        numero++;
+        char *comentario = strchr(texto, '#');
+        if (comentario) {
+            *comentario = '\0';
+        }
+
+        char *campos[5];
+        int n = 0;
+        for (char *t = strtok(texto, " \t\r\n"); t && n < 5; t = strtok(NULL, " \t\r\n")) {
+            campos[n++] = t;
+        }
+        if (n == 0) {
+            continue;
+        }
+
+        if (strcmp(campos[0], "animacao") == 0 && n == 2) {
+            if (num_animacoes == MAX_ANIMACOES) {
+                erro(numero, "mais de %d animacoes", MAX_ANIMACOES);
+            }
+            if (!identificador_valido(campos[1]) || strlen(campos[1]) >= MAX_NOME) {
+                erro(numero, "nome '%s' invalido", campos[1]);
+            }
+            a = &animacoes[num_animacoes++];
+            *a = (Animacao) { .fps = 5, .r = COR_FX(1.0), .g = COR_FX(1.0), .b = COR_FX(1.0), .linha = numero };
+            snprintf(a->nome, sizeof(a->nome), "%s", campos[1]);
+            continue;
+        }
+        if (!a) {
+            erro(numero, "'%s' antes de 'animacao'", campos[0]);
+        }
+
+        if (strcmp(campos[0], "imagem") == 0 && n == 2) {
+            snprintf(a->imagem, sizeof(a->imagem), "%s%s", diretorio, campos[1]);
+        } else if (strcmp(campos[0], "fps") == 0 && n == 2) {
+            a->fps = atoi(campos[1]);
+            if (a->fps <= 0 || a->fps > 1000) {
+                erro(numero, "fps %s invalido", campos[1]);
+            }
+        } else if (strcmp(campos[0], "cor") == 0 && n == 4) {
+            a->r = componente(numero, campos[1]);
+            a->g = componente(numero, campos[2]);
+            a->b = componente(numero, campos[3]);
+        } else if (strcmp(campos[0], "tom") == 0 && n == 3) {
+            a->tom[0] = (uint16_t)atoi(campos[1]);
+            a->tom[1] = (uint16_t)atoi(campos[2]);
+        } else if (strcmp(campos[0], "tom_quadro") == 0 && n == 4) {
+            int q = atoi(campos[1]);
+            if (q < 0 || q >= MAX_QUADROS) {
+                erro(numero, "quadro %s invalido", campos[1]);
+            }
+            a->tons[q][0] = (uint16_t)atoi(campos[2]);
+            a->tons[q][1] = (uint16_t)atoi(campos[3]);
+            a->tem_tom_quadro[q] = true;
+        } else {
+            erro(numero, "comando invalido: %s", campos[0]);
+        }
+    }
+    fclose(f);
+
+    for (int i = 0; i < num_animacoes; i++) {
+        a = &animacoes[i];
+        if (!a->imagem[0]) {
+            erro(a->linha, "%s: falta a imagem", a->nome);
+        }
+        Imagem img;
+        bool ok = strstr(a->imagem, ".txt") ? ler_grade(a->imagem, &img, a->linha) : ler_pnm(a->imagem, &img);
+        if (!ok) {
+            erro(a->linha, "%s: imagem ilegivel", a->imagem);
+        }
+        converter(a, &img);
+        free(img.pixels);
+        for (int q = 0; q < MAX_QUADROS; q++) {
+            if (a->tem_tom_quadro[q] && q >= a->num_quadros) {
+                erro(a->linha, "%s: tom_quadro %d alem do ultimo quadro", a->nome, q);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Header
+// ---------------------------------------------------------------------------
+
+static bool tem_som(const Animacao *a) {
+    if (a->tom[0]) {
+        return true;
+    }
+    for (int q = 0; q < a->num_quadros; q++) {
+        if (a->tem_tom_quadro[q] && a->tons[q][0]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void gerar(FILE *f, const char *origem) {
+    fprintf(f, "// -------------------------------------------------------------- //\n");
+    fprintf(f, "// Gerado por compilar_animacoes a partir de %s; nao edite!\n", origem);
+    fprintf(f, "// -------------------------------------------------------------- //\n\n");
+    fprintf(f, "#pragma once\n\n#include \"quadros_prontos.h\"\n#include \"raster.h\"\n\n");
+    fprintf(f, "_Static_assert(NUM_PIXELS == %d, \"quadros gerados para %dx%d\");\n",
+            NUM_PIXELS, MATRIZ_LARGURA, MATRIZ_ALTURA);
+    fprintf(f, "_Static_assert(MATRIZ_PAINEL == %d, \"quadros gerados para outro layout de painel\");\n",
+            MATRIZ_PAINEL);
+
+    for (int i = 0; i < num_animacoes; i++) {
+        const Animacao *a = &animacoes[i];
+        fprintf(f, "\n// %s: %d quadros a %d fps, %zu bytes\n", a->nome, a->num_quadros, a->fps,
+                (size_t)a->num_quadros * NUM_PIXELS * sizeof(uint32_t));
+        fprintf(f, "static const uint32_t %s_quadros[%d][NUM_PIXELS] = {\n", a->nome, a->num_quadros);
+        for (int q = 0; q < a->num_quadros; q++) {
+            fprintf(f, "    {");
+            for (int p = 0; p < NUM_PIXELS; p++) {
+                fprintf(f, "%s0x%08lx", (p % 5) ? ", " : (p ? ",\n     " : " "), (unsigned long)a->quadros[q][p]);
+            }
+            fprintf(f, " },\n");
+        }
+        fprintf(f, "};\n");
+
+        bool som = tem_som(a);
+        if (som) {
+            fprintf(f, "static const uint16_t %s_tons[%d][2] = {\n   ", a->nome, a->num_quadros);
+            for (int q = 0; q < a->num_quadros; q++) {
+                const uint16_t *t = a->tem_tom_quadro[q] ? a->tons[q] : a->tom;
+                fprintf(f, " { %u, %u },", t[0], t[1]);
+                if (q % 6 == 5 && q + 1 < a->num_quadros) {
+                    fprintf(f, "\n   ");
+                }
+            }
+            fprintf(f, "\n};\n");
+        }
+
+        fprintf(f, "static const AnimacaoPronta animacao_pronta_%s = {\n", a->nome);
+        fprintf(f, "    .nome = \"%s\",\n", a->nome);
+        fprintf(f, "    .quadros = %s_quadros,\n", a->nome);
+        fprintf(f, "    .num_quadros = %d,\n", a->num_quadros);
+        fprintf(f, "    .fps = %d,\n", a->fps);
+        fprintf(f, "    .tons = %s%s,\n", som ? a->nome : "NULL", som ? "_tons" : "");
+        fprintf(f, "};\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "uso: %s <manifesto> <header>\n", argv[0]);
+        return 1;
+    }
+    manifesto = argv[1];
+    ler_manifesto(manifesto);
+
+    FILE *f = fopen(argv[2], "w");
+    if (!f) {
+        fprintf(stderr, "%s: nao foi possivel criar\n", argv[2]);
+        return 1;
+    }
+    const char *nome = strrchr(manifesto, '/');
+    gerar(f, nome ? nome + 1 : manifesto);
+    fclose(f);
+    return 0;
+}
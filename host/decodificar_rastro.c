@@ -0,0 +1,279 @@
+// Decodifica o despejo binário do rastro (rastro.h, comando 'y') numa linha do
+// tempo em texto e, opcionalmente, em JSON no formato de eventos de trace do
+// Chrome (abre em chrome://tracing ou no Perfetto, uma linha por núcleo).
+//
+//   decodificar_rastro <porta> [-j saida.json]       (pede o despejo à placa)
+//   decodificar_rastro -t traco.txt [-j saida.json]  (traço do simulador, linhas USB_SAIDA)
+//   decodificar_rastro -b despejo.bin [-j saida.json]
+#define _DEFAULT_SOURCE
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "fluxo_pc.h"
+#include "rastro.h"
+
+#define TAMANHO_EVENTO 12
+#define MAX_BYTES (5 + 2 * RASTRO_EVENTOS * TAMANHO_EVENTO + 4096)
+
+static const char *const nomes[RASTRO_TIPOS] = {
+    [RASTRO_QUADRO] = "quadro",
+    [RASTRO_SAIDA] = "saida",
+    [RASTRO_ACORDAR] = "acordar",
+    [RASTRO_TECLA] = "tecla",
+    [RASTRO_BUZZER] = "buzzer",
+};
+
+typedef struct {
+    int64_t tempo_us;   // Relativo ao evento mais antigo
+    uint32_t dado;
+    uint16_t duracao_us;
+    uint8_t tipo;
+    uint8_t nucleo;
+} Evento;
+
+static uint8_t bytes[MAX_BYTES];
+static size_t num_bytes = 0;
+
+static uint32_t le32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Bytes de todas as linhas USB_SAIDA do traço do simulador, em ordem
+static bool ler_traco(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+    char linha[4096];
+    while (fgets(linha, sizeof(linha), f)) {
+        char *p = strstr(linha, " USB_SAIDA ");
+        p = p ? strchr(p, ':') : NULL;
+        if (!p) {
+            continue;
+        }
+        unsigned v;
+        int n;
+        for (p++; sscanf(p, "%x%n", &v, &n) == 1 && num_bytes < MAX_BYTES; p += n) {
+            bytes[num_bytes++] = (uint8_t)v;
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+static bool ler_binario(const char *caminho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+    num_bytes = fread(bytes, 1, MAX_BYTES, f);
+    fclose(f);
+    return true;
+}
+
+// Manda 'y' e lê até o despejo completo chegar (ou 2 s sem bytes)
+static bool ler_porta(const char *caminho) {
+    int fd = fluxo_abrir(caminho);
+    if (fd < 0) {
+        return false;
+    }
+    if (write(fd, "y", 1) != 1) {
+        perror(caminho);
+        close(fd);
+        return false;
+    }
+    struct pollfd p = { .fd = fd, .events = POLLIN };
+    while (num_bytes < MAX_BYTES && poll(&p, 1, 2000) > 0) {
+        ssize_t r = read(fd, bytes + num_bytes, MAX_BYTES - num_bytes);
+        if (r <= 0) {
+            break;
+        }
+        num_bytes += (size_t)r;
+
+        // Para assim que o despejo inteiro estiver no buffer
+        for (size_t i = 0; i + 5 <= num_bytes; i++) {
+            if (bytes[i] == 'R' && bytes[i + 1] == 'S' && bytes[i + 2] == RASTRO_VERSAO &&
+                num_bytes >= i + 5 + (size_t)(bytes[i + 3] | (bytes[i + 4] << 8)) * TAMANHO_EVENTO) {
+                close(fd);
+                return true;
+            }
+        }
+    }
+    close(fd);
+    return true;
+}
+
+static int comparar(const void *a, const void *b) {
+    const Evento *x = a, *y = b;
+    if (x->tempo_us != y->tempo_us) {
+        return x->tempo_us < y->tempo_us ? -1 : 1;
+    }
+    return x->nucleo - y->nucleo;
+}
+
+// Procura o último despejo completo nos bytes e decodifica os eventos
+static Evento *decodificar(size_t *quantidade) {
+    const uint8_t *inicio = NULL;
+    size_t n = 0;
+    for (size_t i = 0; i + 5 <= num_bytes; i++) {
+        size_t m = bytes[i + 3] | (bytes[i + 4] << 8);
+        if (bytes[i] == 'R' && bytes[i + 1] == 'S' && bytes[i + 2] == RASTRO_VERSAO &&
+            i + 5 + m * TAMANHO_EVENTO <= num_bytes) {
+            inicio = bytes + i + 5;
+            n = m;
+        }
+    }
+    if (!inicio) {
+        return NULL;
+    }
+
+    Evento *eventos = calloc(n ? n : 1, sizeof(Evento));
+    uint32_t referencia = n ? le32(inicio) : 0;
+    int64_t menor = 0;
+    for (size_t k = 0; k < n; k++) {
+        const uint8_t *p = inicio + k * TAMANHO_EVENTO;
+        // O timer de 32 bits dá a volta em ~71 min: os tempos são diferenças com sinal
+        eventos[k] = (Evento) {
+            .tempo_us = (int32_t)(le32(p) - referencia),
+            .dado = le32(p + 4),
+            .duracao_us = (uint16_t)(p[8] | (p[9] << 8)),
+            .tipo = p[10],
+            .nucleo = p[11],
+        };
+        if (eventos[k].tempo_us < menor) {
+            menor = eventos[k].tempo_us;
+        }
+    }
+    for (size_t k = 0; k < n; k++) {
+        eventos[k].tempo_us -= menor;
+    }
+    qsort(eventos, n, sizeof(Evento), comparar);
+    *quantidade = n;
+    return eventos;
+}
+
+static const char *nome(uint8_t tipo) {
+    return tipo < RASTRO_TIPOS ? nomes[tipo] : "?";
+}
+
+static void descrever(const Evento *e, char *texto, size_t tamanho) {
+    switch (e->tipo) {
+    case RASTRO_QUADRO:
+        snprintf(texto, tamanho, "quadro %u", e->dado);
+        break;
+    case RASTRO_SAIDA:
+        snprintf(texto, tamanho, "%u pixels", e->dado);
+        break;
+    case RASTRO_ACORDAR:
+        snprintf(texto, tamanho, "%s", e->dado ? "cancelada" : "");
+        break;
+    case RASTRO_TECLA:
+        snprintf(texto, tamanho, "'%c'", (char)e->dado);
+        break;
+    case RASTRO_BUZZER:
+        snprintf(texto, tamanho, "%u Hz", e->dado);
+        break;
+    default:
+        snprintf(texto, tamanho, "%u", e->dado);
+    }
+}
+
+static void imprimir_linha_do_tempo(const Evento *eventos, size_t n) {
+    printf("%12s  %-2s %-8s %8s  %s\n", "tempo (ms)", "n", "evento", "dur (us)", "dado");
+    int64_t anterior = 0;
+    for (size_t k = 0; k < n; k++) {
+        const Evento *e = &eventos[k];
+        char texto[32];
+        descrever(e, texto, sizeof(texto));
+        // Linha em branco nos intervalos longos, para separar os quadros
+        if (k > 0 && e->tempo_us - anterior > 5000) {
+            printf("\n");
+        }
+        anterior = e->tempo_us;
+        printf("%12.3f  %-2u %-8s %8u  %s\n", e->tempo_us / 1000.0, e->nucleo, nome(e->tipo), e->duracao_us, texto);
+    }
+
+    printf("\n%-8s %8s %10s %8s\n", "tipo", "qtd", "media (us)", "max (us)");
+    for (int t = 0; t < RASTRO_TIPOS; t++) {
+        uint32_t quantidade = 0, max = 0;
+        uint64_t soma = 0;
+        for (size_t k = 0; k < n; k++) {
+            if (eventos[k].tipo == t) {
+                quantidade++;
+                soma += eventos[k].duracao_us;
+                max = eventos[k].duracao_us > max ? eventos[k].duracao_us : max;
+            }
+        }
+        if (quantidade > 0) {
+            printf("%-8s %8u %10.1f %8u\n", nomes[t], quantidade, (double)soma / quantidade, max);
+        }
+    }
+}
+
+// Eventos "X" (com duração) do formato de trace do Chrome; tid = núcleo
+static bool escrever_json(const char *caminho, const Evento *eventos, size_t n) {
+    FILE *f = fopen(caminho, "w");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+    fprintf(f, "{\"traceEvents\":[\n");
+    for (size_t k = 0; k < n; k++) {
+        const Evento *e = &eventos[k];
+        char texto[32];
+        descrever(e, texto, sizeof(texto));
+        fprintf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%lld,\"dur\":%u,\"args\":{\"dado\":\"",
+                nome(e->tipo), e->nucleo, (long long)e->tempo_us, e->duracao_us ? e->duracao_us : 1);
+        for (const char *c = texto; *c; c++) {
+            if (*c == '"' || *c == '\\') {
+                fputc('\\', f);
+            }
+            fputc(*c, f);
+        }
+        fprintf(f, "\"}}%s\n", k + 1 < n ? "," : "");
+    }
+    fprintf(f, "]}\n");
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const char *json = NULL, *traco = NULL, *binario = NULL, *porta = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            json = argv[++i];
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            traco = argv[++i];
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            binario = argv[++i];
+        } else {
+            porta = argv[i];
+        }
+    }
+    if (!traco && !binario && !porta) {
+        fprintf(stderr, "uso: %s <porta> | -t traco.txt | -b despejo.bin  [-j saida.json]\n", argv[0]);
+        return 1;
+    }
+
+    bool ok = traco ? ler_traco(traco) : binario ? ler_binario(binario) : ler_porta(porta);
+    if (!ok) {
+        return 1;
+    }
+    size_t n = 0;
+    Evento *eventos = decodificar(&n);
+    if (!eventos) {
+        fprintf(stderr, "nenhum despejo de rastro completo (%zu bytes lidos)\n", num_bytes);
+        return 1;
+    }
+
+    imprimir_linha_do_tempo(eventos, n);
+    if (json && !escrever_json(json, eventos, n)) {
+        return 1;
+    }
+    free(eventos);
+    return 0;
+}
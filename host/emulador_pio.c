@@ -0,0 +1,243 @@
+#include <stdio.h>
+#include "emulador_pio.h"
+
+#define OP_JMP  0
+#define OP_WAIT 1
+#define OP_IN   2
+#define OP_OUT  3
+#define OP_PUSH_PULL 4
+#define OP_MOV  5
+#define OP_IRQ  6
+#define OP_SET  7
+
+void emulador_iniciar(EmuladorPio *e, const uint16_t *memoria, uint pc, const pio_sm_config *config) {
+    *e = (EmuladorPio) {
+        .memoria = memoria,
+        .pc = pc,
+        .config = *config,
+        .osr_contagem = 32,
+    };
+}
+
+void emulador_fifo(EmuladorPio *e, const uint32_t *palavras, uint quantidade) {
+    e->fifo = palavras;
+    e->fifo_tamanho = quantidade;
+    e->fifo_lidas = 0;
+}
+
+static void mudar_pinos(EmuladorPio *e, uint base, uint quantidade, uint32_t valor) {
+    uint32_t pinos = e->pinos;
+    for (uint i = 0; i < quantidade; i++) {
+        uint32_t bit = 1u << ((base + i) & 31);
+        pinos = (valor >> i) & 1 ? pinos | bit : pinos & ~bit;
+    }
+    if (pinos != e->pinos) {
+        e->pinos = pinos;
+        if (e->ao_mudar) {
+            e->ao_mudar(e->contexto, e->ciclo, pinos);
+        }
+    }
+}
+
+// Tira a próxima palavra da FIFO para o OSR; false se ela estiver vazia
+static bool puxar(EmuladorPio *e) {
+    if (e->fifo_lidas == e->fifo_tamanho) {
+        return false;
+    }
+    e->osr = e->fifo[e->fifo_lidas++];
+    e->osr_contagem = 0;
+    e->ciclo_ultimo_pull = e->ciclo;
+    return true;
+}
+
+static uint32_t deslocar_osr(EmuladorPio *e, uint bits) {
+    uint32_t dado;
+    if (bits == 32) {
+        dado = e->osr;
+        e->osr = 0;
+    } else if (e->config.out_shift_right) {
+        dado = e->osr & ((1u << bits) - 1);
+        e->osr >>= bits;
+    } else {
+        dado = e->osr >> (32 - bits);
+        e->osr <<= bits;
+    }
+    e->osr_contagem = e->osr_contagem + bits > 32 ? 32 : e->osr_contagem + bits;
+    return dado;
+}
+
+static uint32_t inverter_bits(uint32_t v) {
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i++) {
+        r = (r << 1) | ((v >> i) & 1);
+    }
+    return r;
+}
+
+static bool condicao_jmp(EmuladorPio *e, uint condicao) {
+    switch (condicao) {
+    case 0: return true;
+    case 1: return e->x == 0;
+    case 2: return e->x-- != 0;
+    case 3: return e->y == 0;
+    case 4: return e->y-- != 0;
+    case 5: return e->x != e->y;
+    case 7: return e->osr_contagem < e->config.pull_threshold;
+    default:
+        e->erro = true; // JMP PIN: nenhum pino de entrada é simulado
+        return false;
+    }
+}
+
+// Executa a instrução em pc. Retorna false se ela travou (fica para o próximo ciclo).
+static bool executar(EmuladorPio *e, uint16_t instr, bool *desviou) {
+    uint op = instr >> 13;
+    uint destino = (instr >> 5) & 7;
+    uint indice = instr & 0x1F;
+    *desviou = false;
+
+    switch (op) {
+    case OP_JMP:
+        if (condicao_jmp(e, destino)) {
+            e->pc = indice;
+            *desviou = true;
+        }
+        return true;
+
+    case OP_OUT: {
+        if (e->config.autopull && e->osr_contagem >= e->config.pull_threshold && !puxar(e)) {
+            return false;
+        }
+        uint bits = indice ? indice : 32;
+        uint32_t dado = deslocar_osr(e, bits);
+        switch (destino) {
+        case 0: mudar_pinos(e, e->config.out_base, e->config.out_count, dado); break;
+        case 1: e->x = dado; break;
+        case 2: e->y = dado; break;
+        case 3: break;
+        case 5: e->pc = dado & 31; *desviou = true; break;
+        case 6: e->isr = dado; break;
+        default: e->erro = true; break;
+        }
+        return true;
+    }
+
+    case OP_PUSH_PULL: {
+        if (!(instr & 0x80)) {
+            e->erro = true; // PUSH: a FIFO de RX não é simulada
+            return true;
+        }
+        bool se_vazio = instr & 0x40, bloqueia = instr & 0x20;
+        if (se_vazio && e->osr_contagem < e->config.pull_threshold) {
+            return true;
+        }
+        if (!puxar(e)) {
+            if (bloqueia) {
+                return false;
+            }
+            e->osr = e->x; // PULL noblock com a FIFO vazia copia X
+            e->osr_contagem = 0;
+        }
+        return true;
+    }
+
+    case OP_MOV: {
+        uint32_t v;
+        switch (instr & 7) {
+        case 0: v = e->pinos >> e->config.out_base; break; // Entradas = pinos de saída
+        case 1: v = e->x; break;
+        case 2: v = e->y; break;
+        case 3: v = 0; break;
+        case 6: v = e->isr; break;
+        case 7: v = e->osr; break;
+        default: v = 0; e->erro = true; break;
+        }
+        uint operacao = (instr >> 3) & 3;
+        if (operacao == 1) {
+            v = ~v;
+        } else if (operacao == 2) {
+            v = inverter_bits(v);
+        }
+        switch (destino) {
+        case 0: mudar_pinos(e, e->config.out_base, e->config.out_count, v); break;
+        case 1: e->x = v; break;
+        case 2: e->y = v; break;
+        case 5: e->pc = v & 31; *desviou = true; break;
+        case 6: e->isr = v; break;
+        case 7: e->osr = v; e->osr_contagem = 0; break;
+        default: e->erro = true; break;
+        }
+        return true;
+    }
+
+    case OP_SET:
+        switch (destino) {
+        case 0: mudar_pinos(e, e->config.set_base, e->config.set_count, indice); break;
+        case 1: e->x = indice; break;
+        case 2: e->y = indice; break;
+        case 4: break; // PINDIRS: todos os pinos já são saídas
+        default: e->erro = true; break;
+        }
+        return true;
+
+    default:
+        e->erro = true; // WAIT, IN, IRQ
+        return true;
+    }
+}
+
+bool emulador_ciclo(EmuladorPio *e) {
+    if (e->erro) {
+        return false;
+    }
+    if (e->atraso > 0) {
+        e->atraso--;
+        e->ciclo++;
+        return true;
+    }
+
+    uint16_t instr = e->memoria[e->pc];
+
+    // Campo de 5 bits dividido entre side-set (bits altos) e atraso (bits baixos)
+    uint campo = (instr >> 8) & 0x1F;
+    uint bits_sideset = e->config.sideset_bits;
+    uint atraso = campo & ((1u << (5 - bits_sideset)) - 1);
+    if (bits_sideset > 0) {
+        uint valor = campo >> (5 - bits_sideset);
+        uint bits_valor = bits_sideset;
+        bool habilitado = true;
+        if (e->config.sideset_opcional) {
+            bits_valor--;
+            habilitado = (valor >> bits_valor) & 1;
+            valor &= (1u << bits_valor) - 1;
+        }
+        // O side-set vale no primeiro ciclo da instrução, mesmo se ela travar
+        if (habilitado) {
+            mudar_pinos(e, e->config.sideset_base, bits_valor, valor);
+        }
+    }
+
+    bool desviou;
+    if (!executar(e, instr, &desviou)) {
+        e->ciclo++;
+        return false;
+    }
+    if (e->erro) {
+        fprintf(stderr, "emulador_pio: instrucao %04x nao suportada (pc %u)\n", instr, e->pc);
+        return false;
+    }
+
+    if (!desviou) {
+        e->pc = (e->pc == e->config.wrap) ? e->config.wrap_target : (e->pc + 1) & 31;
+    }
+    e->atraso = atraso;
+    e->ciclo++;
+    return true;
+}
+
+uint64_t emulador_executar(EmuladorPio *e, uint64_t max_ciclos) {
+    uint64_t inicio = e->ciclo;
+    while (e->ciclo - inicio < max_ciclos && emulador_ciclo(e)) {
+    }
+    return e->ciclo - inicio;
+}
@@ -0,0 +1,52 @@
+#ifndef EMULADOR_PIO_H
+#define EMULADOR_PIO_H
+
+#include "hardware/pio.h"
+
+// Emulador de uma state machine do PIO do RP2040, ciclo a ciclo, para conferir no
+// PC as formas de onda dos programas de matriz_led.pio. Cobre o que esses
+// programas usam: JMP (todas as condições), OUT, PULL, MOV, SET, NOP, side-set
+// (opcional ou não), atrasos, wrap e autopull. WAIT, IN, PUSH e IRQ param a
+// emulação com erro.
+
+// Chamado a cada mudança nos pinos (bit n = GPIO n)
+typedef void (*MudancaPinos)(void *contexto, uint64_t ciclo, uint32_t pinos);
+
+typedef struct {
+    // Programa e configuração (como em pio_sm_init)
+    const uint16_t *memoria;    // 32 instruções, endereços de JMP já absolutos
+    uint pc;
+    pio_sm_config config;
+
+    // FIFO de TX: as palavras entram conforme são puxadas, sem limite de profundidade
+    const uint32_t *fifo;
+    uint fifo_tamanho;
+    uint fifo_lidas;
+
+    // Estado interno
+    uint32_t x, y, osr, isr;
+    uint osr_contagem;          // Bits já deslocados do OSR (32 = vazio)
+    uint atraso;                // Ciclos de atraso restantes da instrução atual
+    uint32_t pinos;
+    uint64_t ciclo;
+    uint64_t ciclo_ultimo_pull;  // Ciclo em que a última palavra saiu da FIFO
+    bool erro;
+
+    MudancaPinos ao_mudar;
+    void *contexto;
+} EmuladorPio;
+
+// Prepara a state machine para começar em `pc`, com o OSR vazio e os pinos em 0
+void emulador_iniciar(EmuladorPio *e, const uint16_t *memoria, uint pc, const pio_sm_config *config);
+
+// Coloca as palavras na FIFO de TX (substitui as anteriores)
+void emulador_fifo(EmuladorPio *e, const uint32_t *palavras, uint quantidade);
+
+// Executa um ciclo. Retorna false se a state machine travou esperando a FIFO
+// vazia (fim dos dados) ou encontrou uma instrução não suportada.
+bool emulador_ciclo(EmuladorPio *e);
+
+// Executa até travar ou até `max_ciclos`; retorna os ciclos executados
+uint64_t emulador_executar(EmuladorPio *e, uint64_t max_ciclos);
+
+#endif
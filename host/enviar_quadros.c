@@ -0,0 +1,32 @@
+// Manda quadros ao vivo para o Pico pelo USB (fluxo_usb.h) e mede a vazão e a
+// latência das respostas.
+//
+//   enviar_quadros <porta> [quadros] [fps]     (ex.: /dev/ttyACM0 2000 0; fps 0 = máximo)
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "fluxo_pc.h"
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s <porta> [quadros] [fps]\n", argv[0]);
+        return 1;
+    }
+    OpcoesEnvio opcoes = {
+        .quadros = argc > 2 ? (uint32_t)atoi(argv[2]) : 1000,
+        .fps = argc > 3 ? (uint32_t)atoi(argv[3]) : 0,
+    };
+
+    int fd = fluxo_abrir(argv[1]);
+    if (fd < 0) {
+        return 1;
+    }
+    ResultadoEnvio r;
+    bool ok = fluxo_enviar(fd, &opcoes, &r);
+    close(fd);
+    if (!ok) {
+        return 1;
+    }
+    fluxo_imprimir(&r);
+    return 0;
+}
@@ -0,0 +1,214 @@
+#define _DEFAULT_SOURCE
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "fluxo_pc.h"
+#include "fluxo_usb.h"
+#include "acervo.h"
+
+#define MAX_PIXELS 1024
+#define ESPERA_INICIO_MS 3000
+#define ESPERA_RESPOSTA_MS 2000
+
+static double agora_us(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+bool fluxo_modo_bruto(int fd) {
+    struct termios t;
+    if (tcgetattr(fd, &t) != 0) {
+        return false;
+    }
+    cfmakeraw(&t);
+    t.c_cc[VMIN] = 0;
+    t.c_cc[VTIME] = 0;
+    return tcsetattr(fd, TCSANOW, &t) == 0;
+}
+
+int fluxo_abrir(const char *caminho) {
+    int fd = open(caminho, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        perror(caminho);
+        return -1;
+    }
+    if (!fluxo_modo_bruto(fd)) {
+        perror(caminho);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+uint32_t fluxo_padrao(uint32_t seq, uint32_t i) {
+    // Roda de cores em 192 passos (três rampas de 64), um passo por quadro
+    uint32_t h = (seq + i * 8) % 192;
+    uint32_t subida = (h % 64) * 4, descida = 252 - subida;
+    uint32_t r, g, b;
+    if (h < 64) {
+        r = descida, g = subida, b = 0;
+    } else if (h < 128) {
+        r = 0, g = descida, b = subida;
+    } else {
+        r = subida, g = 0, b = descida;
+    }
+    return (g << 24) | (r << 16) | (b << 8);
+}
+
+bool fluxo_escrever_tudo(int fd, const uint8_t *buf, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(fd, buf, n);
+        if (w < 0) {
+            return false;
+        }
+        buf += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+int fluxo_ler_resposta(int fd, uint8_t *dados, int max_dados, int timeout_ms) {
+    double limite = agora_us() + timeout_ms * 1000.0;
+    int estado = 0, tipo = 0, lidos = 0, esperados = 0;
+    while (true) {
+        int resta = (int)((limite - agora_us()) / 1000);
+        struct pollfd p = { .fd = fd, .events = POLLIN };
+        if (resta <= 0 || poll(&p, 1, resta) <= 0) {
+            return 0;
+        }
+        uint8_t c;
+        if (read(fd, &c, 1) != 1) {
+            continue;
+        }
+        if (estado == 0) {
+            estado = c == FLUXO_SINC0;
+        } else if (estado == 1) {
+            tipo = c;
+            esperados = tipo == FLUXO_INICIO ? 3 : 1;
+            if (tipo != FLUXO_INICIO && tipo != FLUXO_ACEITO && tipo != FLUXO_REJEITADO && tipo != FLUXO_FIM
+                && tipo != ACERVO_GRAVADO) {
+                estado = c == FLUXO_SINC0;
+                continue;
+            }
+            estado = 2;
+            lidos = 0;
+        } else {
+            if (lidos < max_dados) {
+                dados[lidos] = c;
+            }
+            if (++lidos == esperados) {
+                return tipo;
+            }
+        }
+    }
+}
+
+static size_t montar_quadro(uint8_t *buf, uint8_t seq, uint32_t n, uint32_t seq_padrao) {
+    buf[0] = FLUXO_SINC0;
+    buf[1] = FLUXO_SINC1;
+    buf[2] = seq;
+    buf[3] = n & 0xFF;
+    buf[4] = n >> 8;
+    uint8_t *p = buf + FLUXO_CABECALHO;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t grb = fluxo_padrao(seq_padrao, i);
+        *p++ = grb >> 24;
+        *p++ = grb >> 16;
+        *p++ = grb >> 8;
+    }
+    uint16_t crc = fluxo_crc16(FLUXO_CRC_INICIAL, buf + 2, (uint)(p - buf - 2));
+    *p++ = crc & 0xFF;
+    *p++ = crc >> 8;
+    return (size_t)(p - buf);
+}
+
+bool fluxo_enviar(int fd, const OpcoesEnvio *opcoes, ResultadoEnvio *r) {
+    *r = (ResultadoEnvio) { .latencia_min_us = 1e12 };
+    tcflush(fd, TCIFLUSH);
+
+    uint8_t dados[3];
+    uint8_t abrir = 's';
+    fluxo_escrever_tudo(fd, &abrir, 1);
+    if (fluxo_ler_resposta(fd, dados, sizeof(dados), ESPERA_INICIO_MS) != FLUXO_INICIO) {
+        fprintf(stderr, "fluxo: o Pico nao abriu a sessao\n");
+        return false;
+    }
+    r->janela = dados[0] ? dados[0] : 1;
+    r->num_pixels = dados[1] | (dados[2] << 8);
+    if (r->num_pixels == 0 || r->num_pixels > MAX_PIXELS) {
+        fprintf(stderr, "fluxo: %u pixels fora do suportado\n", r->num_pixels);
+        return false;
+    }
+
+    static uint8_t quadro[FLUXO_CABECALHO + 3 * MAX_PIXELS + FLUXO_RODAPE];
+    double enviado_us[256];
+    uint32_t enviados = 0, respondidos = 0;
+    double inicio = agora_us();
+    double proximo = inicio;
+
+    while (respondidos < opcoes->quadros) {
+        bool pode_enviar = enviados < opcoes->quadros && enviados - respondidos < r->janela;
+        if (pode_enviar && opcoes->fps && agora_us() < proximo) {
+            usleep((useconds_t)(proximo - agora_us()));
+        }
+        if (pode_enviar) {
+            uint8_t seq = (uint8_t)enviados;
+            size_t n = montar_quadro(quadro, seq, r->num_pixels, enviados);
+            if (opcoes->corromper && enviados % opcoes->corromper == opcoes->corromper - 1) {
+                quadro[n - 1] ^= 0xFF;
+            }
+            if (!fluxo_escrever_tudo(fd, quadro, n)) {
+                perror("fluxo");
+                return false;
+            }
+            enviado_us[seq] = agora_us();
+            r->bytes += n;
+            enviados++;
+            proximo += opcoes->fps ? 1e6 / opcoes->fps : 0;
+            continue;
+        }
+
+        int tipo = fluxo_ler_resposta(fd, dados, sizeof(dados), ESPERA_RESPOSTA_MS);
+        if (tipo == 0) {
+            fprintf(stderr, "fluxo: sem resposta (%u de %u respondidos)\n", respondidos, enviados);
+            return false;
+        }
+        double latencia = agora_us() - enviado_us[dados[0]];
+        r->latencia_min_us = latencia < r->latencia_min_us ? latencia : r->latencia_min_us;
+        r->latencia_max_us = latencia > r->latencia_max_us ? latencia : r->latencia_max_us;
+        r->latencia_soma_us += latencia;
+        if (tipo == FLUXO_ACEITO) {
+            r->aceitos++;
+        } else {
+            r->rejeitados++;
+        }
+        respondidos++;
+    }
+    r->segundos = (agora_us() - inicio) / 1e6;
+
+    // Quadro de fim: n = 0
+    size_t n = montar_quadro(quadro, (uint8_t)enviados, 0, 0);
+    fluxo_escrever_tudo(fd, quadro, n);
+    if (fluxo_ler_resposta(fd, dados, sizeof(dados), ESPERA_RESPOSTA_MS) != FLUXO_FIM) {
+        fprintf(stderr, "fluxo: o Pico nao confirmou o fim\n");
+        return false;
+    }
+    return true;
+}
+
+void fluxo_imprimir(const ResultadoEnvio *r) {
+    uint32_t respostas = r->aceitos + r->rejeitados;
+    printf("%u pixels, janela %u\n", r->num_pixels, r->janela);
+    printf("Quadros: %u aceitos, %u rejeitados em %.3f s: %.1f quadros/s, %.1f kB/s\n",
+           r->aceitos, r->rejeitados, r->segundos,
+           respostas / r->segundos, r->bytes / r->segundos / 1000);
+    if (respostas) {
+        printf("Envio -> resposta (us): min %.0f  max %.0f  media %.0f\n",
+               r->latencia_min_us, r->latencia_max_us, r->latencia_soma_us / respostas);
+    }
+}
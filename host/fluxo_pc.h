@@ -0,0 +1,49 @@
+#ifndef FLUXO_PC_H
+#define FLUXO_PC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Lado do PC do fluxo de quadros (fluxo_usb.h): abre a porta serial, abre a
+// sessão e manda quadros respeitando a janela, medindo vazão e latência.
+
+typedef struct {
+    uint32_t quadros;       // Quantos mandar
+    uint32_t fps;           // 0 = o mais rápido que a janela deixar
+    uint32_t corromper;     // Estraga o CRC de 1 a cada N quadros (0 = nunca), para testar o 'N'
+} OpcoesEnvio;
+
+typedef struct {
+    uint32_t janela;
+    uint32_t num_pixels;
+    uint32_t aceitos;
+    uint32_t rejeitados;
+    uint64_t bytes;
+    double segundos;
+    double latencia_min_us, latencia_max_us, latencia_soma_us; // Fim do envio -> resposta
+} ResultadoEnvio;
+
+// Abre e configura a porta em modo bruto (sem eco nem tradução); -1 em erro
+int fluxo_abrir(const char *caminho);
+
+// Deixa o descritor em modo bruto (ex.: o lado escravo de um pty)
+bool fluxo_modo_bruto(int fd);
+
+bool fluxo_escrever_tudo(int fd, const uint8_t *buf, size_t n);
+
+// Próxima resposta (A5 tipo ...), pulando o texto que o firmware imprime no meio.
+// Retorna o tipo, ou 0 se nada chegar em timeout_ms.
+int fluxo_ler_resposta(int fd, uint8_t *dados, int max_dados, int timeout_ms);
+
+// Palavra GRB do pixel i no quadro seq: um arco-íris que anda um passo por quadro.
+// O mesmo padrão é conferido do outro lado no loopback.
+uint32_t fluxo_padrao(uint32_t seq, uint32_t i);
+
+// Abre a sessão ('s'), manda os quadros e fecha com o quadro de fim.
+// Retorna false se o Pico não responder.
+bool fluxo_enviar(int fd, const OpcoesEnvio *opcoes, ResultadoEnvio *r);
+
+void fluxo_imprimir(const ResultadoEnvio *r);
+
+#endif
@@ -0,0 +1,51 @@
+// Grava uma animação de grade de texto no acervo da flash do Pico (acervo.h), pelo
+// USB. Depois, 'a<id>' toca a animação e 'm' lista o acervo.
+//
+//   gravar_animacao <porta> <id> <fps> <r> <g> <b> <grade.txt>   (cores de 0 a 255)
+//   gravar_animacao <porta> <id> apagar
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "acervo.h"
+#include "acervo_pc.h"
+#include "fluxo_pc.h"
+
+int main(int argc, char **argv) {
+    bool apagar = argc == 4 && strcmp(argv[3], "apagar") == 0;
+    if (argc != 8 && !apagar) {
+        fprintf(stderr, "uso: %s <porta> <id> <fps> <r> <g> <b> <grade.txt>\n"
+                        "     %s <porta> <id> apagar\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    static uint8_t quadros[ACERVO_MAX_QUADROS][BYTES_POR_QUADRO];
+    int num_quadros = 0;
+    if (!apagar) {
+        num_quadros = acervo_ler_grade(argv[7], quadros, ACERVO_MAX_QUADROS);
+        if (num_quadros <= 0) {
+            fprintf(stderr, "%s: nenhum quadro\n", argv[7]);
+            return 1;
+        }
+    }
+
+    int fd = fluxo_abrir(argv[1]);
+    if (fd < 0) {
+        return 1;
+    }
+    uint8_t id = (uint8_t)atoi(argv[2]);
+    bool ok = apagar ? acervo_enviar(fd, id, 0, 0, 0, 0, quadros, 0)
+                     : acervo_enviar(fd, id, (uint8_t)atoi(argv[3]), (uint8_t)atoi(argv[4]),
+                                     (uint8_t)atoi(argv[5]), (uint8_t)atoi(argv[6]), quadros,
+                                     (uint16_t)num_quadros);
+    close(fd);
+    if (!ok) {
+        return 1;
+    }
+    if (apagar) {
+        printf("Id %u apagado\n", id);
+    } else {
+        printf("%d quadros gravados no id %u\n", num_quadros, id);
+    }
+    return 0;
+}
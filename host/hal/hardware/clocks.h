@@ -0,0 +1,21 @@
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+enum clock_index { clk_gpout0, clk_gpout1, clk_gpout2, clk_gpout3, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc, clk_rtc };
+
+#define KHZ 1000
+#define MHZ 1000000
+
+// Fontes do clk_sys usadas pelo firmware (valores dos registradores do RP2040)
+#define CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX 0x1
+#define CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS 0x0
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+// Só o clk_sys muda (o PWM, o DMA e o PIO simulados seguem o novo valor); vira
+// uma linha CLOCK no traço
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SIM_HARDWARE_DMA_H
+#define SIM_HARDWARE_DMA_H
+
+#include "pico/stdlib.h"
+
+// DMA simulado: a transferência acontece de uma vez no início, e o fim (com as
+// IRQs 0 e 1, se habilitadas, e o canal encadeado) é agendado no tempo virtual de
+// acordo com o DREQ. Cada fim tem que ser reconhecido por exatamente um handler.
+#define NUM_DMA_CHANNELS 12
+#define NUM_DMA_TIMERS 4
+#define DREQ_ADC 36
+#define DREQ_DMA_TIMER0 0x3b
+#define DREQ_FORCE 0x3f
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    enum dma_channel_transfer_size tamanho;
+    bool read_increment;
+    bool write_increment;
+    uint dreq;
+    uint chain_to;          // O próprio canal: sem encadeamento
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+int dma_claim_unused_timer(bool required);
+dma_channel_config dma_channel_get_default_config(uint channel);
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->tamanho = size;
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->read_increment = incr;
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->write_increment = incr;
+}
+
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->chain_to = chain_to;
+}
+
+static inline uint dma_get_timer_dreq(uint timer_num) {
+    return DREQ_DMA_TIMER0 + timer_num;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_start_channel_mask(uint32_t chan_mask);
+
+static inline void dma_channel_start(uint channel) {
+    dma_start_channel_mask(1u << channel);
+}
+
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+bool dma_channel_get_irq0_status(uint channel);
+void dma_channel_acknowledge_irq0(uint channel);
+void dma_channel_set_irq1_enabled(uint channel, bool enabled);
+bool dma_channel_get_irq1_status(uint channel);
+void dma_channel_acknowledge_irq1(uint channel);
+void dma_timer_set_fraction(uint timer, uint16_t numerator, uint16_t denominator);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef SIM_HARDWARE_FLASH_H
+#define SIM_HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+// Flash simulada (host/hal_simulado.c): um arquivo ou um bloco de memória do
+// tamanho da flash do Pico W, que também faz o papel da janela da XIP. Apagar e
+// gravar seguem a flash NOR: apagar põe 0xFF num setor inteiro e gravar só zera
+// bits, em páginas alinhadas.
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+
+#define XIP_BASE ((uintptr_t)sim_flash_xip())
+const uint8_t *sim_flash_xip(void);
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif
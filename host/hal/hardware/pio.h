@@ -0,0 +1,117 @@
+#ifndef SIM_HARDWARE_PIO_H
+#define SIM_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+// PIO simulado: os programas são carregados e as state machines configuradas.
+// O que o DMA escreve na FIFO de TX roda no emulador de instruções
+// (host/emulador_pio.c), que dá o tempo de cada palavra e do quadro.
+#define NUM_PIOS 2
+#define NUM_PIO_STATE_MACHINES 4
+#define PICO_PIO_VERSION 0
+
+typedef struct pio_hw {
+    volatile uint32_t txf[NUM_PIO_STATE_MACHINES];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t sim_pio_hw[NUM_PIOS];
+#define pio0 (&sim_pio_hw[0])
+#define pio1 (&sim_pio_hw[1])
+
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE = 0, PIO_FIFO_JOIN_TX = 1, PIO_FIFO_JOIN_RX = 2 };
+
+typedef struct pio_program {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+    uint8_t pio_version;
+} pio_program_t;
+
+typedef struct {
+    float clkdiv;
+    uint out_base, out_count;
+    uint set_base, set_count;
+    uint sideset_base;
+    uint sideset_bits;          // Inclui o bit de habilitação quando opcional
+    bool sideset_opcional;
+    bool out_shift_right, autopull;
+    uint pull_threshold;
+    uint wrap_target, wrap;
+    enum pio_fifo_join fifo_join;
+} pio_sm_config;
+
+static inline uint pio_get_index(PIO pio) {
+    return (uint)(pio - sim_pio_hw);
+}
+
+// Mesma numeração do RP2040: DREQ_PIO0_TX0 = 0, RX a partir de 4, PIO1 a partir de 8
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return pio_get_index(pio) * 8 + sm + (is_tx ? 0 : 4);
+}
+
+static inline pio_sm_config pio_get_default_sm_config(void) {
+    pio_sm_config c = { .clkdiv = 1.0f, .pull_threshold = 32, .wrap = 31 };
+    return c;
+}
+
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+    c->wrap_target = wrap_target;
+    c->wrap = wrap;
+}
+
+static inline void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {
+    c->out_base = out_base;
+    c->out_count = out_count;
+}
+
+static inline void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count) {
+    c->set_base = set_base;
+    c->set_count = set_count;
+}
+
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {
+    c->sideset_base = sideset_base;
+}
+
+static inline void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+    (void)pindirs;
+    c->sideset_bits = bit_count;
+    c->sideset_opcional = optional;
+}
+
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+    c->clkdiv = div;
+}
+
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {
+    c->fifo_join = join;
+}
+
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    c->out_shift_right = shift_right;
+    c->autopull = autopull;
+    c->pull_threshold = pull_threshold ? pull_threshold : 32;
+}
+
+static inline void sm_config_set_out_special(pio_sm_config *c, bool sticky, bool has_enable_pin, uint enable_pin_index) {
+    (void)c;
+    (void)sticky;
+    (void)has_enable_pin;
+    (void)enable_pin_index;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset);
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_gpio_init(PIO pio, uint pin);
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div);
+void pio_sm_clkdiv_restart(PIO pio, uint sm);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SIM_HARDWARE_STRUCTS_SYSTICK_H
+#define SIM_HARDWARE_STRUCTS_SYSTICK_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t csr;
+    volatile uint32_t rvr;
+    volatile uint32_t cvr;
+    volatile uint32_t calib;
+} systick_hw_t;
+
+// Cada acesso atualiza o contador a partir do relógio do PC, contando para baixo a
+// 125 MHz, então ciclos.h mede tempo real de CPU do PC em "ciclos" equivalentes
+systick_hw_t *sim_systick(void);
+#define systick_hw (sim_systick())
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+// As "IRQs" da simulação só rodam dentro das esperas, então desabilitar
+// interrupções não precisa fazer nada
+static inline uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void)status;
+}
+
+static inline void __dmb(void) {}
+
+void __wfe(void);
+void __wfi(void);
+void __sev(void);
+
+#endif
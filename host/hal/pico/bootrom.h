@@ -0,0 +1,9 @@
+#ifndef SIM_PICO_BOOTROM_H
+#define SIM_PICO_BOOTROM_H
+
+#include "pico/stdlib.h"
+
+// Encerra a simulação (no hardware reinicia no modo de gravação USB)
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask);
+
+#endif
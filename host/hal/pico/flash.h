@@ -0,0 +1,17 @@
+#ifndef SIM_PICO_FLASH_H
+#define SIM_PICO_FLASH_H
+
+#include "pico/stdlib.h"
+
+// Com um núcleo só e sem IRQs de verdade, a operação roda direto
+static inline int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    (void)enter_exit_timeout_ms;
+    func(param);
+    return PICO_OK;
+}
+
+static inline bool flash_safe_execute_core_init(void) {
+    return true;
+}
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef SIM_PICO_MULTICORE_H
+#define SIM_PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+// A simulação roda num núcleo só; chamar isto é erro de configuração
+void multicore_launch_core1(void (*entry)(void));
+
+#endif
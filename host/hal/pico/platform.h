@@ -0,0 +1,30 @@
+#ifndef SIM_PICO_PLATFORM_H
+#define SIM_PICO_PLATFORM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef unsigned int uint;
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+#ifndef MIN
+#define MIN(a, b) ((b) < (a) ? (b) : (a))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) < (b) ? (b) : (a))
+#endif
+
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+
+static inline void tight_loop_contents(void) {}
+
+// Na simulação só existe o núcleo 0 (o firmware é compilado com MATRIZ_DOIS_NUCLEOS=0)
+static inline uint get_core_num(void) {
+    return 0;
+}
+
+void panic(const char *fmt, ...) __attribute__((noreturn));
+
+#endif
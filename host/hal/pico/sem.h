@@ -0,0 +1,18 @@
+#ifndef SIM_PICO_SEM_H
+#define SIM_PICO_SEM_H
+
+#include "pico/stdlib.h"
+
+typedef struct semaphore {
+    volatile int16_t permits;
+    int16_t max_permits;
+} semaphore_t;
+
+void sem_init(semaphore_t *sem, int16_t initial_permits, int16_t max_permits);
+bool sem_release(semaphore_t *sem);
+bool sem_try_acquire(semaphore_t *sem);
+// Avança o tempo virtual até alguma IRQ liberar o semáforo
+void sem_acquire_blocking(semaphore_t *sem);
+int sem_available(semaphore_t *sem);
+
+#endif
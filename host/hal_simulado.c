@@ -0,0 +1,1275 @@
+#include <stdarg.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "simulacao.h"
+#include "emulador_pio.h"
+#include "pico/sem.h"
+#include "pico/multicore.h"
+#include "pico/bootrom.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/adc.h"
+#include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include "hardware/flash.h"
+#include "hardware/structs/systick.h"
+#include "teclado.h"
+
+#define SIM_MAX_EVENTOS 128
+#define SIM_MAX_HANDLERS 8
+#define SIM_FILA_USB 64
+#define SIM_NUM_GPIOS 30
+// Maior transferência para a FIFO (8 faixas paralelas de 256 pixels)
+#define SIM_MAX_PALAVRAS 2048
+
+// ---------------------------------------------------------------------------
+// Relógio virtual e fila de eventos
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    EV_ALARME,
+    EV_TIMER,
+    EV_DMA,
+    EV_TECLA,
+    EV_USB,
+    EV_MICROFONE,
+    EV_FIM,
+} TipoEvento;
+
+typedef struct {
+    bool ativo;
+    TipoEvento tipo;
+    uint64_t prazo;
+    uint32_t ordem;             // Desempate: eventos no mesmo prazo saem na ordem de criação
+    alarm_id_t id;
+    alarm_callback_t alarme;
+    void *dados;
+    repeating_timer_t *timer;
+    uint canal;
+    char tecla;
+    bool pressionar;
+    uint32_t frequencia, amplitude;
+} Evento;
+
+static uint64_t agora_us = 0;
+static Evento eventos[SIM_MAX_EVENTOS];
+static uint32_t proxima_ordem = 0;
+static alarm_id_t proximo_id = 1;
+static bool sinal_sev = false;
+
+static FILE *traco = NULL;
+static jmp_buf salto_fim;
+static ObservadorQuadro observador_quadro = NULL;
+static ObservadorTecla observador_tecla = NULL;
+
+static void rodar_evento(Evento ev);
+static void sincronizar_pwm(void);
+static void verificar_bordas(void);
+static bool amostrar_adc(volatile uint16_t *destino, uint n, bool incremento, uint64_t *duracao_us);
+
+static void registrar(const char *formato, ...) {
+    if (!traco) {
+        return;
+    }
+    va_list args;
+    va_start(args, formato);
+    fprintf(traco, "%llu ", (unsigned long long)agora_us);
+    vfprintf(traco, formato, args);
+    fputc('\n', traco);
+    va_end(args);
+}
+
+static Evento *agendar(TipoEvento tipo, uint64_t prazo) {
+    for (int i = 0; i < SIM_MAX_EVENTOS; i++) {
+        if (!eventos[i].ativo) {
+            eventos[i] = (Evento) { .ativo = true, .tipo = tipo, .prazo = prazo, .ordem = proxima_ordem++ };
+            return &eventos[i];
+        }
+    }
+    panic("simulacao: fila de eventos cheia (%d)", SIM_MAX_EVENTOS);
+}
+
+static Evento *proximo_evento(void) {
+    Evento *melhor = NULL;
+    for (int i = 0; i < SIM_MAX_EVENTOS; i++) {
+        Evento *e = &eventos[i];
+        if (e->ativo && (!melhor || e->prazo < melhor->prazo ||
+                         (e->prazo == melhor->prazo && e->ordem < melhor->ordem))) {
+            melhor = e;
+        }
+    }
+    return melhor;
+}
+
+// Roda o próximo evento se ele vencer até `limite`; senão avança o relógio até
+// `limite`. Retorna true se algum evento rodou (o equivalente a uma IRQ acordar a CPU).
+static bool esperar_evento(uint64_t limite) {
+    sincronizar_pwm();
+    Evento *e = proximo_evento();
+    if (!e || e->prazo > limite) {
+        if (limite > agora_us) {
+            agora_us = limite;
+        }
+        return false;
+    }
+
+    if (e->prazo > agora_us) {
+        agora_us = e->prazo;
+    }
+    Evento copia = *e;
+    e->ativo = false;
+    rodar_evento(copia);
+    sincronizar_pwm();
+    return true;
+}
+
+static void avancar_ate(uint64_t alvo) {
+    while (esperar_evento(alvo)) {
+    }
+}
+
+uint64_t sim_agora_us(void) {
+    return agora_us;
+}
+
+uint64_t time_us_64(void) {
+    return agora_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)agora_us;
+}
+
+absolute_time_t get_absolute_time(void) {
+    return agora_us;
+}
+
+void sleep_until(absolute_time_t t) {
+    avancar_ate(t);
+}
+
+void sleep_us(uint64_t us) {
+    avancar_ate(agora_us + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout) {
+    if (sinal_sev) {
+        sinal_sev = false;
+        return agora_us >= timeout;
+    }
+    if (agora_us >= timeout) {
+        return true;
+    }
+    esperar_evento(timeout);
+    sinal_sev = false;
+    return agora_us >= timeout;
+}
+
+void __wfe(void) {
+    if (sinal_sev) {
+        sinal_sev = false;
+        return;
+    }
+    esperar_evento(UINT64_MAX);
+}
+
+void __wfi(void) {
+    esperar_evento(UINT64_MAX);
+}
+
+void __sev(void) {
+    sinal_sev = true;
+}
+
+// ---------------------------------------------------------------------------
+// Alarmes e timers repetitivos
+// ---------------------------------------------------------------------------
+
+struct alarm_pool {
+    uint max_timers;
+};
+
+alarm_id_t add_alarm_at(absolute_time_t t, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    (void)fire_if_past; // Prazo no passado roda na próxima espera
+    Evento *e = agendar(EV_ALARME, t);
+    e->id = proximo_id++;
+    e->alarme = callback;
+    e->dados = user_data;
+    return e->id;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_at(agora_us + us, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t id) {
+    for (int i = 0; i < SIM_MAX_EVENTOS; i++) {
+        Evento *e = &eventos[i];
+        if (e->ativo && (e->tipo == EV_ALARME || e->tipo == EV_TIMER) && e->id == id) {
+            e->ativo = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+alarm_pool_t *alarm_pool_create_with_unused_hardware_alarm(uint max_timers) {
+    alarm_pool_t *pool = malloc(sizeof(alarm_pool_t));
+    pool->max_timers = max_timers;
+    return pool;
+}
+
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t *pool, int64_t delay_us, repeating_timer_callback_t callback,
+                                       void *user_data, repeating_timer_t *out) {
+    uint64_t periodo = (uint64_t)(delay_us < 0 ? -delay_us : delay_us);
+    *out = (repeating_timer_t) {
+        .delay_us = delay_us, .pool = pool, .callback = callback, .user_data = user_data,
+    };
+    Evento *e = agendar(EV_TIMER, agora_us + periodo);
+    e->id = out->alarm_id = proximo_id++;
+    e->timer = out;
+    return true;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    return alarm_pool_add_repeating_timer_us(NULL, delay_us, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    alarm_id_t id = timer->alarm_id;
+    timer->alarm_id = 0;
+    return id && cancel_alarm(id);
+}
+
+// ---------------------------------------------------------------------------
+// Semáforos, multicore e bootrom
+// ---------------------------------------------------------------------------
+
+void sem_init(semaphore_t *sem, int16_t initial_permits, int16_t max_permits) {
+    sem->permits = initial_permits;
+    sem->max_permits = max_permits;
+}
+
+bool sem_release(semaphore_t *sem) {
+    if (sem->permits >= sem->max_permits) {
+        return false;
+    }
+    sem->permits++;
+    __sev();
+    return true;
+}
+
+bool sem_try_acquire(semaphore_t *sem) {
+    if (sem->permits <= 0) {
+        return false;
+    }
+    sem->permits--;
+    return true;
+}
+
+void sem_acquire_blocking(semaphore_t *sem) {
+    while (sem->permits <= 0) {
+        esperar_evento(UINT64_MAX);
+    }
+    sem->permits--;
+}
+
+int sem_available(semaphore_t *sem) {
+    return sem->permits;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    (void)entry;
+    panic("simulacao: compile o firmware com MATRIZ_DOIS_NUCLEOS=0");
+}
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask) {
+    (void)usb_activity_gpio_pin_mask;
+    (void)disable_interface_mask;
+    longjmp(salto_fim, 1 + SIM_FIM_BOOTSEL);
+}
+
+void panic(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "panic em %llu us: ", (unsigned long long)agora_us);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    exit(2);
+}
+
+static uint32_t hz_sys = 125000000;
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    switch (clk_index) {
+    case clk_sys:
+        return hz_sys;
+    case clk_peri:
+        return 125000000;
+    case clk_usb:
+    case clk_adc:
+        return 48000000;
+    case clk_rtc:
+        return 46875;
+    default:
+        return 12000000;
+    }
+}
+
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq) {
+    (void)src;
+    (void)auxsrc;
+    if (clk_index != clk_sys || freq == 0 || freq > src_freq) {
+        panic("simulacao: clock_configure so para o clk_sys, a partir da fonte");
+    }
+    hz_sys = freq;
+    registrar("CLOCK %lu", (unsigned long)freq);
+    return true;
+}
+
+// SysTick a partir do tempo de CPU do processo no PC, convertido para ciclos de
+// clk_sys: as medições de ciclos.h viram tempo de host em "ciclos" de 125 MHz
+systick_hw_t *sim_systick(void) {
+    static systick_hw_t systick = { .rvr = 0x00FFFFFF };
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    uint64_t ciclos = ns * (clock_get_hz(clk_sys) / 1000000) / 1000;
+    systick.cvr = (uint32_t)(0x00FFFFFF - ciclos) & 0x00FFFFFF;
+    return &systick;
+}
+
+// ---------------------------------------------------------------------------
+// GPIO e teclado
+// ---------------------------------------------------------------------------
+
+static bool gpio_saida[SIM_NUM_GPIOS];
+static bool gpio_valor[SIM_NUM_GPIOS];
+static bool gpio_pullup[SIM_NUM_GPIOS];
+
+// Mesmo layout de teclado.c: tecla [i][j] liga a linha i à coluna j
+static const char teclas[4][4] = {
+    {'1', '2', '3', 'A'},
+    {'4', '5', '6', 'B'},
+    {'7', '8', '9', 'C'},
+    {'*', '0', '#', 'D'}
+};
+static const uint linhas_teclado[4] = {ROW1, ROW2, ROW3, ROW4};
+static const uint colunas_teclado[4] = {COL1, COL2, COL3, COL4};
+static bool pressionada[4][4];
+
+static bool irq_gpio[SIM_NUM_GPIOS];     // Borda de descida habilitada
+static bool nivel_irq[SIM_NUM_GPIOS];    // Último nível visto em cada pino com IRQ
+static gpio_irq_callback_t callback_gpio = NULL;
+
+void gpio_init(uint gpio) {
+    gpio_saida[gpio] = false;
+    gpio_valor[gpio] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    gpio_saida[gpio] = out;
+}
+
+void gpio_put(uint gpio, bool value) {
+    gpio_valor[gpio] = value;
+    verificar_bordas();
+}
+
+void gpio_pull_up(uint gpio) {
+    gpio_pullup[gpio] = true;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    (void)gpio;
+    (void)fn;
+}
+
+// Uma coluna lê 0 quando alguma tecla pressionada a liga a uma linha em nível baixo
+bool gpio_get(uint gpio) {
+    if (gpio_saida[gpio]) {
+        return gpio_valor[gpio];
+    }
+    for (int i = 0; i < 4; i++) {
+        uint linha = linhas_teclado[i];
+        if (!gpio_saida[linha] || gpio_valor[linha]) {
+            continue;
+        }
+        for (int j = 0; j < 4; j++) {
+            if (pressionada[i][j] && colunas_teclado[j] == gpio) {
+                return false;
+            }
+        }
+    }
+    return gpio_pullup[gpio];
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    if (event_mask != GPIO_IRQ_EDGE_FALL) {
+        panic("simulacao: so bordas de descida nas IRQs de GPIO");
+    }
+    // Como no SDK, habilitar descarta uma borda anterior
+    irq_gpio[gpio] = enabled;
+    nivel_irq[gpio] = gpio_get(gpio);
+}
+
+void gpio_set_irq_callback(gpio_irq_callback_t callback) {
+    callback_gpio = callback;
+}
+
+static bool posicao_tecla(char tecla, int *i, int *j) {
+    for (*i = 0; *i < 4; (*i)++) {
+        for (*j = 0; *j < 4; (*j)++) {
+            if (teclas[*i][*j] == tecla) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// stdio: a entrada USB vem do roteiro
+// ---------------------------------------------------------------------------
+
+static char fila_usb[SIM_FILA_USB];
+static uint usb_inicio = 0, usb_fim = 0;
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    uint64_t limite = agora_us + (timeout_us > SIM_CUSTO_POLL_US ? timeout_us : SIM_CUSTO_POLL_US);
+    while (usb_inicio == usb_fim) {
+        if (!esperar_evento(limite)) {
+            return PICO_ERROR_TIMEOUT;
+        }
+    }
+    char c = fila_usb[usb_inicio];
+    usb_inicio = (usb_inicio + 1) % SIM_FILA_USB;
+    return (unsigned char)c;
+}
+
+int stdio_get_until(char *buf, int len, absolute_time_t until) {
+    uint64_t limite = until > agora_us + SIM_CUSTO_POLL_US ? until : agora_us + SIM_CUSTO_POLL_US;
+    while (usb_inicio == usb_fim) {
+        if (!esperar_evento(limite)) {
+            return PICO_ERROR_TIMEOUT;
+        }
+    }
+    int n = 0;
+    while (n < len && usb_inicio != usb_fim) {
+        buf[n++] = fila_usb[usb_inicio];
+        usb_inicio = (usb_inicio + 1) % SIM_FILA_USB;
+    }
+    return n;
+}
+
+// A saída binária (respostas do fluxo de quadros) vai para o traço, não para o terminal
+void stdio_put_string(const char *s, int len, bool newline, bool cr_translation) {
+    (void)newline;
+    (void)cr_translation;
+    char hex[3 * 64 + 1] = "";
+    for (int i = 0; i < len && i < 64; i++) {
+        snprintf(hex + 3 * i, 4, " %02x", (unsigned char)s[i]);
+    }
+    registrar("USB_SAIDA %d :%s", len, hex);
+}
+
+void stdio_flush(void) {
+    fflush(stdout);
+}
+
+// ---------------------------------------------------------------------------
+// IRQs
+// ---------------------------------------------------------------------------
+
+// Handlers de DMA_IRQ_0 e DMA_IRQ_1
+static irq_handler_t handlers_dma[2][SIM_MAX_HANDLERS];
+static uint num_handlers_dma[2] = { 0, 0 };
+
+// Núcleos (bits) com cada IRQ habilitada: a NVIC é de cada núcleo, mas a tabela
+// de vetores é uma só, então uma linha habilitada em dois núcleos roda a cadeia
+// de handlers nos dois ao mesmo tempo
+static uint8_t nucleos_irq[32];
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    uint linha = num - DMA_IRQ_0;
+    if ((num != DMA_IRQ_0 && num != DMA_IRQ_1) || num_handlers_dma[linha] == SIM_MAX_HANDLERS) {
+        panic("simulacao: IRQ %u nao suportada", num);
+    }
+    handlers_dma[linha][num_handlers_dma[linha]++] = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (enabled) {
+        nucleos_irq[num] |= 1u << get_core_num();
+    } else {
+        nucleos_irq[num] &= ~(1u << get_core_num());
+    }
+    if ((num == DMA_IRQ_0 || num == DMA_IRQ_1) && (nucleos_irq[num] & (nucleos_irq[num] - 1))) {
+        panic("simulacao: DMA_IRQ_%u habilitada nos dois nucleos", num - DMA_IRQ_0);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// PIO
+// ---------------------------------------------------------------------------
+
+pio_hw_t sim_pio_hw[NUM_PIOS];
+
+typedef struct {
+    bool usada;
+    bool habilitada;
+    uint pc_inicial;
+    pio_sm_config config;
+} EstadoSm;
+
+static EstadoSm state_machines[NUM_PIOS][NUM_PIO_STATE_MACHINES];
+static uint16_t memoria_instrucoes[NUM_PIOS][32];
+static uint instrucoes_usadas[NUM_PIOS];
+
+int pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset) {
+    uint p = pio_get_index(pio);
+    if (offset + program->length > 32) {
+        panic("simulacao: sem espaco para o programa no pio%u", p);
+    }
+    for (uint i = 0; i < program->length; i++) {
+        uint16_t instr = program->instructions[i];
+        if ((instr >> 13) == 0) {
+            instr += offset; // JMP: o endereço é relativo ao início do programa
+        }
+        memoria_instrucoes[p][offset + i] = instr;
+    }
+    if (offset + program->length > instrucoes_usadas[p]) {
+        instrucoes_usadas[p] = offset + program->length;
+    }
+    return (int)offset;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    return (uint)pio_add_program_at_offset(pio, program, instrucoes_usadas[pio_get_index(pio)]);
+}
+
+// A memória é ocupada em sequência e nunca reaproveitada por outro programa: remover
+// só serve para recarregar o mesmo programa no mesmo lugar
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset) {
+    (void)pio;
+    (void)program;
+    (void)loaded_offset;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    uint p = pio_get_index(pio);
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (!state_machines[p][sm].usada) {
+            state_machines[p][sm].usada = true;
+            return (int)sm;
+        }
+    }
+    if (required) {
+        panic("simulacao: nenhuma state machine livre no pio%u", p);
+    }
+    return -1;
+}
+
+void pio_gpio_init(PIO pio, uint pin) {
+    (void)pio;
+    (void)pin;
+}
+
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+    (void)pio;
+    (void)sm;
+    (void)pin_base;
+    (void)pin_count;
+    (void)is_out;
+}
+
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    EstadoSm *e = &state_machines[pio_get_index(pio)][sm];
+    e->pc_inicial = initial_pc;
+    e->config = *config;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    state_machines[pio_get_index(pio)][sm].habilitada = enabled;
+}
+
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div) {
+    state_machines[pio_get_index(pio)][sm].config.clkdiv = div;
+}
+
+void pio_sm_clkdiv_restart(PIO pio, uint sm) {
+    (void)pio;
+    (void)sm;
+}
+
+bool sim_pio_estado(uint pio, uint sm, const uint16_t **memoria, uint *pc_inicial, pio_sm_config *config) {
+    const EstadoSm *e = &state_machines[pio][sm];
+    *memoria = memoria_instrucoes[pio];
+    *pc_inicial = e->pc_inicial;
+    *config = e->config;
+    return e->habilitada;
+}
+
+// ---------------------------------------------------------------------------
+// PWM
+// ---------------------------------------------------------------------------
+
+pwm_hw_t sim_pwm_hw;
+
+static uint32_t frequencia_registrada[NUM_PWM_SLICES];
+static bool slice_em_pcm[NUM_PWM_SLICES];
+
+void pwm_init(uint slice_num, pwm_config *c, bool start) {
+    pwm_hw->slice[slice_num].div = c->div;
+    pwm_hw->slice[slice_num].top = c->top;
+    pwm_hw->slice[slice_num].cc = 0;
+    pwm_hw->slice[slice_num].csr = c->csr | (start ? 1u : 0u);
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    pwm_hw->slice[slice_num].top = wrap;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    uint32_t cc = pwm_hw->slice[slice_num].cc;
+    uint desloc = chan ? 16 : 0;
+    pwm_hw->slice[slice_num].cc = (cc & ~(0xFFFFu << desloc)) | ((uint32_t)level << desloc);
+}
+
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    pwm_hw->slice[slice_num].div = ((uint32_t)integer << 4) | (fract & 0xF);
+}
+
+// Registra as mudanças de tom. Roda antes de cada avanço do relógio, para que os
+// passos intermediários de uma reconfiguração (divisor, wrap, nível) não apareçam.
+static void sincronizar_pwm(void) {
+    for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+        const pwm_slice_hw_t *hw = &pwm_hw->slice[s];
+        if (!(hw->csr & 1u) || slice_em_pcm[s]) {
+            continue;
+        }
+        uint32_t freq = 0;
+        if (hw->cc != 0 && hw->div != 0) {
+            freq = (uint32_t)((uint64_t)clock_get_hz(clk_sys) * 16 / ((uint64_t)hw->div * (hw->top + 1)));
+        }
+        if (freq != frequencia_registrada[s]) {
+            frequencia_registrada[s] = freq;
+            registrar("BUZZER %lu", (unsigned long)freq);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// DMA
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    bool reservado;
+    bool ocupado;
+    bool irq_habilitada[2];     // DMA_IRQ_0 e DMA_IRQ_1
+    bool irq_pendente[2];
+    uint reconhecimentos[2];    // Fins reconhecidos por um handler, para a conferência
+    bool esperando_adc;         // Disparado com o ADC parado
+    dma_channel_config config;
+    volatile void *escrita;
+    const volatile void *leitura;
+    uint quantidade;
+    int slice_pcm;      // Slice de PWM alimentado por este canal (-1: nenhum)
+} CanalDma;
+
+static CanalDma canais[NUM_DMA_CHANNELS];
+static bool timers_dma_reservados[NUM_DMA_TIMERS];
+static uint32_t fracao_timer[NUM_DMA_TIMERS];
+
+int dma_claim_unused_channel(bool required) {
+    for (int c = 0; c < NUM_DMA_CHANNELS; c++) {
+        if (!canais[c].reservado) {
+            canais[c].reservado = true;
+            canais[c].slice_pcm = -1;
+            return c;
+        }
+    }
+    if (required) {
+        panic("simulacao: nenhum canal de DMA livre");
+    }
+    return -1;
+}
+
+int dma_claim_unused_timer(bool required) {
+    for (int t = 0; t < NUM_DMA_TIMERS; t++) {
+        if (!timers_dma_reservados[t]) {
+            timers_dma_reservados[t] = true;
+            return t;
+        }
+    }
+    if (required) {
+        panic("simulacao: nenhum timer de DMA livre");
+    }
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config c = {
+        .tamanho = DMA_SIZE_32, .read_increment = true, .write_increment = false, .dreq = DREQ_FORCE,
+        .chain_to = channel,
+    };
+    return c;
+}
+
+void dma_timer_set_fraction(uint timer, uint16_t numerator, uint16_t denominator) {
+    fracao_timer[timer] = ((uint32_t)numerator << 16) | denominator;
+}
+
+static void iniciar_canal(uint canal) {
+    CanalDma *c = &canais[canal];
+    uint64_t duracao_us = 0;
+    c->ocupado = true;
+
+    if (c->config.dreq < 8 && (c->config.dreq & 4) == 0) {
+        // FIFO de TX de uma state machine
+        uint p = c->config.dreq / 8, sm = c->config.dreq % 4;
+        uint32_t palavras[SIM_MAX_PALAVRAS];
+        uint n = MIN(c->quantidade, (uint)count_of(palavras));
+        const volatile uint32_t *fonte = c->leitura;
+        for (uint i = 0; i < n; i++) {
+            palavras[i] = fonte[c->config.read_increment ? i : 0];
+        }
+
+        // As palavras passam pelo programa carregado, ciclo a ciclo. O DMA termina
+        // quando a última palavra entra na FIFO, isto é, quando a que está
+        // SIM_PROFUNDIDADE_FIFO posições antes dela é puxada; o quadro termina
+        // quando a state machine trava sem dados.
+        EmuladorPio emulador;
+        const uint16_t *memoria;
+        uint pc;
+        pio_sm_config config;
+        sim_pio_estado(p, sm, &memoria, &pc, &config);
+        emulador_iniciar(&emulador, memoria, pc, &config);
+        emulador_fifo(&emulador, palavras, n);
+        uint64_t ciclo_dma = 0;
+        while (emulador_ciclo(&emulador)) {
+            if (n > SIM_PROFUNDIDADE_FIFO && emulador.fifo_lidas == n - SIM_PROFUNDIDADE_FIFO && !ciclo_dma) {
+                ciclo_dma = emulador.ciclo;
+            }
+        }
+        if (emulador.erro) {
+            panic("simulacao: o programa do pio%u sm%u nao roda no emulador", p, sm);
+        }
+        double ciclo_us = config.clkdiv * 1e6 / clock_get_hz(clk_sys);
+        uint64_t fim = agora_us + (uint64_t)(emulador.ciclo * ciclo_us + 0.5);
+        duracao_us = (uint64_t)(ciclo_dma * ciclo_us + 0.5);
+
+        if (traco) {
+            fprintf(traco, "%llu QUADRO pio%u sm%u %u %llu :", (unsigned long long)agora_us, p, sm, n,
+                    (unsigned long long)fim);
+            for (uint i = 0; i < n; i++) {
+                fprintf(traco, " %08lx", (unsigned long)palavras[i]);
+            }
+            fputc('\n', traco);
+        }
+        if (observador_quadro) {
+            observador_quadro(agora_us, p, sm, palavras, n);
+        }
+    } else if (c->config.dreq >= DREQ_DMA_TIMER0 && c->config.dreq < DREQ_DMA_TIMER0 + NUM_DMA_TIMERS) {
+        // Amostras no ritmo de um timer de DMA: clk_sys * X / Y
+        uint32_t fracao = fracao_timer[c->config.dreq - DREQ_DMA_TIMER0];
+        uint64_t x = fracao >> 16, y = fracao & 0xFFFF;
+        uint32_t taxa = y ? (uint32_t)(clock_get_hz(clk_sys) * x / y) : 0;
+        duracao_us = taxa ? (uint64_t)c->quantidade * 1000000 / taxa : 0;
+
+        c->slice_pcm = -1;
+        for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+            if (c->escrita == &pwm_hw->slice[s].cc) {
+                c->slice_pcm = (int)s;
+                slice_em_pcm[s] = true;
+            }
+        }
+        registrar("PCM %u %lu", c->quantidade, (unsigned long)taxa);
+    } else if (c->config.dreq == DREQ_ADC) {
+        // Amostras do microfone no ritmo do ADC; sem conversões, o canal fica parado
+        c->esperando_adc = !amostrar_adc(c->escrita, c->quantidade, c->config.write_increment, &duracao_us);
+        if (c->esperando_adc) {
+            return;
+        }
+        if (c->config.write_increment) {
+            // Como no hardware, o endereço fica no fim do bloco: rearmar é com o firmware
+            c->escrita = (volatile uint16_t *)c->escrita + c->quantidade;
+        }
+    }
+
+    Evento *e = agendar(EV_DMA, agora_us + duracao_us);
+    e->canal = canal;
+}
+
+static void concluir_canal(uint canal) {
+    CanalDma *c = &canais[canal];
+    c->ocupado = false;
+    if (c->slice_pcm >= 0) {
+        slice_em_pcm[c->slice_pcm] = false;
+        c->slice_pcm = -1;
+    }
+    if (c->config.chain_to != canal) {
+        iniciar_canal(c->config.chain_to);
+    }
+    for (uint linha = 0; linha < 2; linha++) {
+        if (!c->irq_habilitada[linha]) {
+            continue;
+        }
+        c->irq_pendente[linha] = true;
+        if (!nucleos_irq[DMA_IRQ_0 + linha]) {
+            continue; // Fica pendente até a linha ser habilitada
+        }
+        // Cada fim tem que ser atendido por um handler só, uma vez
+        c->reconhecimentos[linha] = 0;
+        for (uint i = 0; i < num_handlers_dma[linha]; i++) {
+            handlers_dma[linha][i]();
+        }
+        if (c->reconhecimentos[linha] != 1) {
+            panic("simulacao: fim do canal %u na DMA_IRQ_%u atendido %u vezes", canal, linha,
+                  c->reconhecimentos[linha]);
+        }
+    }
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    CanalDma *c = &canais[channel];
+    c->config = *config;
+    c->escrita = write_addr;
+    c->leitura = read_addr;
+    c->quantidade = transfer_count;
+    if (trigger) {
+        iniciar_canal(channel);
+    }
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) {
+    canais[channel].leitura = read_addr;
+    if (trigger) {
+        iniciar_canal(channel);
+    }
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger) {
+    canais[channel].escrita = write_addr;
+    if (trigger) {
+        iniciar_canal(channel);
+    }
+}
+
+void dma_start_channel_mask(uint32_t chan_mask) {
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+        if (chan_mask & (1u << c)) {
+            iniciar_canal(c);
+        }
+    }
+}
+
+void dma_channel_abort(uint channel) {
+    for (int i = 0; i < SIM_MAX_EVENTOS; i++) {
+        if (eventos[i].ativo && eventos[i].tipo == EV_DMA && eventos[i].canal == channel) {
+            eventos[i].ativo = false;
+        }
+    }
+    CanalDma *c = &canais[channel];
+    c->ocupado = false;
+    c->esperando_adc = false;
+    if (c->slice_pcm >= 0) {
+        slice_em_pcm[c->slice_pcm] = false;
+        c->slice_pcm = -1;
+    }
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return canais[channel].ocupado;
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    canais[channel].irq_habilitada[0] = enabled;
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    return canais[channel].irq_pendente[0];
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    canais[channel].reconhecimentos[0] += canais[channel].irq_pendente[0];
+    canais[channel].irq_pendente[0] = false;
+}
+
+void dma_channel_set_irq1_enabled(uint channel, bool enabled) {
+    canais[channel].irq_habilitada[1] = enabled;
+}
+
+bool dma_channel_get_irq1_status(uint channel) {
+    return canais[channel].irq_pendente[1];
+}
+
+void dma_channel_acknowledge_irq1(uint channel) {
+    canais[channel].reconhecimentos[1] += canais[channel].irq_pendente[1];
+    canais[channel].irq_pendente[1] = false;
+}
+
+// ---------------------------------------------------------------------------
+// ADC e microfone
+// ---------------------------------------------------------------------------
+
+#define ADC_CLOCK_HZ 48000000
+#define ADC_CICLOS_MIN 96           // Uma conversão leva 96 ciclos do clk_adc
+#define ADC_MEIO 2048
+
+adc_hw_t sim_adc_hw;
+static bool adc_rodando = false;
+static float adc_divisor = 0;
+static uint32_t microfone_hz = 0, microfone_amplitude = 0;
+static uint64_t amostras_adc = 0;   // Desde o boot, para a fase do seno não pular entre blocos
+static uint32_t ruido_adc = 1;
+
+void adc_init(void) {
+    adc_rodando = false;
+}
+
+void adc_gpio_init(uint gpio) {
+    if (gpio < 26 || gpio > 29) {
+        panic("simulacao: GPIO %u nao tem ADC", gpio);
+    }
+}
+
+void adc_select_input(uint input) {
+    (void)input;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    if (!en || !dreq_en || err_in_fifo || byte_shift) {
+        panic("simulacao: so a FIFO do ADC com DREQ e amostras de 12 bits");
+    }
+    (void)dreq_thresh;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    adc_divisor = clkdiv;
+}
+
+void adc_run(bool run) {
+    adc_rodando = run;
+    if (!run) {
+        return;
+    }
+    // Canais disparados antes das conversões começam agora
+    for (uint canal = 0; canal < NUM_DMA_CHANNELS; canal++) {
+        if (canais[canal].esperando_adc) {
+            iniciar_canal(canal);
+        }
+    }
+}
+
+void adc_fifo_drain(void) {
+}
+
+// Preenche n amostras do microfone (um seno do roteiro em volta do meio da
+// escala, com alguns LSB de ruído) e retorna quanto tempo o ADC leva para
+// convertê-las; sem conversões rodando, retorna false e não escreve nada
+static bool amostrar_adc(volatile uint16_t *destino, uint n, bool incremento, uint64_t *duracao_us) {
+    if (!adc_rodando) {
+        return false;
+    }
+    float ciclos = adc_divisor + 1 > ADC_CICLOS_MIN ? adc_divisor + 1 : ADC_CICLOS_MIN;
+    uint32_t taxa = (uint32_t)(ADC_CLOCK_HZ / ciclos);
+    for (uint i = 0; i < n; i++) {
+        double fase = 2 * 3.14159265358979 * microfone_hz * (double)amostras_adc++ / taxa;
+        ruido_adc = ruido_adc * 1103515245 + 12345;
+        int ruido = (int)((ruido_adc >> 16) % 5) - 2;
+        int v = ADC_MEIO + (int)lround(microfone_amplitude * sin(fase)) + ruido;
+        destino[incremento ? i : 0] = (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : v);
+    }
+    *duracao_us = (uint64_t)n * 1000000 / taxa;
+    registrar("ADC %u %lu", n, (unsigned long)taxa);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Flash: um arquivo mapeado (ou memória), que o firmware lê como a XIP
+// ---------------------------------------------------------------------------
+
+static uint8_t *flash_xip = NULL;
+static bool flash_mapeada = false;
+static int flash_restantes = -1;    // Operações até o corte de energia (-1: sem corte)
+
+const uint8_t *sim_flash_xip(void) {
+    if (!flash_xip) {
+        flash_xip = malloc(PICO_FLASH_SIZE_BYTES);
+        memset(flash_xip, 0xFF, PICO_FLASH_SIZE_BYTES);
+    }
+    return flash_xip;
+}
+
+bool sim_flash_arquivo(const char *caminho) {
+    int fd = open(caminho, O_RDWR | O_CREAT, 0644);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        return false;
+    }
+    off_t tamanho = st.st_size < PICO_FLASH_SIZE_BYTES ? st.st_size : PICO_FLASH_SIZE_BYTES;
+    if (st.st_size < PICO_FLASH_SIZE_BYTES && ftruncate(fd, PICO_FLASH_SIZE_BYTES) != 0) {
+        close(fd);
+        return false;
+    }
+    uint8_t *m = mmap(NULL, PICO_FLASH_SIZE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) {
+        return false;
+    }
+    memset(m + tamanho, 0xFF, PICO_FLASH_SIZE_BYTES - tamanho); // Arquivo novo: flash apagada
+
+    if (flash_xip && !flash_mapeada) {
+        free(flash_xip);
+    } else if (flash_xip) {
+        munmap(flash_xip, PICO_FLASH_SIZE_BYTES);
+    }
+    flash_xip = m;
+    flash_mapeada = true;
+    return true;
+}
+
+void sim_flash_cortar(int operacoes) {
+    flash_restantes = operacoes;
+}
+
+// Quantos bytes a operação chega a mudar: todos, metade (a do corte) ou nenhum
+static size_t flash_aplicar(size_t count) {
+    if (flash_restantes < 0) {
+        return count;
+    }
+    if (flash_restantes == 0) {
+        return 0;
+    }
+    return --flash_restantes == 0 ? count / 2 : count;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        panic("simulacao: apagar %u bytes em 0x%x fora dos setores", (unsigned)count, flash_offs);
+    }
+    sim_flash_xip();
+    memset(flash_xip + flash_offs, 0xFF, flash_aplicar(count));
+    registrar("FLASH apaga %u %u", flash_offs, (unsigned)count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        panic("simulacao: gravar %u bytes em 0x%x fora das paginas", (unsigned)count, flash_offs);
+    }
+    sim_flash_xip();
+    size_t n = flash_aplicar(count);
+    for (size_t i = 0; i < n; i++) {
+        flash_xip[flash_offs + i] &= data[i]; // NOR: gravar só zera bits
+    }
+    registrar("FLASH grava %u %u", flash_offs, (unsigned)count);
+}
+
+// ---------------------------------------------------------------------------
+// Eventos de entrada e execução
+// ---------------------------------------------------------------------------
+
+// Bordas de descida nos pinos com IRQ, depois de uma tecla ou de uma linha mudar
+static void verificar_bordas(void) {
+    if (!callback_gpio || !nucleos_irq[IO_IRQ_BANK0]) {
+        return;
+    }
+    for (uint g = 0; g < SIM_NUM_GPIOS; g++) {
+        if (!irq_gpio[g]) {
+            continue;
+        }
+        bool nivel = gpio_get(g);
+        bool antes = nivel_irq[g];
+        nivel_irq[g] = nivel;
+        if (antes && !nivel) {
+            registrar("BORDA %u", g);
+            callback_gpio(g, GPIO_IRQ_EDGE_FALL);
+        }
+    }
+}
+
+static void rodar_evento(Evento ev) {
+    switch (ev.tipo) {
+    case EV_ALARME: {
+        int64_t r = ev.alarme(ev.id, ev.dados);
+        if (r != 0) {
+            // Positivo: a partir de agora; negativo: a partir do prazo anterior
+            Evento *e = agendar(EV_ALARME, r > 0 ? agora_us + (uint64_t)r : ev.prazo + (uint64_t)-r);
+            e->id = ev.id;
+            e->alarme = ev.alarme;
+            e->dados = ev.dados;
+        }
+        break;
+    }
+    case EV_TIMER: {
+        repeating_timer_t *t = ev.timer;
+        bool continuar = t->callback(t);
+        if (continuar && t->alarm_id == ev.id) {
+            uint64_t prazo = t->delay_us < 0 ? ev.prazo + (uint64_t)-t->delay_us : agora_us + (uint64_t)t->delay_us;
+            Evento *e = agendar(EV_TIMER, prazo);
+            e->id = ev.id;
+            e->timer = t;
+        } else if (t->alarm_id == ev.id) {
+            t->alarm_id = 0;
+        }
+        break;
+    }
+    case EV_DMA:
+        concluir_canal(ev.canal);
+        break;
+    case EV_TECLA: {
+        int i, j;
+        if (posicao_tecla(ev.tecla, &i, &j)) {
+            pressionada[i][j] = ev.pressionar;
+        }
+        registrar("TECLA %c %s", ev.tecla, ev.pressionar ? "pressionada" : "solta");
+        verificar_bordas();
+        if (observador_tecla) {
+            observador_tecla(agora_us, ev.tecla, ev.pressionar);
+        }
+        break;
+    }
+    case EV_USB:
+        registrar("USB %c", ev.tecla);
+        if ((usb_fim + 1) % SIM_FILA_USB != usb_inicio) {
+            fila_usb[usb_fim] = ev.tecla;
+            usb_fim = (usb_fim + 1) % SIM_FILA_USB;
+        }
+        if (observador_tecla) {
+            observador_tecla(agora_us, ev.tecla, true);
+        }
+        break;
+    case EV_MICROFONE:
+        registrar("MICROFONE %lu %lu", (unsigned long)ev.frequencia, (unsigned long)ev.amplitude);
+        microfone_hz = ev.frequencia;
+        microfone_amplitude = ev.amplitude;
+        break;
+    case EV_FIM:
+        longjmp(salto_fim, 1 + SIM_FIM_ROTEIRO);
+    }
+}
+
+void sim_iniciar(FILE *saida_traco) {
+    traco = saida_traco;
+}
+
+void sim_observar_quadros(ObservadorQuadro f) {
+    observador_quadro = f;
+}
+
+void sim_observar_teclas(ObservadorTecla f) {
+    observador_tecla = f;
+}
+
+void sim_tecla(uint64_t tempo_us, char tecla, uint32_t duracao_ms) {
+    Evento *e = agendar(EV_TECLA, tempo_us);
+    e->tecla = tecla;
+    e->pressionar = true;
+    e = agendar(EV_TECLA, tempo_us + (uint64_t)duracao_ms * 1000);
+    e->tecla = tecla;
+    e->pressionar = false;
+}
+
+void sim_usb(uint64_t tempo_us, char c) {
+    Evento *e = agendar(EV_USB, tempo_us);
+    e->tecla = c;
+}
+
+void sim_microfone(uint64_t tempo_us, uint32_t frequencia_hz, uint32_t amplitude) {
+    Evento *e = agendar(EV_MICROFONE, tempo_us);
+    e->frequencia = frequencia_hz;
+    e->amplitude = amplitude;
+}
+
+void sim_fim(uint64_t tempo_us) {
+    agendar(EV_FIM, tempo_us);
+}
+
+bool sim_carregar_roteiro(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        fprintf(stderr, "%s: nao foi possivel abrir\n", caminho);
+        return false;
+    }
+
+    char linha[128];
+    int numero = 0;
+    bool ok = true;
+    while (ok && fgets(linha, sizeof(linha), f)) {
+        numero++;
+        const char *inicio = linha + strspn(linha, " \t");
+        if (*inicio == '#') {
+            continue; // Comentário ('#' no meio da linha é a tecla)
+        }
+
+        unsigned long ms, duracao;
+        char comando[16], c;
+        int campos = sscanf(linha, "%lu %15s %c %lu", &ms, comando, &c, &duracao);
+        if (campos <= 0) {
+            continue; // Linha vazia
+        }
+        uint64_t t = (uint64_t)ms * 1000;
+        if (campos >= 3 && strcmp(comando, "texto") == 0) {
+            // O resto da linha vai pelo USB depois de um 't', terminado em '\n'
+            const char *texto = strstr(linha, "texto") + strlen("texto");
+            texto += strspn(texto, " \t");
+            sim_usb(t, 't');
+            for (; *texto && *texto != '\n' && *texto != '\r'; texto++) {
+                sim_usb(t, *texto);
+            }
+            sim_usb(t, '\n');
+        } else if (campos == 4 && strcmp(comando, "tecla") == 0) {
+            sim_tecla(t, c, (uint32_t)duracao);
+        } else if (campos >= 3 && strcmp(comando, "usb") == 0) {
+            sim_usb(t, c);
+        } else if (campos >= 2 && strcmp(comando, "microfone") == 0) {
+            unsigned long hz, amplitude;
+            if (sscanf(linha, "%lu %15s %lu %lu", &ms, comando, &hz, &amplitude) != 4) {
+                fprintf(stderr, "%s:%d: linha invalida\n", caminho, numero);
+                ok = false;
+                continue;
+            }
+            sim_microfone(t, (uint32_t)hz, (uint32_t)amplitude);
+        } else if (campos == 2 && strcmp(comando, "fim") == 0) {
+            sim_fim(t);
+        } else {
+            fprintf(stderr, "%s:%d: linha invalida\n", caminho, numero);
+            ok = false;
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+MotivoFim sim_executar(int (*entrada)(void)) {
+    int r = setjmp(salto_fim);
+    if (r == 0) {
+        entrada();
+        return SIM_FIM_ROTEIRO;
+    }
+    if (traco) {
+        fflush(traco);
+    }
+    return (MotivoFim)(r - 1);
+}
@@ -0,0 +1,151 @@
+// Fluxo de quadros sem placa: um pty faz o papel da porta USB. Uma thread roda a
+// sessão do firmware (fluxo_sessao de fluxo_usb.c) no lado escravo, com uma saída
+// simulada que leva o tempo de um quadro WS2812 (30 us por pixel + reset) e confere
+// cada quadro publicado; o lado mestre é o mesmo remetente do enviar_quadros.
+//
+//   loopback_fluxo [quadros] [fps] [pixels]    (retorna 1 se algum quadro chegar errado)
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "fluxo_usb.h"
+#include "fluxo_pc.h"
+#include "saida_led.h"
+
+#define US_POR_PIXEL 30
+#define CORROMPER 50
+
+static int escravo;
+static uint num_pixels = NUM_PIXELS;
+
+// Saída simulada: buffer duplo e fim da transmissão em andamento
+static uint32_t buffers[2][SAIDA_MAX_PIXELS];
+static uint atras = 0;
+static double fim_transmissao_us = 0;
+static uint32_t publicados = 0, errados = 0;
+
+static double agora_us(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+static int ler_pty(uint8_t *buf, int n, uint32_t timeout_us) {
+    struct pollfd p = { .fd = escravo, .events = POLLIN };
+    if (poll(&p, 1, (int)(timeout_us / 1000)) <= 0) {
+        return 0;
+    }
+    ssize_t r = read(escravo, buf, (size_t)n);
+    return r > 0 ? (int)r : 0;
+}
+
+static void escrever_pty(const uint8_t *buf, int n) {
+    while (n > 0) {
+        ssize_t w = write(escravo, buf, (size_t)n);
+        if (w <= 0) {
+            return;
+        }
+        buf += w;
+        n -= (int)w;
+    }
+}
+
+static uint32_t *quadro_simulado(void) {
+    return buffers[atras];
+}
+
+static uint num_pixels_simulado(void) {
+    return num_pixels;
+}
+
+// Como saida_led_enviar: espera o quadro anterior e o reset, troca e "transmite"
+static void publicar_simulado(void) {
+    // O remetente estraga o quadro CORROMPER-1 de cada CORROMPER, que não chega aqui
+    uint32_t seq = publicados + publicados / (CORROMPER - 1);
+    for (uint i = 0; i < num_pixels; i++) {
+        if (buffers[atras][i] != fluxo_padrao(seq, i)) {
+            errados++;
+            break;
+        }
+    }
+    publicados++;
+
+    double agora = agora_us();
+    if (agora < fim_transmissao_us) {
+        usleep((useconds_t)(fim_transmissao_us - agora));
+        agora = fim_transmissao_us;
+    }
+    fim_transmissao_us = agora + num_pixels * US_POR_PIXEL + TEMPO_RESET_US;
+    atras ^= 1;
+}
+
+static const PortaFluxo porta_pty = {
+    .ler = ler_pty,
+    .escrever = escrever_pty,
+    .quadro = quadro_simulado,
+    .num_pixels = num_pixels_simulado,
+    .publicar = publicar_simulado,
+};
+
+// O "firmware": espera o 's' do laço principal e roda uma sessão
+static void *pico(void *arg) {
+    uint8_t c = 0;
+    while (c != 's') {
+        if (ler_pty(&c, 1, 100000) == 0) {
+            c = 0;
+        }
+    }
+    EstatisticasFluxo e;
+    fluxo_sessao(&porta_pty, &e);
+    *(EstatisticasFluxo *)arg = e;
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    OpcoesEnvio opcoes = {
+        .quadros = argc > 1 ? (uint32_t)atoi(argv[1]) : 2000,
+        .fps = argc > 2 ? (uint32_t)atoi(argv[2]) : 0,
+        .corromper = CORROMPER,
+    };
+    if (argc > 3) {
+        num_pixels = (uint)atoi(argv[3]);
+        if (num_pixels == 0 || num_pixels > SAIDA_MAX_PIXELS) {
+            fprintf(stderr, "pixels: 1 a %d\n", SAIDA_MAX_PIXELS);
+            return 1;
+        }
+    }
+
+    int mestre = posix_openpt(O_RDWR | O_NOCTTY);
+    if (mestre < 0 || grantpt(mestre) != 0 || unlockpt(mestre) != 0) {
+        perror("pty");
+        return 1;
+    }
+    escravo = open(ptsname(mestre), O_RDWR | O_NOCTTY);
+    if (escravo < 0 || !fluxo_modo_bruto(escravo) || !fluxo_modo_bruto(mestre)) {
+        perror("pty");
+        return 1;
+    }
+
+    EstatisticasFluxo e;
+    pthread_t thread;
+    pthread_create(&thread, NULL, pico, &e);
+
+    ResultadoEnvio r;
+    bool ok = fluxo_enviar(mestre, &opcoes, &r);
+    pthread_join(thread, NULL);
+    if (!ok) {
+        return 1;
+    }
+
+    fluxo_imprimir(&r);
+    printf("Pico: %u publicados, %u rejeitados, %u com pixels errados (tempo de saida %u us/quadro)\n",
+           e.quadros, e.rejeitados, errados, num_pixels * US_POR_PIXEL + TEMPO_RESET_US);
+    uint32_t esperados = opcoes.quadros / CORROMPER;
+    bool certo = errados == 0 && e.quadros == r.aceitos && e.rejeitados == esperados && r.rejeitados == esperados;
+    printf("%s\n", certo ? "OK" : "FALHOU");
+    return certo ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+#ifndef SIMULACAO_H
+#define SIMULACAO_H
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Simulação do firmware no PC: o HAL de host/hal roda sobre um relógio virtual,
+// e as "IRQs" (alarmes, timers, fim de DMA) são executadas dentro das esperas do
+// firmware (sleep, WFE, semáforo, getchar), na ordem dos prazos. O tempo de CPU
+// do firmware não conta no relógio virtual; só as esperas o avançam.
+
+// Custo de cada getchar_timeout_us(0) sem caractere, no tempo virtual: evita que o
+// laço principal gire sem o tempo andar
+#define SIM_CUSTO_POLL_US 10
+
+// Profundidade da FIFO de TX juntada: palavras que ainda saem depois do fim do DMA
+#define SIM_PROFUNDIDADE_FIFO 8
+
+typedef enum {
+    SIM_FIM_ROTEIRO,    // Chegou a linha "fim" do roteiro
+    SIM_FIM_BOOTSEL,    // O firmware chamou reset_usb_boot ('*')
+} MotivoFim;
+
+// Linhas do traço, uma por evento: "<tempo_us> <EVENTO> <dados>"
+//   QUADRO pio<n> sm<n> <palavras> <fim_us> : <palavras em hex>
+//   BUZZER <Hz>          (0 = mudo)
+//   PCM <amostras> <Hz>
+//   TECLA <c> <pressionada|solta>
+//   USB <c>
+//   USB_SAIDA <bytes> : <bytes em hex>   (saída binária, ex.: respostas do fluxo)
+//   CLOCK <Hz>           (novo clk_sys)
+//   BORDA <gpio>         (borda de descida com a IRQ habilitada)
+//   FLASH <apaga|grava> <deslocamento> <bytes>
+//   ADC <amostras> <Hz>  (um bloco do DMA do ADC)
+//   MICROFONE <Hz> <amplitude>
+void sim_iniciar(FILE *traco);
+
+uint64_t sim_agora_us(void);
+
+// Eventos de entrada, no tempo virtual
+void sim_tecla(uint64_t tempo_us, char tecla, uint32_t duracao_ms);
+void sim_usb(uint64_t tempo_us, char c);
+// Seno no microfone a partir de tempo_us (amplitude em LSB do ADC; 0 = silêncio)
+void sim_microfone(uint64_t tempo_us, uint32_t frequencia_hz, uint32_t amplitude);
+void sim_fim(uint64_t tempo_us);
+
+// Roteiro em texto, uma linha por evento (tempos em ms; linhas que começam com
+// '#' são comentários):
+//   <ms> tecla <c> <duração_ms>
+//   <ms> usb <c>
+//   <ms> texto <texto até o fim da linha>   ('t', o texto e '\n' pelo USB)
+//   <ms> microfone <Hz> <amplitude>
+//   <ms> fim
+// Retorna false se o arquivo não abrir ou tiver uma linha inválida.
+bool sim_carregar_roteiro(const char *caminho);
+
+// Observadores chamados no contexto da simulação
+typedef void (*ObservadorQuadro)(uint64_t tempo_us, uint pio, uint sm, const uint32_t *palavras, uint num_palavras);
+typedef void (*ObservadorTecla)(uint64_t tempo_us, char tecla, bool pressionada);
+void sim_observar_quadros(ObservadorQuadro f);
+void sim_observar_teclas(ObservadorTecla f);
+
+// Roda `entrada` (o main do firmware) até o fim do roteiro ou o modo de gravação
+MotivoFim sim_executar(int (*entrada)(void));
+
+// Programa e configuração de uma state machine, como o firmware a deixou
+// (memória com os endereços de JMP já absolutos). Retorna se ela está habilitada.
+bool sim_pio_estado(uint pio, uint sm, const uint16_t **memoria, uint *pc_inicial, pio_sm_config *config);
+
+// Flash simulada (hardware/flash.h): sem arquivo, começa apagada em memória. Com
+// arquivo, o conteúdo persiste entre execuções (o arquivo é criado se faltar).
+bool sim_flash_arquivo(const char *caminho);
+
+// Simula uma falta de energia: depois de `operacoes` apagamentos/gravações, a
+// seguinte só muda metade dos bytes e as outras não mudam nada (-1: desliga)
+void sim_flash_cortar(int operacoes);
+
+// main() de matriz_led.c, renomeado na compilação para o host
+int firmware_main(void);
+
+#endif
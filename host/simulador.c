@@ -0,0 +1,54 @@
+// Roda o firmware no PC seguindo um roteiro de teclas e comandos USB e grava o
+// traço (quadros, tons, teclas) com os tempos virtuais.
+//
+//   simulador <roteiro> [traço] [flash]     (sem traço: só o resumo)
+//
+// Com [flash], a flash simulada fica nesse arquivo e o acervo (acervo.h) gravado
+// por um roteiro continua lá na execução seguinte.
+#include <stdlib.h>
+#include "simulacao.h"
+
+static uint32_t quadros = 0;
+static uint64_t palavras = 0;
+
+static void contar_quadro(uint64_t tempo_us, uint pio, uint sm, const uint32_t *dados, uint num_palavras) {
+    quadros++;
+    palavras += num_palavras;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s <roteiro> [traco] [flash]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *traco = NULL;
+    if (argc > 2) {
+        traco = fopen(argv[2], "w");
+        if (!traco) {
+            fprintf(stderr, "%s: nao foi possivel criar\n", argv[2]);
+            return 1;
+        }
+    }
+
+    if (argc > 3 && !sim_flash_arquivo(argv[3])) {
+        fprintf(stderr, "%s: nao foi possivel abrir a flash\n", argv[3]);
+        return 1;
+    }
+
+    sim_iniciar(traco);
+    sim_observar_quadros(contar_quadro);
+    if (!sim_carregar_roteiro(argv[1])) {
+        return 1;
+    }
+
+    MotivoFim motivo = sim_executar(firmware_main);
+
+    fprintf(stderr, "\nFim (%s) em %.3f s: %lu quadros enviados, %llu palavras\n",
+            motivo == SIM_FIM_BOOTSEL ? "modo gravacao" : "roteiro", sim_agora_us() / 1e6,
+            (unsigned long)quadros, (unsigned long long)palavras);
+    if (traco) {
+        fclose(traco);
+    }
+    return 0;
+}
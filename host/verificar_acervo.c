@@ -0,0 +1,327 @@
+// Confere o acervo da flash (acervo.h) na flash simulada: uma carga aleatória de
+// gravações e apagamentos contra um modelo em RAM, com reinicializações no meio;
+// faltas de energia em cada operação da flash (depois delas o acervo tem que ter a
+// versão antiga ou a nova de cada id, nunca outra coisa); o desgaste dos setores;
+// e a sessão pelo USB num pty, com o mesmo remetente do gravar_animacao.
+//
+//   verificar_acervo [operacoes]      (retorna 1 se algum caso falhar)
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "simulacao.h"
+#include "acervo.h"
+#include "acervo_pc.h"
+#include "fluxo_pc.h"
+#include "raster.h"
+
+#define REINICIAR_A_CADA 37
+#define CORTES 400
+#define MAX_OPERACOES_CORTE 24      // Apagar e copiar um setor inteiro cabe aqui
+
+typedef struct {
+    bool cheio;
+    uint8_t fps;
+    uint16_t r, g, b;
+    uint16_t num_quadros;
+    uint8_t quadros[ACERVO_MAX_QUADROS][BYTES_POR_QUADRO];
+} Versao;
+
+static Versao modelo[ACERVO_MAX_ANIMACOES];
+static uint32_t semente = 12345;
+static uint falhas = 0;
+
+static uint32_t aleatorio(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+// Animações pequenas na maioria, algumas do tamanho de um setor, alguns apagamentos
+static void sortear(Versao *v) {
+    uint sorteio = aleatorio() % 20;
+    v->cheio = sorteio != 0;
+    v->num_quadros = !v->cheio ? 0
+                   : sorteio == 1 ? ACERVO_MAX_QUADROS
+                   : 1 + aleatorio() % (sorteio < 5 ? ACERVO_MAX_QUADROS : 40);
+    v->fps = (uint8_t)(1 + aleatorio() % 30);
+    v->r = (uint16_t)aleatorio();
+    v->g = (uint16_t)aleatorio();
+    v->b = (uint16_t)aleatorio();
+    for (uint q = 0; q < v->num_quadros; q++) {
+        for (uint i = 0; i < BYTES_POR_QUADRO; i++) {
+            v->quadros[q][i] = (uint8_t)aleatorio();
+        }
+    }
+}
+
+static bool gravar(uint id, const Versao *v) {
+    return acervo_gravar(id, v->fps, v->r, v->g, v->b, (const uint8_t (*)[BYTES_POR_QUADRO])v->quadros,
+                         v->num_quadros);
+}
+
+static bool igual(const Animacao *a, const Versao *v) {
+    if (!v->cheio || !a) {
+        return !v->cheio && !a;
+    }
+    const uint8_t *inicio = sim_flash_xip() + ACERVO_INICIO;
+    const uint8_t *quadros = (const uint8_t *)a->frames;
+    return a->num_frames == v->num_quadros && a->fps == v->fps && a->r == v->r && a->g == v->g
+        && a->b == v->b && quadros >= inicio && quadros < inicio + ACERVO_TAMANHO // Direto da XIP
+        && memcmp(a->frames, v->quadros, (size_t)v->num_quadros * BYTES_POR_QUADRO) == 0;
+}
+
+// Animação do id no acervo, ou NULL
+static const Animacao *ler(uint id, Animacao *a) {
+    return acervo_animacao(id, a) ? a : NULL;
+}
+
+static void conferir(const char *quando, uint operacao) {
+    for (uint id = 0; id < ACERVO_MAX_ANIMACOES; id++) {
+        Animacao a;
+        if (!igual(ler(id, &a), &modelo[id])) {
+            printf("  %s, operacao %u: id %u diferente do modelo\n", quando, operacao, id);
+            falhas++;
+            return;
+        }
+    }
+}
+
+// Gravações e apagamentos aleatórios, reiniciando de tempos em tempos
+static void carga(uint operacoes) {
+    static Versao v;
+    uint32_t lidos_max = 0;
+    for (uint n = 0; n < operacoes; n++) {
+        uint id = aleatorio() % ACERVO_MAX_ANIMACOES;
+        sortear(&v);
+        if (!gravar(id, &v)) {
+            printf("  operacao %u: gravacao do id %u recusada\n", n, id);
+            falhas++;
+            return;
+        }
+        modelo[id] = v;
+        conferir("depois de gravar", n);
+
+        if (n % REINICIAR_A_CADA == REINICIAR_A_CADA - 1) {
+            acervo_init();
+            conferir("depois de reiniciar", n);
+            EstadoAcervo e;
+            acervo_estado(&e);
+            lidos_max = e.registros_lidos_boot > lidos_max ? e.registros_lidos_boot : lidos_max;
+        }
+    }
+
+    EstadoAcervo e;
+    acervo_estado(&e);
+    printf("Carga: %u operacoes, geracao %lu, %lu registros movidos, no maximo %lu registros lidos no boot, "
+           "apagamentos por setor %lu a %lu\n", operacoes, (unsigned long)e.geracao,
+           (unsigned long)e.registros_movidos, (unsigned long)lidos_max, (unsigned long)e.apagamentos_min,
+           (unsigned long)e.apagamentos_max);
+    if (e.apagamentos_max - e.apagamentos_min > 2) {
+        printf("  desgaste desigual entre os setores\n");
+        falhas++;
+    }
+}
+
+// Corta a energia depois de k operações da flash numa gravação e reinicia: o id
+// gravado fica com a versão antiga ou a nova, e os outros não mudam
+static void cortes(void) {
+    static Versao v, antiga;
+    uint novas = 0, antigas = 0;
+    for (uint n = 0; n < CORTES; n++) {
+        uint id = aleatorio() % ACERVO_MAX_ANIMACOES;
+        sortear(&v);
+        antiga = modelo[id];
+
+        sim_flash_cortar((int)(aleatorio() % MAX_OPERACOES_CORTE));
+        gravar(id, &v);
+        sim_flash_cortar(-1);
+        acervo_init();
+
+        Animacao copia;
+        const Animacao *a = ler(id, &copia);
+        if (igual(a, &v)) {
+            modelo[id] = v;
+            novas++;
+        } else if (igual(a, &antiga)) {
+            antigas++;
+        } else {
+            printf("  corte %u: id %u nao e nem a versao antiga nem a nova\n", n, id);
+            falhas++;
+            return;
+        }
+        conferir("depois do corte", n);
+
+        // O acervo continua gravando depois da falta de energia
+        sortear(&v);
+        id = aleatorio() % ACERVO_MAX_ANIMACOES;
+        if (!gravar(id, &v)) {
+            printf("  corte %u: gravacao seguinte recusada\n", n);
+            falhas++;
+            return;
+        }
+        modelo[id] = v;
+        conferir("gravando depois do corte", n);
+    }
+    printf("Faltas de energia: %u, %u com a versao nova e %u com a antiga\n", CORTES, novas, antigas);
+}
+
+// ---------------------------------------------------------------------------
+// Sessão pelo USB num pty
+// ---------------------------------------------------------------------------
+
+static int escravo;
+
+static int ler_pty(uint8_t *buf, int n, uint32_t timeout_us) {
+    struct pollfd p = { .fd = escravo, .events = POLLIN };
+    if (poll(&p, 1, (int)(timeout_us / 1000)) <= 0) {
+        return 0;
+    }
+    ssize_t r = read(escravo, buf, (size_t)n);
+    return r > 0 ? (int)r : 0;
+}
+
+static void escrever_pty(const uint8_t *buf, int n) {
+    while (n > 0) {
+        ssize_t w = write(escravo, buf, (size_t)n);
+        if (w <= 0) {
+            return;
+        }
+        buf += w;
+        n -= (int)w;
+    }
+}
+
+static const PortaFluxo porta_pty = {
+    .ler = ler_pty,
+    .escrever = escrever_pty,
+};
+
+// O "firmware": espera o 'u' do laço principal e roda uma sessão
+static void *pico(void *arg) {
+    uint8_t c = 0;
+    while (c != 'u') {
+        if (ler_pty(&c, 1, 100000) == 0) {
+            c = 0;
+        }
+    }
+    *(bool *)arg = acervo_sessao(&porta_pty);
+    return NULL;
+}
+
+// Retorna o que o remetente achou da resposta; pico_ok é o retorno de acervo_sessao
+static bool sessao(int mestre, bool (*remetente)(int, const Versao *), const Versao *v, bool *pico_ok) {
+    *pico_ok = false;
+    pthread_t thread;
+    pthread_create(&thread, NULL, pico, pico_ok);
+    bool ok = remetente(mestre, v);
+    pthread_join(thread, NULL);
+    return ok;
+}
+
+static uint id_sessao;
+
+static bool enviar_certo(int mestre, const Versao *v) {
+    return acervo_enviar(mestre, (uint8_t)id_sessao, v->fps, v->r >> 8, v->g >> 8, v->b >> 8,
+                         (const uint8_t (*)[BYTES_POR_QUADRO])v->quadros, v->num_quadros);
+}
+
+// Mesmo registro com o CRC estragado: o Pico tem que responder 'N' e não gravar
+static bool enviar_corrompido(int mestre, const Versao *v) {
+    static uint8_t buf[ACERVO_CABECALHO_USB + 2 + ACERVO_MAX_QUADROS * BYTES_POR_QUADRO + FLUXO_RODAPE];
+    uint8_t abrir = 'u', dados[3];
+    fluxo_escrever_tudo(mestre, &abrir, 1);
+    if (fluxo_ler_resposta(mestre, dados, sizeof(dados), 3000) != FLUXO_INICIO) {
+        return false;
+    }
+    size_t n = acervo_montar_registro(buf, (uint8_t)id_sessao, v->fps, v->r >> 8, v->g >> 8, v->b >> 8,
+                                      (const uint8_t (*)[BYTES_POR_QUADRO])v->quadros, v->num_quadros);
+    buf[n - 1] ^= 0xFF;
+    fluxo_escrever_tudo(mestre, buf, n);
+    return fluxo_ler_resposta(mestre, dados, sizeof(dados), 3000) == FLUXO_REJEITADO;
+}
+
+static void usb(void) {
+    int mestre = posix_openpt(O_RDWR | O_NOCTTY);
+    if (mestre < 0 || grantpt(mestre) != 0 || unlockpt(mestre) != 0) {
+        perror("pty");
+        falhas++;
+        return;
+    }
+    escravo = open(ptsname(mestre), O_RDWR | O_NOCTTY);
+    if (escravo < 0 || !fluxo_modo_bruto(escravo) || !fluxo_modo_bruto(mestre)) {
+        perror("pty");
+        falhas++;
+        return;
+    }
+
+    // Grade de texto -> quadros, como no gravar_animacao
+    static Versao v;
+    char grade[] = "/tmp/verificar_acervo_XXXXXX";
+    int fd = mkstemp(grade);
+    FILE *f = fdopen(fd, "w");
+    fprintf(f, "# Duas setas\n..F..\n.FFF.\nF.F.F\n..F..\n..F..\n\n..1..\n..2..\n3.4.5\n.678.\n..9..\n");
+    fclose(f);
+    v.cheio = true;
+    v.num_quadros = (uint16_t)acervo_ler_grade(grade, v.quadros, ACERVO_MAX_QUADROS);
+    unlink(grade);
+    v.fps = 4;
+    v.r = 0xFF00;
+    v.g = 0x8000;
+    v.b = 0x0000;
+    // Ponta de cima da seta: (2, 0); nível 5 do segundo quadro: (4, 2)
+    uint topo = raster_indice_autoria(2, 0), direita = raster_indice_autoria(4, 2);
+    bool grade_ok = v.num_quadros == 2 && (v.quadros[0][topo / 2] >> ((topo & 1) * 4) & 0xF) == 0xF
+                 && (v.quadros[1][direita / 2] >> ((direita & 1) * 4) & 0xF) == 5;
+
+    id_sessao = 3;
+    bool pico_ok;
+    bool certo = sessao(mestre, enviar_certo, &v, &pico_ok) && pico_ok;
+    if (certo) {
+        modelo[id_sessao] = v;
+    }
+    acervo_init();
+    Animacao a;
+    bool gravado = igual(ler(id_sessao, &a), &modelo[id_sessao]);
+
+    Versao *outra = malloc(sizeof(Versao));
+    *outra = v;
+    outra->fps = 9;
+    bool recusado = sessao(mestre, enviar_corrompido, outra, &pico_ok) && !pico_ok;
+    free(outra);
+    bool intacto = igual(ler(id_sessao, &a), &modelo[id_sessao]);
+
+    printf("USB: grade %s, registro %s, CRC errado %s\n", grade_ok ? "certa" : "ERRADA",
+           certo && gravado ? "gravado" : "NAO GRAVADO", recusado && intacto ? "recusado" : "ACEITO");
+    if (!grade_ok || !certo || !gravado || !recusado || !intacto) {
+        falhas++;
+    }
+    close(escravo);
+    close(mestre);
+}
+
+int main(int argc, char **argv) {
+    uint operacoes = argc > 1 ? (uint)atoi(argv[1]) : 3000;
+
+    acervo_init();
+    conferir("flash apagada", 0);
+
+    // Sem fps a animação não tem período entre os quadros: recusada
+    static const uint8_t um_quadro[1][BYTES_POR_QUADRO];
+    if (acervo_gravar(0, 0, 0, 0, 0, um_quadro, 1)) {
+        printf("fps 0 aceito\n");
+        falhas++;
+    }
+    carga(operacoes);
+    cortes();
+    usb();
+
+    acervo_relatorio();
+    printf("%s\n", falhas ? "FALHOU" : "OK");
+    return falhas ? 1 : 0;
+}
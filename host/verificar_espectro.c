@@ -0,0 +1,183 @@
+// Confere o espectro do visualizador de áudio (espectro.c) com sinais sintéticos
+// e o caminho inteiro do microfone no firmware simulado:
+//   - a FFT em Q15 contra uma DFT em double, no mesmo bloco;
+//   - um seno no meio de cada banda acende essa banda mais que as outras;
+//   - silêncio (só o ruído do ADC) deixa as barras apagadas e um seno perto do
+//     fundo de escala enche a barra;
+//   - no simulador, 'V' com um seno no microfone: um quadro publicado por bloco
+//     (62,5 Hz) e nenhum bloco perdido enquanto os quadros vão para o PIO.
+// Mostra também o tempo de CPU do PC por bloco.
+//
+//   verificar_espectro          (retorna 1 se algum caso falhar)
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "simulacao.h"
+#include "espectro.h"
+#include "microfone.h"
+#include "saida_led.h"
+
+// Erro máximo da FFT em Q15 contra a referência, em LSB
+#define TOLERANCIA_FFT 6
+
+// A banda do seno tem que ter pelo menos esta energia a mais que qualquer outra
+#define MARGEM_BANDA 16
+
+#define MEIO_ADC 2048
+
+// Frequência no meio dos bins de cada banda, em Hz
+static double centro_banda(uint b) {
+    return (espectro_limites[b] + espectro_limites[b + 1] - 1) / 2.0 * ESPECTRO_TAXA_HZ / ESPECTRO_N;
+}
+
+// Bloco de 12 bits do ADC: seno em volta do meio da escala e ±2 LSB de ruído
+static void gerar(uint16_t *amostras, double hz, double amplitude, uint32_t *semente) {
+    for (uint i = 0; i < ESPECTRO_N; i++) {
+        *semente = *semente * 1103515245 + 12345;
+        int ruido = (int)((*semente >> 16) % 5) - 2;
+        int v = MEIO_ADC + (int)lround(amplitude * sin(2 * M_PI * hz * i / ESPECTRO_TAXA_HZ)) + ruido;
+        amostras[i] = (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : v);
+    }
+}
+
+static bool verificar_fft(void) {
+    int16_t re[ESPECTRO_N], im[ESPECTRO_N];
+    double entrada[ESPECTRO_N][2];
+    uint32_t x = 0x3C6EF372;
+    for (uint i = 0; i < ESPECTRO_N; i++) {
+        x ^= x << 13, x ^= x >> 17, x ^= x << 5;
+        re[i] = (int16_t)(x & 0xFFFF);
+        im[i] = (int16_t)(x >> 16);
+        entrada[i][0] = re[i];
+        entrada[i][1] = im[i];
+    }
+    espectro_fft(re, im);
+
+    double erro = 0;
+    for (uint k = 0; k < ESPECTRO_N; k++) {
+        double sr = 0, si = 0;
+        for (uint n = 0; n < ESPECTRO_N; n++) {
+            double a = -2 * M_PI * (double)(k * n % ESPECTRO_N) / ESPECTRO_N;
+            sr += entrada[n][0] * cos(a) - entrada[n][1] * sin(a);
+            si += entrada[n][0] * sin(a) + entrada[n][1] * cos(a);
+        }
+        erro = fmax(erro, fabs(sr / ESPECTRO_N - re[k]));
+        erro = fmax(erro, fabs(si / ESPECTRO_N - im[k]));
+    }
+    bool ok = erro <= TOLERANCIA_FFT;
+    printf("FFT Q15 contra DFT em double: erro max %.1f LSB %s\n", erro, ok ? "OK" : "FALHOU");
+    return ok;
+}
+
+static bool verificar_bandas(void) {
+    uint16_t amostras[ESPECTRO_N];
+    uint32_t energia[ESPECTRO_BANDAS];
+    uint32_t semente = 1;
+    bool ok = true;
+
+    for (uint b = 0; b < ESPECTRO_BANDAS; b++) {
+        double hz = centro_banda(b);
+        gerar(amostras, hz, 1000, &semente);
+        espectro_bandas(amostras, energia);
+        bool maior = true;
+        for (uint o = 0; o < ESPECTRO_BANDAS; o++) {
+            maior &= o == b || energia[b] >= (uint64_t)energia[o] * MARGEM_BANDA;
+        }
+        printf("Seno %4.0f Hz (banda %u): alturas", hz, b);
+        for (uint o = 0; o < ESPECTRO_BANDAS; o++) {
+            printf(" %2u", espectro_altura(energia[o]));
+        }
+        printf("  %s\n", maior ? "OK" : "FALHOU");
+        ok &= maior;
+    }
+
+    // Só o ruído: todas apagadas
+    gerar(amostras, 0, 0, &semente);
+    espectro_bandas(amostras, energia);
+    bool apagadas = true;
+    for (uint o = 0; o < ESPECTRO_BANDAS; o++) {
+        apagadas &= espectro_altura(energia[o]) == 0;
+    }
+    printf("Silencio: barras apagadas %s\n", apagadas ? "OK" : "FALHOU");
+
+    // Perto do fundo de escala: barra cheia
+    gerar(amostras, centro_banda(2), 2000, &semente);
+    espectro_bandas(amostras, energia);
+    uint altura = espectro_altura(energia[2]);
+    bool cheia = altura == ESPECTRO_ALTURA_MAX;
+    printf("Fundo de escala: altura %u de %u %s\n", altura, ESPECTRO_ALTURA_MAX, cheia ? "OK" : "FALHOU");
+
+    // Sobe na hora e desce ESPECTRO_QUEDA por bloco
+    uint16_t alturas[ESPECTRO_BANDAS] = { 0 };
+    espectro_suavizar(alturas, energia);
+    uint32_t zero[ESPECTRO_BANDAS] = { 0 };
+    espectro_suavizar(alturas, zero);
+    bool queda = alturas[2] == ESPECTRO_ALTURA_MAX - ESPECTRO_QUEDA;
+    printf("Queda das barras: %u depois de um bloco de silencio %s\n", alturas[2], queda ? "OK" : "FALHOU");
+
+    return ok && apagadas && cheia && queda;
+}
+
+static void medir_host(void) {
+    uint16_t amostras[ESPECTRO_N];
+    uint32_t energia[ESPECTRO_BANDAS], quadro[MATRIZ_LARGURA * MATRIZ_ALTURA];
+    uint16_t alturas[ESPECTRO_BANDAS] = { 0 };
+    uint32_t semente = 7;
+    gerar(amostras, 440, 800, &semente);
+
+    const int blocos = 20000;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < blocos; i++) {
+        espectro_bandas(amostras, energia);
+        espectro_suavizar(alturas, energia);
+        espectro_desenhar(quadro, alturas);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / blocos;
+    printf("PC: %.0f ns por bloco (espectro + barras + desenho)\n", ns);
+}
+
+// Firmware simulado: 'V' e um seno na banda 3 do microfone. Os quadros contados
+// são os publicados (saida_led_quadros), porque um quadro igual ao anterior não
+// chega ao PIO.
+#define INICIO_MS 100
+#define FIM_MS 3100
+#define BANDA_SIMULADA 3
+
+static uint32_t quadros_inicio = 0;
+
+static void ao_evento_tecla(uint64_t tempo_us, char tecla, bool pressionada) {
+    if (tecla == 'V') {
+        quadros_inicio = saida_led_quadros();
+    }
+}
+
+static bool verificar_firmware(void) {
+    sim_iniciar(NULL);
+    sim_observar_teclas(ao_evento_tecla);
+    sim_usb(INICIO_MS * 1000ull, 'V');
+    sim_microfone(INICIO_MS * 1000ull, (uint32_t)centro_banda(BANDA_SIMULADA), 1200);
+    sim_fim(FIM_MS * 1000ull);
+    sim_executar(firmware_main);
+
+    const EstatisticasMicrofone *m = microfone_estatisticas();
+    double fps = (saida_led_quadros() - quadros_inicio) * 1000.0 / (FIM_MS - INICIO_MS);
+    double esperado = (double)ESPECTRO_TAXA_HZ / ESPECTRO_N;
+    bool ok = fabs(fps - esperado) < 1 && m->perdidos == 0 && m->processados + 1 >= m->blocos;
+    printf("Simulador: %.1f quadros/s (esperado %.1f), %lu blocos, %lu perdidos, %lu processados %s\n",
+           fps, esperado, (unsigned long)m->blocos, (unsigned long)m->perdidos,
+           (unsigned long)m->processados, ok ? "OK" : "FALHOU");
+    return ok;
+}
+
+int main(void) {
+    espectro_init();
+    bool ok = true;
+    ok &= verificar_fft();
+    ok &= verificar_bandas();
+    medir_host();
+    ok &= verificar_firmware();
+    return ok ? 0 : 1;
+}
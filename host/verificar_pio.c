@@ -0,0 +1,265 @@
+// Roda os programas de matriz_led.pio no emulador de PIO, configurados pelas
+// mesmas funções de init do firmware, e confere a forma de onda bit a bit: cada
+// bit decodificado do pino tem que ser o bit enviado, com os tempos em alto e o
+// período dentro da tolerância do WS2812 (±150 ns). Mostra também a vazão. Os
+// casos com side-set rodam de novo no clk_sys reduzido do modo ocioso.
+//
+//   verificar_pio          (retorna 1 se algum caso falhar)
+#include <stdlib.h>
+#include <string.h>
+#include "simulacao.h"
+#include "emulador_pio.h"
+#include "saida_led.h"
+#include "energia.h"
+#include "matriz_led.pio.h"
+
+#define TOLERANCIA_NS 150
+#define MAX_MUDANCAS 65536
+#define MAX_FAIXAS 8
+#define PIXELS_TESTE 25
+
+typedef struct {
+    uint64_t ciclo;
+    uint32_t pinos;
+} Mudanca;
+
+static Mudanca mudancas[MAX_MUDANCAS];
+static uint num_mudancas;
+
+static void registrar_mudanca(void *contexto, uint64_t ciclo, uint32_t pinos) {
+    if (num_mudancas < MAX_MUDANCAS) {
+        mudancas[num_mudancas++] = (Mudanca) { ciclo, pinos };
+    }
+}
+
+typedef struct {
+    const char *nome;
+    uint instrucoes;
+    uint bits_por_pixel;
+    uint num_faixas;
+    TemposLed tempos;           // Esperados
+} Caso;
+
+typedef struct {
+    uint bits;
+    uint erros;
+    uint32_t t0h_min, t0h_max, t1h_min, t1h_max, periodo_min, periodo_max;
+} Medidas;
+
+static uint32_t aleatorio(void) {
+    static uint32_t estado = 0x12345678;
+    estado ^= estado << 13;
+    estado ^= estado >> 17;
+    estado ^= estado << 5;
+    return estado;
+}
+
+// Decodifica os bits de um pino a partir das mudanças registradas: cada subida
+// começa um bit, o tempo em alto decide 0 ou 1
+static void decodificar(const Caso *c, uint pino, double ns_por_ciclo, uint64_t ciclo_fim,
+                        const uint32_t *pixels, uint num_pixels, Medidas *m) {
+    uint32_t limiar = (c->tempos.t0h_ns + c->tempos.t1h_ns) / 2;
+    uint esperados = num_pixels * c->bits_por_pixel;
+    bool nivel = false;
+    uint64_t subida = 0, descida = 0;
+    bool em_bit = false;
+
+    for (uint i = 0; i <= num_mudancas; i++) {
+        bool novo = i < num_mudancas ? (mudancas[i].pinos >> pino) & 1 : false;
+        uint64_t ciclo = i < num_mudancas ? mudancas[i].ciclo : ciclo_fim;
+        bool fim = i == num_mudancas;
+        if (!fim && novo == nivel) {
+            continue;
+        }
+        if (!nivel && (novo || fim) && em_bit) {
+            // Fecha o bit anterior na próxima subida (ou no fim dos dados)
+            uint32_t alto = (uint32_t)((descida - subida) * ns_por_ciclo + 0.5);
+            uint32_t periodo = (uint32_t)((ciclo - subida) * ns_por_ciclo + 0.5);
+            uint b = m->bits;
+            bool bit = alto >= limiar;
+            if (b < esperados) {
+                uint32_t palavra = pixels[b / c->bits_por_pixel];
+                bool enviado = (palavra >> (31 - b % c->bits_por_pixel)) & 1;
+                m->erros += bit != enviado;
+            } else {
+                m->erros++;
+            }
+            if (bit) {
+                m->t1h_min = MIN(m->t1h_min, alto);
+                m->t1h_max = MAX(m->t1h_max, alto);
+            } else {
+                m->t0h_min = MIN(m->t0h_min, alto);
+                m->t0h_max = MAX(m->t0h_max, alto);
+            }
+            if (!fim) {
+                // O último bit termina no reset: a fase baixa não tem período
+                m->periodo_min = MIN(m->periodo_min, periodo);
+                m->periodo_max = MAX(m->periodo_max, periodo);
+            }
+            m->bits++;
+            em_bit = false;
+        }
+        if (fim) {
+            break;
+        }
+        if (novo) {
+            subida = ciclo;
+            em_bit = true;
+        } else {
+            descida = ciclo;
+        }
+        nivel = novo;
+    }
+    if (m->bits != esperados) {
+        m->erros += esperados > m->bits ? esperados - m->bits : m->bits - esperados;
+    }
+}
+
+static bool dentro(uint32_t min, uint32_t max, uint32_t alvo) {
+    return min + TOLERANCIA_NS >= alvo && max <= alvo + TOLERANCIA_NS;
+}
+
+// Emula o programa da state machine (pio, sm) com `palavras` na FIFO e confere os
+// pinos base, base+1, ... contra os pixels de cada faixa
+static bool verificar(const Caso *c, uint pio, uint sm, uint pino_base, const uint32_t *palavras, uint num_palavras,
+                      uint32_t pixels[][PIXELS_TESTE], uint num_pixels) {
+    const uint16_t *memoria;
+    uint pc;
+    pio_sm_config config;
+    sim_pio_estado(pio, sm, &memoria, &pc, &config);
+
+    EmuladorPio e;
+    emulador_iniciar(&e, memoria, pc, &config);
+    emulador_fifo(&e, palavras, num_palavras);
+    e.ao_mudar = registrar_mudanca;
+    num_mudancas = 0;
+    emulador_executar(&e, UINT64_MAX);
+    if (e.erro) {
+        printf("%-28s erro no emulador\n", c->nome);
+        return false;
+    }
+
+    double ns_por_ciclo = config.clkdiv * 1e9 / clock_get_hz(clk_sys);
+    Medidas total = { .t0h_min = UINT32_MAX, .t1h_min = UINT32_MAX, .periodo_min = UINT32_MAX };
+    for (uint k = 0; k < c->num_faixas; k++) {
+        Medidas m = { .t0h_min = UINT32_MAX, .t1h_min = UINT32_MAX, .periodo_min = UINT32_MAX };
+        decodificar(c, pino_base + k, ns_por_ciclo, e.ciclo, pixels[k], num_pixels, &m);
+        total.bits += m.bits;
+        total.erros += m.erros;
+        total.t0h_min = MIN(total.t0h_min, m.t0h_min);
+        total.t0h_max = MAX(total.t0h_max, m.t0h_max);
+        total.t1h_min = MIN(total.t1h_min, m.t1h_min);
+        total.t1h_max = MAX(total.t1h_max, m.t1h_max);
+        total.periodo_min = MIN(total.periodo_min, m.periodo_min);
+        total.periodo_max = MAX(total.periodo_max, m.periodo_max);
+    }
+
+    double tempo_us = e.ciclo * ns_por_ciclo / 1000;
+    bool ok = total.erros == 0 &&
+              dentro(total.t0h_min, total.t0h_max, c->tempos.t0h_ns) &&
+              dentro(total.t1h_min, total.t1h_max, c->tempos.t1h_ns) &&
+              dentro(total.periodo_min, total.periodo_max, c->tempos.periodo_ns);
+
+    printf("%-28s %2u instr  div %6.3f  T0H %4lu-%-4lu  T1H %4lu-%-4lu  periodo %4lu-%-4lu ns  "
+           "%5u bits  %7.1f kbit/s  %3u erros  %s\n",
+           c->nome, c->instrucoes, config.clkdiv,
+           (unsigned long)total.t0h_min, (unsigned long)total.t0h_max,
+           (unsigned long)total.t1h_min, (unsigned long)total.t1h_max,
+           (unsigned long)total.periodo_min, (unsigned long)total.periodo_max,
+           total.bits, total.bits * 1000.0 / tempo_us, total.erros, ok ? "OK" : "FALHOU");
+    return ok;
+}
+
+static void gerar_pixels(uint32_t *pixels, uint n, uint bits_por_pixel) {
+    uint32_t mascara = bits_por_pixel == 32 ? 0xFFFFFFFFu : 0xFFFFFF00u;
+    pixels[0] = 0; // Garante bits 0 e 1 nos dois extremos
+    pixels[1] = mascara;
+    for (uint i = 2; i < n; i++) {
+        pixels[i] = aleatorio() & mascara;
+    }
+}
+
+static bool caso_serial(const Caso *c, PIO pio, uint pino, const TemposLed *tempos) {
+    uint32_t pixels[1][PIXELS_TESTE];
+    gerar_pixels(pixels[0], PIXELS_TESTE, c->bits_por_pixel);
+
+    uint sm = pio_claim_unused_sm(pio, true);
+    if (tempos) {
+        ws2812_sideset_timing ciclos;
+        if (!ws2812_sideset_timing_from_ns(tempos->t0h_ns, tempos->t1h_ns, tempos->periodo_ns, &ciclos)) {
+            printf("%-28s tempos fora do alcance\n", c->nome);
+            return false;
+        }
+        uint16_t instrucoes[4];
+        struct pio_program programa = ws2812_sideset_program_with_timing(&ciclos, instrucoes);
+        uint offset = pio_add_program(pio, &programa);
+        ws2812_sideset_program_init(pio, sm, offset, pino, ciclos.clkdiv, c->bits_por_pixel);
+    } else {
+        uint offset = pio_add_program(pio, &matriz_led_program);
+        matriz_led_program_init(pio, sm, offset, pino);
+    }
+    return verificar(c, pio_get_index(pio), sm, pino, pixels[0], PIXELS_TESTE, pixels, PIXELS_TESTE);
+}
+
+// Transposição feita bit a bit, independente da de saida_led.c: para cada bit de
+// cada pixel, um byte com o bit de cada faixa; quatro bytes por palavra, o
+// primeiro no byte alto
+static bool caso_paralelo(const Caso *c, PIO pio, uint pino_base) {
+    uint32_t pixels[MAX_FAIXAS][PIXELS_TESTE];
+    for (uint k = 0; k < c->num_faixas; k++) {
+        gerar_pixels(pixels[k], PIXELS_TESTE, 24);
+    }
+
+    static uint32_t palavras[PIXELS_TESTE * 6];
+    uint n = 0;
+    for (uint p = 0; p < PIXELS_TESTE; p++) {
+        for (uint b = 0; b < 24; b += 4) {
+            uint32_t palavra = 0;
+            for (uint j = 0; j < 4; j++) {
+                uint8_t byte = 0;
+                for (uint k = 0; k < c->num_faixas; k++) {
+                    byte |= ((pixels[k][p] >> (31 - b - j)) & 1) << k;
+                }
+                palavra |= (uint32_t)byte << (24 - 8 * j);
+            }
+            palavras[n++] = palavra;
+        }
+    }
+
+    uint sm = pio_claim_unused_sm(pio, true);
+    uint offset = pio_add_program(pio, &matriz_led_paralelo_program);
+    matriz_led_paralelo_program_init(pio, sm, offset, pino_base, c->num_faixas);
+    return verificar(c, pio_get_index(pio), sm, pino_base, palavras, n, pixels, PIXELS_TESTE);
+}
+
+int main(void) {
+    // Tempos esperados do programa matriz_led: 10 ciclos a 8 MHz, alto por 3 (0) ou 6 (1)
+    const TemposLed tempos_set = { .t0h_ns = 375, .t1h_ns = 750, .periodo_ns = 1250 };
+    const TemposLed ws2812b = TEMPOS_WS2812B;
+    const TemposLed ws2811 = { .t0h_ns = 500, .t1h_ns = 1200, .periodo_ns = 2500 };
+    const TemposLed sk6812 = { .t0h_ns = 300, .t1h_ns = 600, .periodo_ns = 1250 };
+
+    const Caso set = { "matriz_led (set)", matriz_led_program.length, 24, 1, tempos_set };
+    const Caso sideset = { "ws2812_sideset WS2812B", ws2812_sideset_program.length, 24, 1, ws2812b };
+    const Caso rgbw = { "ws2812_sideset SK6812 RGBW", ws2812_sideset_program.length, 32, 1, sk6812 };
+    const Caso lento = { "ws2812_sideset WS2811", ws2812_sideset_program.length, 24, 1, ws2811 };
+    const Caso paralelo = { "matriz_led_paralelo x8", matriz_led_paralelo_program.length, 24, 8, tempos_set };
+
+    bool ok = true;
+    ok &= caso_serial(&set, pio0, 7, NULL);
+    ok &= caso_serial(&sideset, pio0, 8, &ws2812b);
+    ok &= caso_serial(&rgbw, pio0, 9, &sk6812);
+    ok &= caso_serial(&lento, pio0, 10, &ws2811);
+    ok &= caso_paralelo(&paralelo, pio1, 0);
+
+    // Os tempos do programa com side-set recalculados no clk_sys do modo ocioso
+    // (energia.h), nas state machines que sobram no pio1
+    uint32_t hz = clock_get_hz(clk_sys);
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS, hz, hz / ENERGIA_DIVISOR);
+    printf("clk_sys %.1f MHz:\n", clock_get_hz(clk_sys) / 1e6);
+    ok &= caso_serial(&sideset, pio1, 11, &ws2812b);
+    ok &= caso_serial(&rgbw, pio1, 12, &sk6812);
+    ok &= caso_serial(&lento, pio1, 13, &ws2811);
+    return ok ? 0 : 1;
+}
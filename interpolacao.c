@@ -0,0 +1,114 @@
+#include <string.h>
+#include "interpolacao.h"
+#include "agendador.h"
+#include "buzzer.h"
+#include "compactacao.h"
+#include "compositor.h"
+#include "raster.h"
+#include "rastro.h"
+
+static const ConfigInterpolacao *volatile config_atual = NULL;
+
+uint32_t peso_curva(CurvaInterpolacao curva, uint32_t fase) {
+    switch (curva) {
+    case CURVA_LINEAR:
+        return fase;
+    case CURVA_SUAVE:
+        return (fase * fase * (3 * 256 - 2 * fase)) >> 16; // 3f² - 2f³
+    case CURVA_ENTRADA:
+        return (fase * fase) >> 8;
+    case CURVA_SAIDA: {
+        uint32_t resto = 256 - fase;
+        return 256 - ((resto * resto) >> 8);
+    }
+    default:
+        return fase >= 256 ? 256 : 0;
+    }
+}
+
+// Um canal de (de, para) misturado com o seu peso, na mesma aritmética do SWAR
+static inline uint32_t misturar_canal(uint32_t de, uint32_t para, int desloc, uint32_t peso) {
+    uint32_t a = (de >> desloc) & 0xFF, b = (para >> desloc) & 0xFF;
+    return ((b * peso + a * (256 - peso)) >> 8) << desloc;
+}
+
+void interpolar_quadro(uint32_t *destino, const uint32_t *de, const uint32_t *para, uint n,
+                       uint32_t peso_r, uint32_t peso_g, uint32_t peso_b) {
+    if (destino != de) {
+        memcpy(destino, de, n * sizeof(uint32_t));
+    }
+    if (peso_r == peso_g && peso_g == peso_b) {
+        // Caso comum (mesma curva nos três canais): dois canais por multiplicação
+        misturar_sobre(destino, para, n, peso_r, false);
+        return;
+    }
+    for (uint i = 0; i < n; i++) {
+        uint32_t d = destino[i], p = para[i];
+        destino[i] = misturar_canal(d, p, 24, peso_g) | misturar_canal(d, p, 16, peso_r)
+                   | misturar_canal(d, p, 8, peso_b) | misturar_canal(d, p, 0, peso_b);
+    }
+}
+
+void interpolacao_definir(const ConfigInterpolacao *config) {
+    config_atual = config;
+}
+
+const ConfigInterpolacao *interpolacao_config(void) {
+    return config_atual;
+}
+
+void executar_interpolada(const Animacao *anim, const ConfigInterpolacao *config,
+                          const uint32_t *tabela_par, const uint32_t *tabela_impar,
+                          int buzzer_freq, int buzzer_duration) {
+    // Quadro-chave atual e o seguinte, já em palavras GRB; trocam de papel a cada chave
+    uint32_t chaves[2][NUM_PIXELS];
+    uint atual = 0;
+    int chave = 0;
+
+    LeitorQuadros leitor;
+    leitor_iniciar(&leitor, anim);
+    leitor_proximo(&leitor);
+    raster_niveis(chaves[0], leitor.niveis, tabela_par, tabela_impar);
+    if (anim->num_frames > 1) {
+        leitor_proximo(&leitor);
+    }
+    raster_niveis(chaves[1], leitor.niveis, tabela_par, tabela_impar);
+
+    // Mesma duração de antes: cada quadro-chave ocupa 1 / fps
+    uint32_t fps = anim->fps > 0 ? (uint32_t)anim->fps : 1;
+    uint32_t num_quadros = (uint32_t)anim->num_frames * INTERPOLACAO_HZ / fps;
+
+    Agendador ag;
+    agendador_iniciar(&ag, INTERPOLACAO_HZ * 1000);
+    for (uint32_t q = 0; q < num_quadros; q++) {
+        uint32_t t0 = RASTRO_INICIO();
+
+        // Posição em 1/256 de quadro-chave, a partir do índice do quadro de saída
+        uint32_t pos = (uint32_t)((uint64_t)q * fps * 256 / INTERPOLACAO_HZ);
+        bool nova_chave = q == 0;
+        while (chave < (int)(pos >> 8)) {
+            chave++;
+            atual ^= 1;
+            nova_chave = true;
+            if (chave + 1 < anim->num_frames) {
+                leitor_proximo(&leitor);
+            }
+            // Depois do último quadro-chave, o seguinte é ele mesmo (segura até o fim)
+            raster_niveis(chaves[atual ^ 1], leitor.niveis, tabela_par, tabela_impar);
+        }
+
+        uint32_t fase = pos & 0xFF;
+        interpolar_quadro(saida_led_quadro(), chaves[atual], chaves[atual ^ 1], NUM_PIXELS,
+                          peso_curva(config->curva_r, fase), peso_curva(config->curva_g, fase),
+                          peso_curva(config->curva_b, fase));
+        RASTRO_FIM(RASTRO_QUADRO, chave, t0);
+        saida_led_enviar(); // Trechos sem mudança (chaves iguais) não são retransmitidos
+
+        if (nova_chave && buzzer_freq > 0 && buzzer_duration > 0) {
+            buzzer_tone(buzzer_freq, buzzer_duration);
+        }
+        if (!agendador_esperar(&ag)) {
+            break; // Outra tecla foi pressionada
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef INTERPOLACAO_H
+#define INTERPOLACAO_H
+
+#include "pico/stdlib.h"
+#include "animacao.h"
+
+// Interpolação entre quadros (tweening): os quadros de uma Animacao viram
+// quadros-chave, que continuam no ritmo do seu `fps`, e a saída recebe quadros
+// intermediários a INTERPOLACAO_HZ. Cada canal (R, G, B) tem a sua curva; o peso
+// do quadro seguinte é calculado uma vez por quadro de saída, e cada pixel custa
+// uma mistura de palavras GRB em ponto fixo, sem ponto flutuante.
+
+// Taxa dos quadros de saída. 100 Hz sobra com folga na matriz (um quadro leva
+// ~1 ms com o reset) e divide os FPS das animações em passos iguais.
+#define INTERPOLACAO_HZ 100
+
+typedef enum {
+    CURVA_DEGRAU,    // Segura o quadro-chave até o próximo (como sem interpolação)
+    CURVA_LINEAR,
+    CURVA_SUAVE,     // Acelera e desacelera (smoothstep)
+    CURVA_ENTRADA,   // Começa devagar (quadrática)
+    CURVA_SAIDA,     // Termina devagar
+} CurvaInterpolacao;
+
+typedef struct {
+    const char *nome;
+    uint8_t curva_r, curva_g, curva_b;  // CurvaInterpolacao de cada canal
+} ConfigInterpolacao;
+
+// Peso 0..256 do quadro seguinte na fase 0..256 entre dois quadros-chave
+uint32_t peso_curva(CurvaInterpolacao curva, uint32_t fase);
+
+// destino = de + (para - de) * peso de cada canal (G, R e B, 0..256). Com os três
+// pesos iguais usa o kernel SWAR do compositor; o byte baixo (W) segue o peso do B.
+void interpolar_quadro(uint32_t *destino, const uint32_t *de, const uint32_t *para, uint n,
+                       uint32_t peso_r, uint32_t peso_g, uint32_t peso_b);
+
+// Curvas usadas por executar_animacao (NULL: quadros-chave sem interpolação).
+// Pode ser chamada do outro núcleo; vale a partir da próxima animação.
+void interpolacao_definir(const ConfigInterpolacao *config);
+const ConfigInterpolacao *interpolacao_config(void);
+
+// Toca `anim` interpolada na saída pelo tempo das animações sem interpolação
+// (num_frames / fps). Os níveis dos pixels pares usam tabela_par e os dos ímpares
+// tabela_impar (iguais numa animação de uma cor só). O buzzer toca a cada
+// quadro-chave. Para antes se outra tecla for pressionada.
+void executar_interpolada(const Animacao *anim, const ConfigInterpolacao *config,
+                          const uint32_t *tabela_par, const uint32_t *tabela_impar,
+                          int buzzer_freq, int buzzer_duration);
+
+#endif
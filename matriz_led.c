@@ -1,577 +1,934 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
 #include "pico/bootrom.h"
 
-// Arquivo .pio
-#include "matriz_led.pio.h"
+// Saída da matriz por DMA, em uma ou mais faixas (define NUM_PIXELS)
+#include "saida_led.h"
 
-// Número de LEDs
-#define NUM_PIXELS 25
+// Buzzer por PWM, sem bloquear
+#include "buzzer.h"
 
-// Pino de saída
-#define OUT_PIN 7
+// Ritmo dos quadros por prazos absolutos
+#include "agendador.h"
 
-// Teclado Matricial
-#define ROW1 10
-#define ROW2 9
-#define ROW3 8
-#define ROW4 6
+// Teclado varrido por IRQ, com fila de eventos
+#include "teclado.h"
 
-#define COL1 5
-#define COL2 4
-#define COL3 3
-#define COL4 2
+// Renderização e saída no núcleo 1
+#include "pipeline.h"
 
-// Pino do buzzer
-#define BUZZER_PIN 21
+// Formato dos quadros e cores em ponto fixo
+#include "animacao.h"
 
-// Estrutura para armazenar dados de uma animação
-typedef struct {
-    double frames[25][NUM_PIXELS];
-    int num_frames;
-    double r, g, b;
-    int fps;
-} Animacao;
+// Quadros compactados (quadro-chave + delta + run-length)
+#include "compactacao.h"
 
-// Função para configurar os GPIOs do teclado e LEDs
-void setup_gpio() {
-    int rows[] = {ROW1, ROW2, ROW3, ROW4};
-    int cols[] = {COL1, COL2, COL3, COL4};
-
-    // Configuração das linhas como saída
-    for (int i = 0; i < 4; i++) {
-        gpio_init(rows[i]);
-        gpio_set_dir(rows[i], GPIO_OUT);
-        gpio_put(rows[i], 1);
-    }
+// Animações calculadas por pixel (geradores em ponto fixo)
+#include "procedural.h"
 
-    // Configuração das colunas como entrada com pull-up
-    for (int i = 0; i < 4; i++) {
-        gpio_init(cols[i]);
-        gpio_set_dir(cols[i], GPIO_IN);
-        gpio_pull_up(cols[i]);
-    }
+// Animações prontas, geradas no build a partir de animacoes/
+#include "animacoes.h"
 
-    // Configuração do buzzer
-    gpio_init(BUZZER_PIN);
-    gpio_set_dir(BUZZER_PIN, GPIO_OUT);
-    gpio_put(BUZZER_PIN, 0);
-}
+// Quadros enviados ao vivo pelo PC
+#include "fluxo_usb.h"
+#include "acervo.h"
 
-// Função para gerar tons no buzzer
-void buzzer_tone(uint frequency, uint duration_ms) {
-    uint32_t period_us = 1000000 / frequency; 
-    uint32_t half_period_us = period_us / 2;  
-    uint32_t cycles = (frequency * duration_ms) / 1000;
-
-    for (uint32_t i = 0; i < cycles; i++) {
-        gpio_put(BUZZER_PIN, 1);
-        sleep_us(half_period_us);
-        gpio_put(BUZZER_PIN, 0);
-        sleep_us(half_period_us);
-    }
+// Sequências de eventos (notas, quadros, cores) num relógio só
+#include "sequenciador.h"
+
+// Camadas misturadas num quadro só
+#include "compositor.h"
+
+// Texto rolante com fonte em flash
+#include "texto.h"
+
+// Quadros intermediários entre os quadros-chave das animações
+#include "interpolacao.h"
+
+// Desenho em (x, y), na ordem da cadeia do painel montado
+#include "raster.h"
+
+// Medições de desempenho pelo USB
+#include "benchmark.h"
+
+// Pontos de rastro nos caminhos quentes
+#include "rastro.h"
+
+// Modo ocioso: WFE no laço e clk_sys reduzido com a matriz parada
+#include "energia.h"
+
+// Visualizador de áudio: microfone no ADC por DMA e espectro em ponto fixo
+#include "microfone.h"
+
+// Pino de saída
+#define OUT_PIN 7
+
+// Pino do buzzer
+#define BUZZER_PIN 21
+
+// Função para configurar os GPIOs do teclado e do buzzer
+void setup_gpio() {
+    // Teclado varrido em segundo plano por IRQ de timer
+    teclado_init();
+
+    // Configuração do buzzer (PWM, toca em segundo plano)
+    buzzer_init(BUZZER_PIN);
 }
 
-// Função para detectar tecla pressionada
+// Função para detectar tecla pressionada (retira eventos da fila, sem bloquear)
 char detect_key() {
-    const char keys[4][4] = {
-        {'1', '2', '3', 'A'},
-        {'4', '5', '6', 'B'},
-        {'7', '8', '9', 'C'},
-        {'*', '0', '#', 'D'}
-    };
-
-    int rows[4] = {ROW1, ROW2, ROW3, ROW4};
-    int cols[4] = {COL1, COL2, COL3, COL4};
-
-    for (int i = 0; i < 4; i++) {
-        gpio_put(rows[i], 0);
-        for (int j = 0; j < 4; j++) {
-            if (gpio_get(cols[j]) == 0) {
-                sleep_ms(200);
-                gpio_put(rows[i], 1);
-                return keys[i][j];
-            }
+    EventoTecla ev;
+    while (teclado_ler_evento(&ev)) {
+        if (ev.tipo == TECLA_PRESSIONADA) {
+            saida_led_marcar((uint32_t)ev.tempo_us); // Mede tecla -> primeiro pixel
+            RASTRO_EVENTO(RASTRO_TECLA, (uint8_t)ev.tecla, time_us_32() - (uint32_t)ev.tempo_us);
+            return ev.tecla;
         }
-        gpio_put(rows[i], 1);
     }
 
     return '\0';
 }
 
-// Função para criar cor RGB
-uint32_t matrix_rgb(double b, double r, double g) {
-    unsigned char R = r * 255;
-    unsigned char G = g * 255;
-    unsigned char B = b * 255;
-    return (G << 24) | (R << 16) | (B << 8);
+// Faixas de LEDs: só a matriz 5x5. Painéis encadeados ou lado a lado entram como
+// novas faixas (pio0 ou pio1, cada uma com seu pino e número de pixels); com
+// SAIDA_PARALELA, até 8 faixas em pinos consecutivos saem de uma state machine só.
+// O programa com side-set ocupa 4 das 32 instruções do PIO e aceita faixas RGBW
+// (.rgbw = true) e outros tempos de bit em .tempos (ex.: WS2811 a 400 kHz).
+static const FaixaLed faixas[] = {
+    { .pio = pio0, .pino = OUT_PIN, .num_pixels = NUM_PIXELS },
+};
+
+static const ConfigSaida config_saida = {
+    .faixas = faixas,
+    .num_faixas = count_of(faixas),
+    .modo = SAIDA_SERIAL,
+    .programa = SAIDA_PIO_SIDESET,
+    .tempos = NULL, // TEMPOS_WS2812B
+};
+
+// Desenha um padrão na matriz de LEDs
+void desenho_pio(uint16_t b, uint16_t r, uint16_t g) {
+    raster_preencher(saida_led_quadro(), matrix_rgb(b >> 8, r >> 8, g >> 8));
+    saida_led_enviar();
 }
 
-// Inicializa o PIO para a matriz de LEDs
-void init_matriz_led(PIO pio, uint *offset, uint *sm) {
-    *offset = pio_add_program(pio, &matriz_led_program);
-    if (*offset < 0) {
-        printf("Erro ao carregar programa PIO.\n");
-        return;
-    }
+void executar_animacao(const Animacao *anim, int buzzer_freq, int buzzer_duration) {
+    uint32_t tabela[NIVEIS_INTENSIDADE + 1]; // Palavra GRB de cada nível de intensidade
+    tabela_niveis(tabela, anim->r, anim->g, anim->b);
 
-    *sm = pio_claim_unused_sm(pio, true);
-    if (*sm < 0) {
-        printf("Erro ao requisitar state machine.\n");
+    const ConfigInterpolacao *interpolacao = interpolacao_config();
+    if (interpolacao) {
+        executar_interpolada(anim, interpolacao, tabela, tabela, buzzer_freq, buzzer_duration);
         return;
     }
 
-    matriz_led_program_init(pio, *sm, *offset, OUT_PIN);
-}
+    LeitorQuadros leitor;
+    leitor_iniciar(&leitor, anim);
 
-// Desenha um padrão na matriz de LEDs
-void desenho_pio(PIO pio, uint sm, double b, double r, double g) {
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        uint32_t valor_led = matrix_rgb(b, r, g);
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-}
-
-void executar_animacao(PIO pio, uint sm, Animacao *anim, int buzzer_freq, int buzzer_duration) {
-    int frame_delay = 1000 / anim->fps; // Calcula o tempo entre frames em milissegundos
+    Agendador ag;
+    agendador_iniciar(&ag, anim->fps * 1000); // Prazos dos quadros calculados a partir do FPS
     for (int frame = 0; frame < anim->num_frames; frame++) {
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            double intensidade = anim->frames[frame][i];
-            uint32_t valor_led = matrix_rgb(anim->b * intensidade, anim->r * intensidade, anim->g * intensidade);
-            pio_sm_put_blocking(pio, sm, valor_led);
-        }
+        uint32_t t0 = RASTRO_INICIO();
+        leitor_proximo(&leitor); // Decodifica só o que mudou em relação ao quadro anterior
+        raster_niveis(saida_led_quadro(), leitor.niveis, tabela, tabela);
+        RASTRO_FIM(RASTRO_QUADRO, frame, t0);
+        saida_led_enviar(); // Quadro idêntico ao anterior não é retransmitido
         if (buzzer_freq > 0 && buzzer_duration > 0) {
             buzzer_tone(buzzer_freq, buzzer_duration);
         }
-        sleep_ms(frame_delay); // Usa o tempo calculado com base no FPS
+        if (!agendador_esperar(&ag)) { // Espera o prazo do próximo quadro
+            break; // Outra tecla foi pressionada
+        }
     }
 }
 
-void executar_animacao_multicolor(PIO pio, uint sm, Animacao *anim, int buzzer_freq, int buzzer_duration, double r2, double g2, double b2) {
-    int frame_delay = 1000 / anim->fps; // Calcula o tempo entre frames em milissegundos
+void executar_animacao_multicolor(const Animacao *anim, int buzzer_freq, int buzzer_duration, uint16_t r2, uint16_t g2, uint16_t b2) {
+    uint32_t tabela1[NIVEIS_INTENSIDADE + 1], tabela2[NIVEIS_INTENSIDADE + 1];
+    tabela_niveis(tabela1, anim->r, anim->g, anim->b);
+    tabela_niveis(tabela2, r2, g2, b2);
+
+    const ConfigInterpolacao *interpolacao = interpolacao_config();
+    if (interpolacao) {
+        executar_interpolada(anim, interpolacao, tabela1, tabela2, buzzer_freq, buzzer_duration);
+        return;
+    }
+
+    LeitorQuadros leitor;
+    leitor_iniciar(&leitor, anim);
+
+    Agendador ag;
+    agendador_iniciar(&ag, anim->fps * 1000); // Prazos dos quadros calculados a partir do FPS
     for (int frame = 0; frame < anim->num_frames; frame++) {
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            double intensidade = anim->frames[frame][i];
-            uint32_t valor_led;
-            if (i % 2 == 0) {
-                valor_led = matrix_rgb(anim->b * intensidade, anim->r * intensidade, anim->g * intensidade);
-            } else {
-                valor_led = matrix_rgb(b2 * intensidade, r2 * intensidade, g2 * intensidade);
-            }
-            pio_sm_put_blocking(pio, sm, valor_led);
-        }
+        uint32_t t0 = RASTRO_INICIO();
+        leitor_proximo(&leitor);
+        raster_niveis(saida_led_quadro(), leitor.niveis, tabela1, tabela2); // Pixels pares e ímpares
+        RASTRO_FIM(RASTRO_QUADRO, frame, t0);
+        saida_led_enviar();
         if (buzzer_freq > 0 && buzzer_duration > 0) {
             buzzer_tone(buzzer_freq, buzzer_duration);
         }
-        sleep_ms(frame_delay); // Usa o tempo calculado com base no FPS
+        if (!agendador_esperar(&ag)) { // Espera o prazo do próximo quadro
+            break; // Outra tecla foi pressionada
+        }
     }
 }
 
 // Configuração de animações
-Animacao animacao_0 = {
-    .frames = {
-        {0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8},
-        {0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6},
-        {0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4},
-        {0.4, 0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8},
-        {0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6},
-        {0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4},
-        {0.4, 0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0}
-    },
-    .num_frames = 10,
-    .r = 1.0,
-    .g = 0.0,
-    .b = 1.0,
+static const uint8_t quadros_animacao_0[][BYTES_POR_QUADRO] = {
+    QUADRO(0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8),
+    QUADRO(0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6),
+    QUADRO(0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4),
+    QUADRO(0.4, 0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2),
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0),
+    QUADRO(0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8),
+    QUADRO(0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6),
+    QUADRO(0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4),
+    QUADRO(0.4, 0.6, 0.8, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0, 0.2),
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0)
+};
+
+const Animacao animacao_0 = {
+    .frames = quadros_animacao_0,
+    .num_frames = count_of(quadros_animacao_0),
+    .r = COR_FX(1.0),
+    .g = COR_FX(0.0),
+    .b = COR_FX(1.0),
     .fps = 7
 };
 
-Animacao animacao_1 = {
-    .frames = {
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2}
-    },
-    .num_frames = 10,
-    .r = 0.0,
-    .g = 0.0,
-    .b = 1.0,
+static const uint8_t quadros_animacao_1[][BYTES_POR_QUADRO] = {
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0),
+    QUADRO(1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2),
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0),
+    QUADRO(1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2),
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0),
+    QUADRO(1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2),
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0),
+    QUADRO(1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2),
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0),
+    QUADRO(1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2)
+};
+
+const Animacao animacao_1 = {
+    .frames = quadros_animacao_1,
+    .num_frames = count_of(quadros_animacao_1),
+    .r = COR_FX(0.0),
+    .g = COR_FX(0.0),
+    .b = COR_FX(1.0),
     .fps = 5
 };
 
-Animacao animacao_2 = {
-    .frames = {
-        {0.8, 0.6, 0.4, 0.2, 0.0, 1.0, 0.8, 0.6, 0.4, 0.2, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.0, 0.2, 0.4, 0.6},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4},
-        {0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8},
-        {0.8, 0.6, 0.4, 0.2, 0.0, 1.0, 0.8, 0.6, 0.4, 0.2, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0},
-        {0.2, 0.4, 0.6, 0.8, 1.0, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.0, 0.2, 0.4, 0.6},
-        {1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2},
-        {0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4},
-        {0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8}
-    },
-    .num_frames = 10,
-    .r = 0.5,
-    .g = 0.0,
-    .b = 0.0,
+static const uint8_t quadros_animacao_2[][BYTES_POR_QUADRO] = {
+    QUADRO(0.8, 0.6, 0.4, 0.2, 0.0, 1.0, 0.8, 0.6, 0.4, 0.2, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0),
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.0, 0.2, 0.4, 0.6),
+    QUADRO(1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2),
+    QUADRO(0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4),
+    QUADRO(0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8),
+    QUADRO(0.8, 0.6, 0.4, 0.2, 0.0, 1.0, 0.8, 0.6, 0.4, 0.2, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 0.0),
+    QUADRO(0.2, 0.4, 0.6, 0.8, 1.0, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.0, 0.2, 0.4, 0.6),
+    QUADRO(1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2, 1.0, 0.8, 0.6, 0.4, 0.2),
+    QUADRO(0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4),
+    QUADRO(0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8, 1.0, 0.6, 0.8, 1.0, 0.2, 0.4, 0.6, 0.8)
+};
+
+const Animacao animacao_2 = {
+    .frames = quadros_animacao_2,
+    .num_frames = count_of(quadros_animacao_2),
+    .r = COR_FX(0.5),
+    .g = COR_FX(0.0),
+    .b = COR_FX(0.0),
     .fps = 5
 };
 
-Animacao animacao_3_espiral= {
-    .frames = {
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0},
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0},
-    },
-    .num_frames = 25,
-    .r = 0.0,
-    .g = 1.0,
-    .b = 0.0,
+static const uint8_t quadros_animacao_3_espiral[][BYTES_POR_QUADRO] = {
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0),
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0)
+};
+
+const Animacao animacao_3_espiral = {
+    .frames = quadros_animacao_3_espiral,
+    .num_frames = count_of(quadros_animacao_3_espiral),
+    .r = COR_FX(0.0),
+    .g = COR_FX(1.0),
+    .b = COR_FX(0.0),
     .fps = 3
 };
 
-Animacao animacao_4 = {
-    .frames = {
-        {0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0},
-        {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0},
-        {0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0},
-        {0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0},
-        {1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0}
-    },
-    .num_frames = 9,
-    .r = 0.0,
-    .g = 1.0,
-    .b = 1.0,
+static const uint8_t quadros_animacao_4[][BYTES_POR_QUADRO] = {
+    QUADRO(0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0),
+    QUADRO(0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0),
+    QUADRO(0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0),
+    QUADRO(0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0),
+    QUADRO(1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0)
+};
+
+const Animacao animacao_4 = {
+    .frames = quadros_animacao_4,
+    .num_frames = count_of(quadros_animacao_4),
+    .r = COR_FX(0.0),
+    .g = COR_FX(1.0),
+    .b = COR_FX(1.0),
     .fps = 3
 };
 
-Animacao animacao_5_lorenzo = {
-    .frames = {
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0}, // L
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}, // O
-        {1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}, // R
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, // E
-        {1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0}, // N
-        {1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, // Z
-        {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}  // O
-    },
-    .num_frames = 7,
-    .r = 0.0,
-    .g = 0.0,
-    .b = 0.0, // As cores serão tratadas dinamicamente por letra
+static const uint8_t quadros_animacao_5_lorenzo[][BYTES_POR_QUADRO] = {
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0), // L
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0), // O
+    QUADRO(1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0), // R
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0), // E
+    QUADRO(1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0), // N
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0), // Z
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0) // O
+};
+
+const Animacao animacao_5_lorenzo = {
+    .frames = quadros_animacao_5_lorenzo,
+    .num_frames = count_of(quadros_animacao_5_lorenzo),
+    .r = COR_FX(0.0),
+    .g = COR_FX(0.0),
+    .b = COR_FX(0.0), // As cores serão tratadas dinamicamente por letra
     .fps = 2
 };
 
-    const double lorenzo_colors[7][3] = {
-        {1.0, 0.0, 0.0}, // L - Vermelho
-        {0.0, 1.0, 0.0}, // O - Verde
-        {0.0, 0.0, 1.0}, // R - Azul
-        {1.0, 1.0, 0.0}, // E - Amarelo
-        {1.0, 0.0, 1.0}, // N - Magenta
-        {0.0, 1.0, 1.0}, // Z - Ciano
-        {1.0, 0.5, 0.0}  // O - Laranja
-    };
-
-    void executar_animacao_lorenzo(PIO pio, uint sm) {
-    for (int frame = 0; frame < animacao_5_lorenzo.num_frames; frame++) {
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            double intensidade = animacao_5_lorenzo.frames[frame][i];
-            uint32_t valor_led = matrix_rgb(lorenzo_colors[frame][2] * intensidade, lorenzo_colors[frame][0] * intensidade, lorenzo_colors[frame][1] * intensidade);
-            pio_sm_put_blocking(pio, sm, valor_led);
-        }
-        buzzer_tone(440 + (frame * 50), 200);
-        sleep_ms(1000 / animacao_5_lorenzo.fps); // Calcula o tempo entre frames com base no FPS
-    }
+// Cada letra com a sua cor e uma nota mais aguda, 2 por segundo (120 BPM); a nota
+// soa por 2/5 da batida (200 ms)
+#define LETRA(k, cr, cg, cb) \
+    SEQ_COR((k) * SEQ_TIQUES_POR_BATIDA, COR_FX(cr), COR_FX(cg), COR_FX(cb)), \
+    SEQ_QUADRO((k) * SEQ_TIQUES_POR_BATIDA, k), \
+    SEQ_NOTA((k) * SEQ_TIQUES_POR_BATIDA, 440 + (k) * 50), \
+    SEQ_SOLTA((k) * SEQ_TIQUES_POR_BATIDA + SEQ_TIQUES_POR_BATIDA * 2 / 5)
+
+static const EventoSeq eventos_lorenzo[] = {
+    LETRA(0, 1.0, 0.0, 0.0), // L - Vermelho
+    LETRA(1, 0.0, 1.0, 0.0), // O - Verde
+    LETRA(2, 0.0, 0.0, 1.0), // R - Azul
+    LETRA(3, 1.0, 1.0, 0.0), // E - Amarelo
+    LETRA(4, 1.0, 0.0, 1.0), // N - Magenta
+    LETRA(5, 0.0, 1.0, 1.0), // Z - Ciano
+    LETRA(6, 1.0, 0.5, 0.0), // O - Laranja
+    SEQ_FIM(7 * SEQ_TIQUES_POR_BATIDA),
+};
+
+static const Sequencia sequencia_lorenzo = {
+    .eventos = eventos_lorenzo,
+    .anim = &animacao_5_lorenzo,
+    .bpm = 120,
+};
+
+void executar_animacao_lorenzo(void) {
+    executar_sequencia(&sequencia_lorenzo);
 }
 
-Animacao animacao_6_musica = {
-	.frames = {
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //sol
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0}, //dó
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //ré
-		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //mi
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, //fa
-		{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0} //fa
-	},
-	.num_frames = 24,
-	.r = 0.0,
-	.g = 0.0,
-	.b = 0.0,
+static const uint8_t quadros_animacao_6_musica[][BYTES_POR_QUADRO] = {
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0), //dó
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0), //ré
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //mi
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //fa
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //fa
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //fa
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0), //dó
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0), //ré
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0), //dó
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0), //ré
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0), //ré
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0), //ré
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0), //dó
+    QUADRO(1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //sol
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //fa
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //mi
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //mi
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //mi
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0), //dó
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0), //ré
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //mi
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //fa
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), //fa
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0) //fa
+};
+
+const Animacao animacao_6_musica = {
+	.frames = quadros_animacao_6_musica,
+	.num_frames = count_of(quadros_animacao_6_musica),
+	.r = COR_FX(0.0),
+	.g = COR_FX(0.0),
+	.b = COR_FX(0.0),
 	.fps = 4
 	
 };
 
-	const double musica_colors[24][3] = { // degradê de azul, onde o dó é o azul mais forte e o sol é o mais claro
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.2}, //sol
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 1.0}, //dó
-		{0.0, 0.0, 0.8}, //ré
-		{0.0, 0.0, 0.6}, //mi
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.4}, //fa
-		{0.0, 0.0, 0.4}, //fa
-	};
-
-	void executar_animacao_musica(PIO pio, uint sm) {
-		for (int frame = 0; frame < animacao_6_musica.num_frames; frame++) {
-        		for (int i = 0; i < NUM_PIXELS; i++) {
-           			double intensidade = animacao_6_musica.frames[frame][i];
-            			uint32_t valor_led = matrix_rgb(musica_colors[frame][2] * intensidade, musica_colors[frame][0] * intensidade, musica_colors[frame][1] * intensidade);
-            			pio_sm_put_blocking(pio, sm, valor_led);
-        	    }
-        	if (frame == 0 || frame == 6 || frame == 8 || frame == 12 || frame == 18){
-			    buzzer_tone(261, 250);
-			    sleep_ms(1000 / animacao_6_musica.fps);	
-			} else if (frame == 1 || frame == 7 || frame == 9 || frame == 10 || frame == 11 || frame == 19){
-			    buzzer_tone(293, 250);
-			    sleep_ms(1000 / animacao_6_musica.fps);
-			} else if (frame == 2 || frame == 15 || frame == 16 || frame == 17 || frame == 20){
-				buzzer_tone(329, 250);
-				sleep_ms(1000 / animacao_6_musica.fps);
-			} else if (frame == 3 || frame == 4 || frame == 5 || frame == 14 || frame == 21 || frame == 22 || frame == 23){
-				buzzer_tone(349, 250);
-				sleep_ms(1000 / animacao_6_musica.fps);
-			} else {
-				buzzer_tone (392, 250);
-				sleep_ms(1000 / animacao_6_musica.fps); 
-			}
-
-        }    
-    }
+#define NOTA_DO 261
+#define NOTA_RE 293
+#define NOTA_MI 329
+#define NOTA_FA 349
+#define NOTA_SOL 392
+
+// Uma nota por batida a 240 BPM (250 ms), cada uma com o seu quadro e um degradê
+// de azul, onde o dó é o azul mais forte e o sol é o mais claro
+#define PASSO(k, azul, nota) \
+    SEQ_COR((k) * SEQ_TIQUES_POR_BATIDA, COR_FX(0.0), COR_FX(0.0), COR_FX(azul)), \
+    SEQ_QUADRO((k) * SEQ_TIQUES_POR_BATIDA, k), \
+    SEQ_NOTA((k) * SEQ_TIQUES_POR_BATIDA, nota)
+
+static const EventoSeq eventos_musica[] = {
+    PASSO(0, 1.0, NOTA_DO),
+    PASSO(1, 0.8, NOTA_RE),
+    PASSO(2, 0.6, NOTA_MI),
+    PASSO(3, 0.4, NOTA_FA),
+    PASSO(4, 0.4, NOTA_FA),
+    PASSO(5, 0.4, NOTA_FA),
+    PASSO(6, 1.0, NOTA_DO),
+    PASSO(7, 0.8, NOTA_RE),
+    PASSO(8, 1.0, NOTA_DO),
+    PASSO(9, 0.8, NOTA_RE),
+    PASSO(10, 0.8, NOTA_RE),
+    PASSO(11, 0.8, NOTA_RE),
+    PASSO(12, 1.0, NOTA_DO),
+    PASSO(13, 0.2, NOTA_SOL),
+    PASSO(14, 0.4, NOTA_FA),
+    PASSO(15, 0.6, NOTA_MI),
+    PASSO(16, 0.6, NOTA_MI),
+    PASSO(17, 0.6, NOTA_MI),
+    PASSO(18, 1.0, NOTA_DO),
+    PASSO(19, 0.8, NOTA_RE),
+    PASSO(20, 0.6, NOTA_MI),
+    PASSO(21, 0.4, NOTA_FA),
+    PASSO(22, 0.4, NOTA_FA),
+    PASSO(23, 0.4, NOTA_FA),
+    SEQ_SOLTA(24 * SEQ_TIQUES_POR_BATIDA),
+    SEQ_FIM(24 * SEQ_TIQUES_POR_BATIDA),
+};
+
+static const Sequencia sequencia_musica = {
+    .eventos = eventos_musica,
+    .anim = &animacao_6_musica,
+    .bpm = 240,
+};
+
+void executar_animacao_musica(void) {
+    executar_sequencia(&sequencia_musica);
+}
 
-// Função para simular a sirene de polícia
-Animacao animacao_7_sirene = {
-    .frames = {
-        {1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0}, // Vermelho
-        {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0},  // Azul
-        {1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0}, // Vermelho
-        {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0},  // Azul
-        {1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0}, // Vermelho
-        {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0}  // Azul
-    },
-    .num_frames = 6,
-    .r = 1.0,
-    .g = 0.0,
-    .b = 0.0,
+// Função para simular a sirene de polícia: um quadro só de índices da paleta, com
+// os pontos do vermelho no índice 15 e os do azul no índice 1; cada batida só troca
+// as cores desses dois índices (SEQ_PALETA em eventos_sirene)
+#define SV 15
+#define SA 1
+static const uint8_t quadros_animacao_7_sirene[][BYTES_POR_QUADRO] = {
+    QUADRO_NIVEIS(SV, 0, SA, SV, 0, SA, SV, 0, SA, SV, 0, SA, SV, 0, SA, SV, 0, SA, SV, 0, SA, SV, 0, SA, SV),
+};
+#undef SV
+#undef SA
+
+// Quadro de índices, não uma animação vermelha: a cor abaixo só monta a paleta
+// inicial do sequenciador, e os índices 15 e 1 ganham as cores da sirene já no
+// primeiro tique
+const Animacao animacao_7_sirene = {
+    .frames = quadros_animacao_7_sirene,
+    .num_frames = count_of(quadros_animacao_7_sirene),
+    .r = COR_FX(1.0),
+    .g = COR_FX(0.0),
+    .b = COR_FX(0.0),
     .fps = 3 
 };
 
-void executar_animacao_sirene(PIO pio, uint sm) {
-    int frame_delay = 1000 / animacao_7_sirene.fps; 
-    int repeat_count = 3 * animacao_7_sirene.fps; // Número de repetições para 3 segundos
-
-    // Executa a animação e o som de forma sincronizada
-    for (int repeat = 0; repeat < repeat_count; repeat++) {
-        int frame = repeat % animacao_7_sirene.num_frames; // Calcula o frame atual
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            double intensidade = animacao_7_sirene.frames[frame][i]; // Intensidade do LED
-            double r = (frame % 2 == 0) ? 1.0 : 0.0; // Alterna entre vermelho e azul
-            double g = 0.0;
-            double b = (frame % 2 == 0) ? 0.0 : 1.0;
-            uint32_t valor_led = matrix_rgb(b * intensidade, r * intensidade, g * intensidade); // Cria a cor RGB
-            pio_sm_put_blocking(pio, sm, valor_led); // Envia o valor para o PIO
-        }
-        buzzer_tone(1000 - (frame % 2) * 300, frame_delay); // Alterna entre 1000 Hz e 700 Hz
-        sleep_ms(frame_delay); // Usa o tempo calculado com base no FPS
-    }
+// Três batidas por segundo (180 BPM) durante 3 segundos, alternando vermelho com
+// 1000 Hz e azul com 700 Hz
+#define VERMELHO(k) \
+    SEQ_PALETA((k) * SEQ_TIQUES_POR_BATIDA, 15, COR_FX(1.0), 0, 0), \
+    SEQ_PALETA((k) * SEQ_TIQUES_POR_BATIDA, 1, 0, 0, 0), \
+    SEQ_NOTA((k) * SEQ_TIQUES_POR_BATIDA, 1000)
+#define AZUL(k) \
+    SEQ_PALETA((k) * SEQ_TIQUES_POR_BATIDA, 15, 0, 0, 0), \
+    SEQ_PALETA((k) * SEQ_TIQUES_POR_BATIDA, 1, 0, 0, COR_FX(1.0)), \
+    SEQ_NOTA((k) * SEQ_TIQUES_POR_BATIDA, 700)
+
+static const EventoSeq eventos_sirene[] = {
+    SEQ_QUADRO(0, 0),
+    VERMELHO(0), AZUL(1), VERMELHO(2), AZUL(3), VERMELHO(4),
+    AZUL(5), VERMELHO(6), AZUL(7), VERMELHO(8),
+    SEQ_SOLTA(9 * SEQ_TIQUES_POR_BATIDA),
+    SEQ_FIM(9 * SEQ_TIQUES_POR_BATIDA),
+};
+
+static const Sequencia sequencia_sirene = {
+    .eventos = eventos_sirene,
+    .anim = &animacao_7_sirene,
+    .bpm = 180,
+};
+
+void executar_animacao_sirene(void) {
+    executar_sequencia(&sequencia_sirene);
 }
 
-Animacao animacao_8_countdown = {
-    .frames = {
-        {0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8},
-        {0.8, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.8},
-        {0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8},
-        {0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8},
-        {0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0},
-        {0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8}
-    },
-    .num_frames = 6,
-    .r = 1.0,
-    .g = 0.0,
-    .b = 0.0,
+static const uint8_t quadros_animacao_8_countdown[][BYTES_POR_QUADRO] = {
+    QUADRO(0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8),
+    QUADRO(0.8, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.8),
+    QUADRO(0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8),
+    QUADRO(0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8),
+    QUADRO(0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0, 0.0, 0.0, 0.8, 0.0, 0.0),
+    QUADRO(0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.0, 0.0, 0.0, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8)
+};
+
+const Animacao animacao_8_countdown = {
+    .frames = quadros_animacao_8_countdown,
+    .num_frames = count_of(quadros_animacao_8_countdown),
+    .r = COR_FX(1.0),
+    .g = COR_FX(0.0),
+    .b = COR_FX(0.0),
     .fps = 1
 };
 
-Animacao animacao_9 = {
-    .frames = {
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
-        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}
-    },
-    .num_frames = 10,
-    .r = 0.0,
-    .g = 1.0,
-    .b = 1.0,
+static const uint8_t quadros_animacao_9[][BYTES_POR_QUADRO] = {
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    QUADRO(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0)
+};
+
+const Animacao animacao_9 = {
+    .frames = quadros_animacao_9,
+    .num_frames = count_of(quadros_animacao_9),
+    .r = COR_FX(0.0),
+    .g = COR_FX(1.0),
+    .b = COR_FX(1.0),
     .fps = 5
 };
 
+// Animações compactadas na inicialização (e medidas pelo comando 'd')
+static const Animacao *const animacoes[] = {
+    &animacao_0, &animacao_1, &animacao_2, &animacao_3_espiral, &animacao_4,
+    &animacao_5_lorenzo, &animacao_6_musica, &animacao_7_sirene, &animacao_8_countdown, &animacao_9,
+};
+
+// Animações procedurais: nenhum quadro guardado, qualquer FPS e resolução
+static const AnimacaoProcedural proc_gradiente = {
+    .nome = "gradiente", .gerador = gerador_gradiente,
+    .velocidade = 256, .escala = 16,
+    .r = COR_FX(1.0), .g = COR_FX(0.0), .b = COR_FX(1.0),
+    .fps = 30, .duracao_ms = 6000
+};
+
+static const AnimacaoProcedural proc_onda = {
+    .nome = "onda", .gerador = gerador_onda,
+    .velocidade = 384, .escala = 16, .extra = 8,
+    .r = COR_FX(0.0), .g = COR_FX(0.6), .b = COR_FX(1.0),
+    .fps = 30, .duracao_ms = 6000
+};
+
+static const AnimacaoProcedural proc_espiral = {
+    .nome = "espiral", .gerador = gerador_espiral,
+    .velocidade = 256, .escala = 8, .extra = 1,
+    .r = COR_FX(1.0), .g = COR_FX(0.5), .b = COR_FX(0.0),
+    .fps = 30, .duracao_ms = 6000
+};
+
+static const AnimacaoProcedural proc_plasma = {
+    .nome = "plasma", .gerador = gerador_plasma,
+    .velocidade = 200, .escala = 24,
+    .r = COR_FX(0.2), .g = COR_FX(1.0), .b = COR_FX(0.4),
+    .fps = 30, .duracao_ms = 6000
+};
+
+static const AnimacaoProcedural proc_faisca = {
+    .nome = "faisca", .gerador = gerador_faisca,
+    .velocidade = 512, .escala = 48,
+    .r = COR_FX(1.0), .g = COR_FX(1.0), .b = COR_FX(1.0),
+    .fps = 30, .duracao_ms = 6000
+};
+
+static const AnimacaoProcedural *const procedurais[] = {
+    &proc_gradiente, &proc_onda, &proc_espiral, &proc_plasma, &proc_faisca,
+};
+
+// Contagem regressiva sobre o gradiente rosa, meio apagado: os pixels pretos dos
+// dígitos deixam o fundo aparecer
+static const CamadaAnimada camadas_contagem[] = {
+    { &animacao_0, MISTURA_SOBRE, 128, 128, false },
+    { &animacao_8_countdown, MISTURA_SOBRE, 255, 255, true },
+};
+
+static const Composicao composicao_contagem = {
+    .camadas = camadas_contagem, .num_camadas = count_of(camadas_contagem),
+    .fps = 20, .duracao_ms = 6000,
+};
+
+// Transição: as barras aparecem aos poucos sobre a espiral
+static const CamadaAnimada camadas_transicao[] = {
+    { &animacao_3_espiral, MISTURA_SOBRE, 255, 255, false },
+    { &animacao_4, MISTURA_SOBRE, 0, 255, false },
+};
+
+static const Composicao composicao_transicao = {
+    .camadas = camadas_transicao, .num_camadas = count_of(camadas_transicao),
+    .fps = 30, .duracao_ms = 4000,
+};
+
+// Curvas da interpolação entre quadros-chave, escolhidas em sequência pelo 'i'
+// (depois da última, volta a tocar só os quadros-chave)
+static const ConfigInterpolacao curvas_interpolacao[] = {
+    { "linear", CURVA_LINEAR, CURVA_LINEAR, CURVA_LINEAR },
+    { "suave", CURVA_SUAVE, CURVA_SUAVE, CURVA_SUAVE },
+    // Cada canal numa curva: o vermelho chega antes e o azul por último
+    { "por canal", CURVA_SAIDA, CURVA_SUAVE, CURVA_ENTRADA },
+};
+
+// Uma cor por letra, as mesmas do nome na tecla 5
+static const CorTexto paleta_lorenzo[] = {
+    { COR_FX(1.0), COR_FX(0.0), COR_FX(0.0) }, // Vermelho
+    { COR_FX(0.0), COR_FX(1.0), COR_FX(0.0) }, // Verde
+    { COR_FX(0.0), COR_FX(0.0), COR_FX(1.0) }, // Azul
+    { COR_FX(1.0), COR_FX(1.0), COR_FX(0.0) }, // Amarelo
+    { COR_FX(1.0), COR_FX(0.0), COR_FX(1.0) }, // Magenta
+    { COR_FX(0.0), COR_FX(1.0), COR_FX(1.0) }, // Ciano
+    { COR_FX(1.0), COR_FX(0.5), COR_FX(0.0) }, // Laranja
+};
+
+static const EstiloTexto estilo_nome = {
+    .paleta = paleta_lorenzo, .num_cores = count_of(paleta_lorenzo),
+    .pixels_por_segundo = 6, .fps = 50, .voltas = 2,
+};
+
+static const EstiloTexto estilo_usb = {
+    .paleta = paleta_lorenzo, .num_cores = count_of(paleta_lorenzo),
+    .pixels_por_segundo = 8, .fps = 50, .voltas = 0,
+};
+
+// Tempo máximo entre dois caracteres de uma linha de texto pelo USB
+#define TEXTO_TIMEOUT_US 1000000
+
+// Ação associada a uma tecla: a tarefa roda no núcleo de renderização
+typedef struct {
+    char tecla;
+    const char *mensagem;
+    Tarefa tarefa;
+    const Animacao *anim;
+    int buzzer_freq, buzzer_duration;
+    uint16_t r, g, b; // Segunda cor (multicolor) ou cor de preenchimento, em 8.8
+    const AnimacaoProcedural *proc;
+    const AnimacaoPronta *pronta;
+    const Composicao *comp;
+    const char *texto;          // Texto rolante; NULL = o definido pelo USB
+    const EstiloTexto *estilo;
+} AcaoTecla;
+
+static void tarefa_animacao(const void *arg) {
+    const AcaoTecla *a = arg;
+    executar_animacao(a->anim, a->buzzer_freq, a->buzzer_duration);
+}
+
+static void tarefa_multicolor(const void *arg) {
+    const AcaoTecla *a = arg;
+    executar_animacao_multicolor(a->anim, a->buzzer_freq, a->buzzer_duration, a->r, a->g, a->b);
+}
+
+static void tarefa_procedural(const void *arg) {
+    const AcaoTecla *a = arg;
+    executar_procedural(a->proc, a->buzzer_freq, a->buzzer_duration);
+}
+
+static void tarefa_pronta(const void *arg) {
+    const AcaoTecla *a = arg;
+    executar_pronta(a->pronta);
+}
+
+static void tarefa_composicao(const void *arg) {
+    const AcaoTecla *a = arg;
+    executar_composicao(a->comp);
+}
+
+static void tarefa_texto(const void *arg) {
+    const AcaoTecla *a = arg;
+    if (a->texto) {
+        executar_texto(a->texto, a->estilo);
+    } else {
+        executar_texto_definido(a->estilo);
+    }
+}
+
+static void tarefa_fluxo(const void *arg) {
+    executar_fluxo_usb();
+}
+
+static void tarefa_acervo(const void *arg) {
+    executar_acervo_usb();
+}
+
+// O argumento é o id: cada comando leva o seu, e a animação é copiada do acervo
+// aqui, no núcleo que grava, na hora de tocar
+static void tarefa_acervo_animacao(const void *arg) {
+    Animacao anim;
+    if (acervo_animacao((uint)(uintptr_t)arg, &anim)) {
+        executar_animacao(&anim, 0, 0);
+    }
+}
+
+static void tarefa_visualizador(const void *arg) {
+    executar_visualizador();
+}
+
+static void tarefa_lorenzo(const void *arg) {
+    executar_animacao_lorenzo();
+}
+
+static void tarefa_musica(const void *arg) {
+    executar_animacao_musica();
+}
+
+static void tarefa_sirene(const void *arg) {
+    executar_animacao_sirene();
+}
+
+static void tarefa_cor(const void *arg) {
+    const AcaoTecla *a = arg;
+    desenho_pio(a->b, a->r, a->g);
+}
+
+// Tabela de animações por tecla
+static const AcaoTecla acoes[] = {
+    { '0', "0 - GRADIENTE ROSA", tarefa_animacao, &animacao_0, 0, 0 },
+    { '1', "2 - PISCA PISCA COM BUZZER", tarefa_animacao, &animacao_1, 800, 200 },
+    { '2', "3 - PISCA PISCA MULTICOLORIDO COM BUZZER", tarefa_multicolor, &animacao_2, 200, 20, .r = COR_FX(0.0), .g = COR_FX(1.0), .b = COR_FX(0.0) },
+    { '3', "3 - ESPIRAL COM BUZZER", tarefa_animacao, &animacao_3_espiral, 800, 200 },
+    { '4', "4 - ANIMAÇÃO DE BARRAS", tarefa_animacao, &animacao_4, 500, 100 },
+    { '5', "5 - ESCREVER O NOME L O R E N Z O", tarefa_lorenzo },
+    { '6', "6 - MUSICA DÓ, RÉ, MI, FÁ", tarefa_musica },
+    { '7', "7 - SIRENE DE POLÍCIA", tarefa_sirene },
+    { '8', "8 - CONTAGEM REGRESSIVA 5, 4, 3, 2, 1", tarefa_animacao, &animacao_8_countdown, 200, 500 },
+    { '9', "9 - PISCA PISCA PERSONALIZADO", tarefa_animacao, &animacao_9, 600, 80 },
+    { 'A', "LEDs DESLIGADOS", tarefa_cor, .r = COR_FX(0.0), .g = COR_FX(0.0), .b = COR_FX(0.0) },
+    { 'B', "TODOS OS LEDs EM AZUL 100%", tarefa_cor, .r = COR_FX(0.0), .g = COR_FX(0.0), .b = COR_FX(1.0) },
+    { 'C', "TODOS OS LEDs EM VERMELHO 80%", tarefa_cor, .r = COR_FX(0.8), .g = COR_FX(0.0), .b = COR_FX(0.0) },
+    { 'D', "TODOS OS LEDs EM VERDE 50%", tarefa_cor, .r = COR_FX(0.0), .g = COR_FX(0.5), .b = COR_FX(0.0) },
+    { '#', "TODOS OS LEDs EM BRANCO 20%", tarefa_cor, .r = COR_FX(0.2), .g = COR_FX(0.2), .b = COR_FX(0.2) },
+    // Sem tecla no teclado 4x4: escolhidas pelo USB
+    { 'E', "E - GRADIENTE PROCEDURAL", tarefa_procedural, .proc = &proc_gradiente },
+    { 'F', "F - ONDA PROCEDURAL", tarefa_procedural, .proc = &proc_onda },
+    { 'G', "G - ESPIRAL PROCEDURAL", tarefa_procedural, .proc = &proc_espiral },
+    { 'H', "H - PLASMA PROCEDURAL", tarefa_procedural, .proc = &proc_plasma },
+    { 'I', "I - FAÍSCAS PROCEDURAIS", tarefa_procedural, .proc = &proc_faisca, .buzzer_freq = 1200, .buzzer_duration = 30 },
+    { 'J', "J - CORAÇÃO (PRONTA)", tarefa_pronta, .pronta = &animacao_pronta_coracao },
+    { 'K', "K - CHUVA (PRONTA)", tarefa_pronta, .pronta = &animacao_pronta_chuva },
+    { 'L', "L - ARCO-ÍRIS (PRONTA)", tarefa_pronta, .pronta = &animacao_pronta_arco_iris },
+    { 'M', "M - CONTAGEM SOBRE O GRADIENTE", tarefa_composicao, .comp = &composicao_contagem },
+    { 'N', "N - TRANSIÇÃO ESPIRAL -> BARRAS", tarefa_composicao, .comp = &composicao_transicao },
+    { 'O', "O - NOME LORENZO ROLANDO", tarefa_texto, .texto = "LORENZO", .estilo = &estilo_nome },
+    { 'T', "T - TEXTO DO USB", tarefa_texto, .estilo = &estilo_usb },
+    { 'V', "V - VISUALIZADOR DE ÁUDIO", tarefa_visualizador },
+};
+
+static const AcaoTecla *buscar_acao(char tecla) {
+    for (size_t i = 0; i < count_of(acoes); i++) {
+        if (acoes[i].tecla == tecla) {
+            return &acoes[i];
+        }
+    }
+    return NULL;
+}
+
 void exibir_mensagem(const char *mensagem) {
     printf("\n\n========== %s ==========\n", mensagem);
 }
 
-int main() {
-    PIO pio = pio0;
-    uint offset, sm;
+// Lê do USB uma linha de até TEXTO_MAX bytes; termina no '\n' (ou '\r') ou depois de
+// TEXTO_TIMEOUT_US sem caracteres. Retorna false se a linha vier vazia.
+static bool ler_linha_usb(char *linha) {
+    uint n = 0;
+    while (true) {
+        int c = getchar_timeout_us(TEXTO_TIMEOUT_US);
+        if (c == PICO_ERROR_TIMEOUT || c == '\n' || c == '\r') {
+            break;
+        }
+        if (n < TEXTO_MAX) {
+            linha[n++] = (char)c;
+        }
+    }
+    linha[n] = '\0';
+    return n > 0;
+}
 
+int main() {
     // Configurações iniciais
     stdio_init_all();
     setup_gpio();
-    init_matriz_led(pio, &offset, &sm);
+    compactacao_init(animacoes, count_of(animacoes));
+    acervo_init();
+
+    // PIO e DMA da saída no núcleo de renderização (núcleo 1 no modo de dois núcleos)
+    pipeline_init(&config_saida);
+    energia_init();
 
     while (true) {
-        char key = detect_key();
+        // Pedidos de som feitos pelo núcleo de renderização
+        buzzer_processar();
+
+        // Comandos pelo USB: 'j' atraso dos quadros, 'k' latência das teclas, 'n' uso dos núcleos,
+        // 'b' ciclos por quadro da conversão de cores, 'g' liga/desliga gama + dithering,
+        // 'd' tamanho e custo de decodificação dos quadros compactados, 'p' ciclos dos
+        // geradores procedurais contra o orçamento do quadro, 'c' ciclos por camada do
+        // compositor, 't<texto>' rola o texto (até o fim da linha), 'r' liga/desliga o
+        // rastro, 'x' relatório do rastro, 'y' despejo binário do rastro (rastro.h),
+        // 'e' clock e ciclos ativo/dormindo, 'w' liga/desliga o modo ocioso (energia.h),
+        // 'i' troca a curva de interpolação entre quadros-chave, 'q' ciclos da interpolação,
+        // 'l' custo de uma troca de cor em double contra o quadro com paleta,
+        // 'f' ciclos por bloco do espectro do visualizador de áudio (tecla 'V'),
+        // 's' abre o fluxo de quadros binário (fluxo_usb.h), 'u' grava uma animação no acervo
+        // da flash, 'a<id>' toca a animação do acervo, 'm' lista o acervo (acervo.h),
+        // '+'/'-' mudam o andamento das sequências (música, nome e sirene). Outros caracteres
+        // escolhem a ação da tecla correspondente (ex.: '3', 'E', 'J'). Durante o fluxo e a
+        // gravação o USB é só deles.
+        bool usb_ocupado = fluxo_usb_ativo() || acervo_usb_ativo();
+        int comando = usb_ocupado ? PICO_ERROR_TIMEOUT : getchar_timeout_us(0);
+        char key = '\0';
+        if (comando != PICO_ERROR_TIMEOUT) {
+            energia_acordar(); // Comandos e benchmarks sempre no clock cheio
+        }
+        if (comando == 'j') {
+            agendador_relatorio();
+        } else if (comando == 'k') {
+            const LatenciaSaida *lat = saida_led_latencia();
+            printf("Tecla -> primeiro pixel (us): ultima %lu  min %lu  max %lu  (%lu medicoes)\n",
+                   (unsigned long)lat->ultima_us, (unsigned long)lat->min_us,
+                   (unsigned long)lat->max_us, (unsigned long)lat->medicoes);
+        } else if (comando == 'n') {
+            pipeline_relatorio();
+        } else if (comando == 'b') {
+            benchmark_cores(&animacao_0);
+        } else if (comando == 'd') {
+            benchmark_compactacao(animacoes, count_of(animacoes));
+        } else if (comando == 'p') {
+            benchmark_procedural(procedurais, count_of(procedurais));
+        } else if (comando == 'c') {
+            benchmark_compositor();
+        } else if (comando == 'q') {
+            benchmark_interpolacao(curvas_interpolacao, count_of(curvas_interpolacao));
+        } else if (comando == 'l') {
+            benchmark_paleta();
+        } else if (comando == 'f') {
+            benchmark_espectro();
+        } else if (comando == 'i') {
+            // Desligada -> cada curva da tabela -> desligada
+            const ConfigInterpolacao *atual = interpolacao_config();
+            size_t proxima = atual ? (size_t)(atual - curvas_interpolacao) + 1 : 0;
+            interpolacao_definir(proxima < count_of(curvas_interpolacao) ? &curvas_interpolacao[proxima] : NULL);
+            atual = interpolacao_config();
+            if (atual) {
+                printf("Interpolacao entre quadros-chave: %s a %d Hz\n", atual->nome, INTERPOLACAO_HZ);
+            } else {
+                printf("Interpolacao entre quadros-chave: desligada\n");
+            }
+        } else if (comando == '+' || comando == '-') {
+            int passo = comando == '+' ? 25 : -25;
+            sequenciador_definir_andamento(sequenciador_andamento() + passo);
+            printf("Andamento das sequencias: %u%% (maior atraso de evento %lu us)\n",
+                   sequenciador_andamento(), (unsigned long)sequenciador_atraso_max_us());
+        } else if (comando == 'r') {
+            rastro_definir(!rastro_gravando());
+            printf("Rastro: %s\n", rastro_gravando() ? "ligado (zerado)" : "desligado");
+        } else if (comando == 'x') {
+            rastro_relatorio();
+        } else if (comando == 'y') {
+            rastro_despejar();
+        } else if (comando == 'e') {
+            energia_relatorio();
+        } else if (comando == 'w') {
+            energia_definir(!energia_ligada());
+            printf("Modo ocioso: %s\n", energia_ligada() ? "ligado" : "desligado");
+        } else if (comando == 't') {
+            char linha[TEXTO_MAX + 1];
+            if (ler_linha_usb(linha)) {
+                texto_definir(linha);
+                key = 'T';
+            }
+        } else if (comando == 's') {
+            buzzer_stop();
+            exibir_mensagem("FLUXO DE QUADROS PELO USB");
+            pipeline_executar(tarefa_fluxo, NULL);
+        } else if (comando == 'u') {
+            buzzer_stop();
+            exibir_mensagem("GRAVAÇÃO NO ACERVO PELO USB");
+            pipeline_executar(tarefa_acervo, NULL);
+        } else if (comando == 'm') {
+            acervo_relatorio();
+        } else if (comando == 'a') {
+            char linha[TEXTO_MAX + 1];
+            uint id = ler_linha_usb(linha) ? (uint)atoi(linha) : ACERVO_MAX_ANIMACOES;
+            Animacao anim;
+            if (acervo_animacao(id, &anim)) {
+                buzzer_stop();
+                exibir_mensagem("ANIMAÇÃO DO ACERVO");
+                pipeline_executar(tarefa_acervo_animacao, (const void *)(uintptr_t)id);
+            } else {
+                printf("Acervo: id vazio (ids de 0 a %d)\n", ACERVO_MAX_ANIMACOES - 1);
+            }
+        } else if (comando == 'g') {
+            uint32_t refrescos, pulados;
+            saida_led_definir_refresco(!saida_led_refresco_ativo());
+            saida_led_refresco_contadores(&refrescos, &pulados);
+            printf("Gama + dithering a %d Hz: %s (refrescos %lu, pulados %lu)\n", REFRESCO_HZ,
+                   saida_led_refresco_ativo() ? "ligado" : "desligado",
+                   (unsigned long)refrescos, (unsigned long)pulados);
+        } else if (comando != PICO_ERROR_TIMEOUT && comando != '*') {
+            key = (char)comando;
+        }
+
+        if (key == '\0') {
+            key = detect_key();
+        }
         if (key != '\0') {
-            switch (key) {
-                case '0':
-                    exibir_mensagem("0 - GRADIENTE ROSA");
-                    executar_animacao(pio, sm, &animacao_0, 0, 0);
-                    break;
-                case '1':
-                    exibir_mensagem("2 - PISCA PISCA COM BUZZER");
-                    executar_animacao(pio, sm, &animacao_1, 800, 200);
-                    break;
-                case '2':
-                    exibir_mensagem("3 - PISCA PISCA MULTICOLORIDO COM BUZZER");
-                    executar_animacao_multicolor(pio, sm, &animacao_2, 200, 20, 0.0, 1.0, 0.0);
-                    break;
-                case '3':
-                    exibir_mensagem("3 - ESPIRAL COM BUZZER");
-                    executar_animacao(pio, sm, &animacao_3_espiral, 800, 200);
-                    break;
-                case '4':
-                    exibir_mensagem("4 - ANIMAÇÃO DE BARRAS");
-                    executar_animacao(pio, sm, &animacao_4, 500, 100);
-                    break;
-                case '5':
-                    exibir_mensagem("5 - ESCREVER O NOME L O R E N Z O");
-                    executar_animacao_lorenzo(pio, sm);
-                    break;
-                case '6':
-                    exibir_mensagem("6 - MUSICA DÓ, RÉ, MI, FÁ");
-                    executar_animacao_musica(pio, sm);
-                    break;
-                case '7':
-                    exibir_mensagem("7 - SIRENE DE POLÍCIA");
-                    executar_animacao_sirene(pio, sm);
-                    break;
-                case '8':
-                    exibir_mensagem("8 - CONTAGEM REGRESSIVA 5, 4, 3, 2, 1");
-                    executar_animacao(pio, sm, &animacao_8_countdown, 200, 500);
-                    break;
-                case '9':
-                    exibir_mensagem("9 - PISCA PISCA PERSONALIZADO");
-                    executar_animacao(pio, sm, &animacao_9, 600, 80);
-                    break;
-                case 'A':
-                    exibir_mensagem("LEDs DESLIGADOS");
-                    desenho_pio(pio, sm, 0.0, 0.0, 0.0);
-                    break;
-                case 'B':
-                    exibir_mensagem("TODOS OS LEDs EM AZUL 100%");
-                    desenho_pio(pio, sm, 1.0, 0.0, 0.0);
-                    break;
-                case 'C':
-                    exibir_mensagem("TODOS OS LEDs EM VERMELHO 80%");
-                    desenho_pio(pio, sm, 0.0, 0.8, 0.0);
-                    break;
-                case 'D':
-                    exibir_mensagem("TODOS OS LEDs EM VERDE 50%");
-                    desenho_pio(pio, sm, 0.0, 0.0, 0.5);
-                    break;
-                case '#':
-                    exibir_mensagem("TODOS OS LEDs EM BRANCO 20%");
-                    desenho_pio(pio, sm, 0.2, 0.2, 0.2);
-                    break;
-                case '*':
-                    exibir_mensagem("HABILITANDO O MODO GRAVAÇÃO");
-                    sleep_ms (500);
-                    reset_usb_boot(0, 0);
-                    break;
-                default:
-                    break;
+            energia_acordar();
+        } else if (comando == PICO_ERROR_TIMEOUT) {
+            // Nada nesta volta: dorme até a próxima IRQ (ou SEV do outro núcleo)
+            energia_dormir(pipeline_ocioso());
+        }
+        if (key == '*') {
+            exibir_mensagem("HABILITANDO O MODO GRAVAÇÃO");
+            sleep_ms (500);
+            reset_usb_boot(0, 0);
+        } else if (key != '\0') {
+            const AcaoTecla *acao = buscar_acao(key);
+            if (acao) {
+                buzzer_stop(); // Corta o som da animação interrompida
+                exibir_mensagem(acao->mensagem);
+                pipeline_executar(acao->tarefa, acao);
             }
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
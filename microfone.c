@@ -0,0 +1,139 @@
+#include "microfone.h"
+#include "agendador.h"
+#include "ciclos.h"
+#include "rastro.h"
+#include "saida_led.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+#define ADC_CLOCK_HZ 48000000
+#define BLOCO_US (ESPECTRO_N * 1000000u / ESPECTRO_TAXA_HZ)
+
+// Bloco atrasado (ex.: IRQ adiada): volta a olhar depois deste intervalo
+#define ESPERA_EXTRA_US 250
+
+static uint16_t buffers[2][ESPECTRO_N];
+static int canais[2] = { -1, -1 };
+static volatile uint32_t completos = 0;     // Escrito só na IRQ
+static volatile uint32_t ultimo_us = 0;     // time_us_32: lido sem trava no M0+
+static uint32_t entregues = 0;
+static EstatisticasMicrofone estatisticas;
+
+static void bloco_concluido(void) {
+    for (uint i = 0; i < 2; i++) {
+        if (dma_channel_get_irq0_status(canais[i])) {
+            dma_channel_acknowledge_irq0(canais[i]);
+            // O outro canal já começou (encadeado); este volta ao início do seu buffer
+            dma_channel_set_write_addr(canais[i], buffers[i], false);
+            ultimo_us = time_us_32();
+            completos++;
+        }
+    }
+}
+
+static void configurar_canal(uint i) {
+    dma_channel_config c = dma_channel_get_default_config(canais[i]);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    channel_config_set_chain_to(&c, canais[i ^ 1]);
+    dma_channel_configure(canais[i], &c, buffers[i], &adc_hw->fifo, ESPECTRO_N, false);
+}
+
+void microfone_iniciar(void) {
+    if (canais[0] < 0) {
+        adc_init();
+        adc_gpio_init(MICROFONE_GPIO);
+        canais[0] = dma_claim_unused_channel(true);
+        canais[1] = dma_claim_unused_channel(true);
+        irq_add_shared_handler(DMA_IRQ_0, bloco_concluido, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    }
+    espectro_init();
+
+    adc_select_input(MICROFONE_ENTRADA);
+    // Uma amostra de 12 bits por DREQ, sem bit de erro na FIFO
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(ADC_CLOCK_HZ / ESPECTRO_TAXA_HZ - 1);
+    adc_fifo_drain();
+
+    completos = entregues = 0;
+    ultimo_us = time_us_32();
+    estatisticas = (EstatisticasMicrofone) { 0 };
+    for (uint i = 0; i < 2; i++) {
+        configurar_canal(i);
+        dma_channel_acknowledge_irq0(canais[i]);
+        dma_channel_set_irq0_enabled(canais[i], true);
+    }
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    dma_channel_start(canais[0]);
+    adc_run(true);
+}
+
+void microfone_parar(void) {
+    // Sem conversões o canal ativo não termina, então nada é encadeado no meio
+    adc_run(false);
+    for (uint i = 0; i < 2; i++) {
+        dma_channel_set_irq0_enabled(canais[i], false);
+        dma_channel_abort(canais[i]);
+        dma_channel_acknowledge_irq0(canais[i]);
+    }
+    adc_fifo_drain();
+}
+
+const uint16_t *microfone_bloco(void) {
+    uint32_t n = completos;
+    if (n == entregues) {
+        return NULL;
+    }
+    // Mais de um bloco desde a última entrega: os do meio não foram processados
+    estatisticas.perdidos += n - entregues - 1;
+    estatisticas.blocos = n;
+    entregues = n;
+    return buffers[(n - 1) & 1]; // O canal 0 começa, e os dois se alternam
+}
+
+uint64_t microfone_proximo_us(void) {
+    int32_t falta = (int32_t)(ultimo_us + BLOCO_US - time_us_32());
+    return time_us_64() + (falta > 0 ? (uint32_t)falta : 0);
+}
+
+const EstatisticasMicrofone *microfone_estatisticas(void) {
+    return &estatisticas;
+}
+
+void executar_visualizador(void) {
+    uint16_t alturas[ESPECTRO_BANDAS] = { 0 };
+    uint32_t energia[ESPECTRO_BANDAS];
+
+    ciclos_init(); // SysTick do núcleo que renderiza
+    microfone_iniciar();
+    while (true) {
+        const uint16_t *bloco;
+        uint64_t prazo = microfone_proximo_us();
+        while (!(bloco = microfone_bloco())) {
+            if (!agendador_esperar_ate(prazo)) {
+                microfone_parar(); // Outra tecla foi pressionada
+                return;
+            }
+            prazo = time_us_64() + ESPERA_EXTRA_US;
+        }
+
+        uint32_t t0 = RASTRO_INICIO();
+        uint32_t c0 = ciclos_agora();
+        espectro_bandas(bloco, energia);
+        espectro_suavizar(alturas, energia);
+        espectro_desenhar(saida_led_quadro(), alturas);
+        uint32_t gasto = ciclos_desde(c0);
+        RASTRO_FIM(RASTRO_QUADRO, estatisticas.processados, t0);
+
+        estatisticas.processados++;
+        estatisticas.ciclos_soma += gasto;
+        if (gasto > estatisticas.ciclos_max) {
+            estatisticas.ciclos_max = gasto;
+        }
+        saida_led_enviar();
+    }
+}
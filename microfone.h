@@ -0,0 +1,43 @@
+#ifndef MICROFONE_H
+#define MICROFONE_H
+
+#include "pico/stdlib.h"
+#include "espectro.h"
+
+// Captura do microfone: o ADC roda livre a ESPECTRO_TAXA_HZ e dois canais de DMA
+// encadeados enchem dois buffers de ESPECTRO_N amostras, um enquanto o outro é
+// processado (ping-pong). O DMA nunca para entre os blocos, então nenhuma amostra
+// se perde enquanto os quadros vão para o PIO; a IRQ de fim de bloco (DMA_IRQ_0,
+// atendida só no núcleo que chamou microfone_iniciar) só rearma o canal e avisa.
+
+#define MICROFONE_GPIO 28                       // ADC2
+#define MICROFONE_ENTRADA (MICROFONE_GPIO - 26)
+
+typedef struct {
+    uint32_t blocos;        // Blocos completos desde microfone_iniciar
+    uint32_t perdidos;      // Blocos sobrescritos antes de serem processados
+    uint32_t processados;   // Blocos que viraram quadro no visualizador
+    uint64_t ciclos_soma;   // Ciclos do espectro + desenho por bloco processado
+    uint32_t ciclos_max;
+} EstatisticasMicrofone;
+
+// Liga o ADC e o DMA (os canais são reservados na primeira chamada)
+void microfone_iniciar(void);
+
+// Para o ADC e o DMA
+void microfone_parar(void);
+
+// Bloco completo mais recente ainda não entregue, ou NULL. O buffer vale até o
+// DMA voltar a ele, um bloco depois.
+const uint16_t *microfone_bloco(void);
+
+// Instante (time_us_64) em que o próximo bloco deve ficar pronto
+uint64_t microfone_proximo_us(void);
+
+const EstatisticasMicrofone *microfone_estatisticas(void);
+
+// Modo visualizador: uma barra por banda do espectro, um quadro por bloco
+// (62,5 Hz), até outra tecla. Roda no núcleo de renderização.
+void executar_visualizador(void);
+
+#endif
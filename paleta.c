@@ -0,0 +1,31 @@
+#include "paleta.h"
+#include "raster.h"
+
+void paleta_expandir(uint32_t *destino, const uint8_t *indices, uint n, const uint32_t *cores) {
+    // Dois pixels por byte lido
+    uint pares = n / 2;
+    for (uint i = 0; i < pares; i++) {
+        uint8_t par = indices[i];
+        destino[2 * i] = cores[par & 0x0F];
+        destino[2 * i + 1] = cores[par >> 4];
+    }
+    if (n & 1) {
+        destino[n - 1] = cores[indices[pares] & 0x0F];
+    }
+}
+
+void paleta_carregar(QuadroPaleta *q, const uint8_t *niveis) {
+    raster_indices(q->indices, niveis);
+}
+
+void paleta_cor(QuadroPaleta *q, uint16_t r, uint16_t g, uint16_t b) {
+    tabela_niveis(q->cores, r, g, b);
+}
+
+void paleta_definir(QuadroPaleta *q, uint indice, uint16_t r, uint16_t g, uint16_t b) {
+    q->cores[indice % PALETA_CORES] = matrix_rgb(b >> 8, r >> 8, g >> 8);
+}
+
+void paleta_desenhar(const QuadroPaleta *q, uint32_t *quadro) {
+    paleta_expandir(quadro, q->indices, NUM_PIXELS, q->cores);
+}
@@ -0,0 +1,35 @@
+#ifndef PALETA_H
+#define PALETA_H
+
+#include "pico/stdlib.h"
+#include "animacao.h"
+
+// Quadro com paleta: cada pixel guarda um índice de 4 bits e a paleta tem 16
+// palavras GRB já calculadas. Enviar um quadro é só expandir os índices pela
+// paleta; trocar de cor (sirene, fades, eventos COR das sequências) muda só as
+// 16 entradas da paleta, sem decodificar nem recalcular nenhum pixel.
+
+// Uma cor por nível de intensidade das animações: o nível é o próprio índice
+#define PALETA_CORES (NIVEIS_INTENSIDADE + 1)
+
+typedef struct {
+    uint8_t indices[BYTES_POR_QUADRO]; // Na ordem do painel; pixel par no nibble baixo
+    uint32_t cores[PALETA_CORES];      // Palavras GRB
+} QuadroPaleta;
+
+// Expande n índices de 4 bits (dois por byte) em palavras GRB: uma consulta por pixel
+void paleta_expandir(uint32_t *destino, const uint8_t *indices, uint n, const uint32_t *cores);
+
+// Índices a partir de um quadro de níveis de uma Animacao (LeitorQuadros)
+void paleta_carregar(QuadroPaleta *q, const uint8_t *niveis);
+
+// Paleta com os níveis 0..15 de uma cor em 8.8 (como tabela_niveis)
+void paleta_cor(QuadroPaleta *q, uint16_t r, uint16_t g, uint16_t b);
+
+// Uma entrada com uma cor cheia em 8.8, sem escala por nível
+void paleta_definir(QuadroPaleta *q, uint indice, uint16_t r, uint16_t g, uint16_t b);
+
+// Escreve o quadro (NUM_PIXELS) num quadro de palavras GRB, ex.: saida_led_quadro()
+void paleta_desenhar(const QuadroPaleta *q, uint32_t *quadro);
+
+#endif
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include "pipeline.h"
+#include "fila_spsc.h"
+#include "saida_led.h"
+#include "agendador.h"
+#include "teclado.h"
+#include "contador64.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#include "pico/flash.h"
+
+typedef struct {
+    Tarefa tarefa;
+    const void *arg;
+    uint32_t enviado_us;    // time_us_32() no núcleo 0, para medir a latência
+} Comando;
+
+// Contadores do núcleo de renderização (escritos só por ele)
+typedef struct {
+    volatile uint32_t executados;
+    volatile uint32_t latencia_ultima_us;
+    volatile uint32_t latencia_max_us;
+    Contador64 ocioso_us;            // Esperando comando
+    volatile bool pronto;            // Saída inicializada neste núcleo
+} ContadoresRender;
+
+static ContadoresRender render;
+static uint32_t enviados = 0;
+static uint32_t descartados = 0;
+static uint64_t inicio_us = 0;
+
+#if MATRIZ_DOIS_NUCLEOS
+
+static Comando buffer_comandos[PIPELINE_FILA];
+static FilaSpsc fila_comandos;
+
+static const ConfigSaida *config_saida;
+
+// Uma animação em andamento no núcleo 1 para assim que chega um comando novo
+static bool comando_pendente(void) {
+    return !fila_spsc_vazia(&fila_comandos);
+}
+
+static void nucleo1_main(void) {
+    // A IRQ do DMA da saída é habilitada aqui, para ser atendida por este núcleo
+    saida_led_init(config_saida);
+    render.pronto = true;
+
+    while (true) {
+        Comando cmd;
+        uint64_t espera = time_us_64();
+        while (!fila_spsc_retirar(&fila_comandos, &cmd)) {
+            __wfe(); // fila_spsc_inserir() faz SEV
+        }
+        contador64_somar(&render.ocioso_us, time_us_64() - espera);
+
+        uint32_t latencia = time_us_32() - cmd.enviado_us;
+        render.latencia_ultima_us = latencia;
+        if (latencia > render.latencia_max_us) {
+            render.latencia_max_us = latencia;
+        }
+
+        cmd.tarefa(cmd.arg);
+        render.executados++;
+    }
+}
+
+void pipeline_init(const ConfigSaida *config) {
+    config_saida = config;
+    inicio_us = time_us_64();
+
+    fila_spsc_init(&fila_comandos, buffer_comandos, sizeof(Comando), PIPELINE_FILA);
+    agendador_definir_cancelamento(comando_pendente);
+    flash_safe_execute_core_init(); // Gravações do acervo no núcleo 1 pausam este (acervo.h)
+    multicore_launch_core1(nucleo1_main);
+}
+
+void pipeline_executar(Tarefa tarefa, const void *arg) {
+    Comando cmd = { .tarefa = tarefa, .arg = arg, .enviado_us = time_us_32() };
+    if (fila_spsc_inserir(&fila_comandos, &cmd)) {
+        enviados++;
+    } else {
+        descartados++;
+    }
+}
+
+#else
+
+void pipeline_init(const ConfigSaida *config) {
+    inicio_us = time_us_64();
+    saida_led_init(config);
+    render.pronto = true;
+
+    // Uma tecla nova interrompe a animação em andamento
+    agendador_definir_cancelamento(teclado_tecla_pendente);
+}
+
+void pipeline_executar(Tarefa tarefa, const void *arg) {
+    enviados++;
+    render.latencia_ultima_us = 0;
+    tarefa(arg);
+    render.executados++;
+}
+
+#endif
+
+bool pipeline_ocioso(void) {
+    // Só o núcleo 0 envia, então executados == enviados não deixa de valer sozinho
+    return render.pronto && render.executados == enviados;
+}
+
+void pipeline_relatorio(void) {
+    uint64_t decorrido = time_us_64() - inicio_us;
+    uint nucleo_render = MATRIZ_DOIS_NUCLEOS ? 1 : 0;
+    uint64_t ocioso = contador64_ler(&render.ocioso_us) + agendador_espera_us(nucleo_render);
+    uint32_t ocupacao = decorrido ? (uint32_t)(100 - (ocioso * 100) / decorrido) : 0;
+
+    printf("Modo: %s\n", MATRIZ_DOIS_NUCLEOS ? "dois nucleos" : "um nucleo");
+    printf("Nucleo 0: comandos enviados %lu  descartados (fila cheia) %lu\n",
+           (unsigned long)enviados, (unsigned long)descartados);
+    printf("Nucleo %u: comandos executados %lu  quadros %lu (repetidos %lu)  ocupacao %lu%%\n",
+           nucleo_render, (unsigned long)render.executados,
+           (unsigned long)saida_led_quadros(), (unsigned long)saida_led_repetidos(),
+           (unsigned long)ocupacao);
+    printf("Latencia comando -> inicio (us): ultima %lu  max %lu\n",
+           (unsigned long)render.latencia_ultima_us, (unsigned long)render.latencia_max_us);
+}
@@ -0,0 +1,35 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "pico/stdlib.h"
+#include "saida_led.h"
+
+// 1: renderização e saída dos LEDs no núcleo 1; teclado, áudio e USB no núcleo 0.
+// 0: tudo no núcleo 0, como antes.
+#ifndef MATRIZ_DOIS_NUCLEOS
+#define MATRIZ_DOIS_NUCLEOS 1
+#endif
+
+// Capacidade da fila de comandos entre os núcleos (potência de 2)
+#define PIPELINE_FILA 8
+
+// Trabalho de renderização: um reprodutor de animação e seu argumento.
+// O argumento precisa continuar válido enquanto a tarefa roda (ex.: dados const).
+typedef void (*Tarefa)(const void *arg);
+
+// Inicializa a saída dos LEDs no núcleo de renderização e a condição de cancelamento
+// das animações (comando novo no modo de dois núcleos, tecla pendente no outro)
+void pipeline_init(const ConfigSaida *config);
+
+// Executa a tarefa no núcleo de renderização. No modo de dois núcleos só enfileira
+// e retorna; a tarefa em andamento é interrompida no próximo quadro.
+void pipeline_executar(Tarefa tarefa, const void *arg);
+
+// Indica se o núcleo de renderização terminou todas as tarefas enviadas (chamar
+// no núcleo 0). No modo de um núcleo, vale sempre fora de uma tarefa.
+bool pipeline_ocioso(void);
+
+// Imprime os contadores de uso de cada núcleo no stdio (USB)
+void pipeline_relatorio(void);
+
+#endif
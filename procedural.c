@@ -0,0 +1,159 @@
+#include "procedural.h"
+#include "saida_led.h"
+#include "agendador.h"
+#include "buzzer.h"
+#include "cores.h"
+#include "ciclos.h"
+#include "hardware/clocks.h"
+
+// Uma volta em 256 passos, amplitude 127
+static const int8_t tabela_seno[256] = {
+    0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+    49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+    90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+    117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+    127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+    117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+    90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+    49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+    0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+    -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+    -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+    -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+    -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+    -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+    -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+    -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+};
+
+static OrcamentoProcedural orcamento;
+
+int8_t seno8(uint8_t angulo) {
+    return tabela_seno[angulo];
+}
+
+// Onda triangular 0..255..0 numa volta
+static inline uint8_t triangulo(uint8_t a) {
+    return (a < 128) ? (a << 1) : ((255 - a) << 1);
+}
+
+// Distância ao centro aproximada por max + min/2 (sem raiz)
+static inline uint32_t distancia_centro(uint8_t u, uint8_t v) {
+    uint32_t dx = (u > 128) ? u - 128 : 128 - u;
+    uint32_t dy = (v > 128) ? v - 128 : 128 - v;
+    return (dx > dy) ? dx + (dy >> 1) : dy + (dx >> 1);
+}
+
+// Ângulo em 1/256 de volta, com aproximação linear dentro de cada octante
+static uint8_t angulo_centro(uint8_t u, uint8_t v) {
+    int dx = u - 128, dy = v - 128;
+    uint ax = (dx < 0) ? -dx : dx;
+    uint ay = (dy < 0) ? -dy : dy;
+    if (ax == 0 && ay == 0) {
+        return 0;
+    }
+    uint a = (ax >= ay) ? (32 * ay / ax) : (64 - 32 * ax / ay); // 0..64 no primeiro quadrante
+    if (dx < 0) {
+        a = 128 - a;
+    }
+    if (dy < 0) {
+        a = 256 - a;
+    }
+    return (uint8_t)a;
+}
+
+uint8_t gerador_gradiente(uint8_t u, uint8_t v, const ContextoQuadro *c) {
+    return triangulo((uint8_t)((((u + v) * c->escala) >> 5) - c->fase));
+}
+
+uint8_t gerador_onda(uint8_t u, uint8_t v, const ContextoQuadro *c) {
+    uint8_t a = (uint8_t)(((u * c->escala) >> 4) + ((v * c->extra) >> 4) + c->fase);
+    return (uint8_t)(128 + seno8(a));
+}
+
+uint8_t gerador_espiral(uint8_t u, uint8_t v, const ContextoQuadro *c) {
+    uint8_t a = (uint8_t)(angulo_centro(u, v) * c->extra + ((distancia_centro(u, v) * c->escala) >> 3) - c->fase);
+    return triangulo(a);
+}
+
+uint8_t gerador_plasma(uint8_t u, uint8_t v, const ContextoQuadro *c) {
+    uint32_t f = c->fase;
+    int soma = seno8((uint8_t)(((u * c->escala) >> 4) + f))
+             + seno8((uint8_t)(((v * c->escala) >> 4) - (f >> 1)))
+             + seno8((uint8_t)((((u + v) * c->escala) >> 5) + (f >> 2)))
+             + seno8((uint8_t)(((distancia_centro(u, v) * c->escala) >> 3) - f));
+    return (uint8_t)(128 + (soma >> 2));
+}
+
+uint8_t gerador_faisca(uint8_t u, uint8_t v, const ContextoQuadro *c) {
+    // Cada volta da fase sorteia novos pixels, que apagam ao longo da volta
+    uint32_t h = (u * 73856093u) ^ (v * 19349663u) ^ ((c->fase >> 8) * 83492791u);
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    if ((h & 0xFF) >= (uint32_t)c->escala) {
+        return 0;
+    }
+    return (uint8_t)(255 - (c->fase & 0xFF));
+}
+
+void procedural_renderizar(const AnimacaoProcedural *a, uint32_t t_ms, uint32_t *quadro, uint largura, uint altura) {
+    ContextoQuadro c = {
+        .t_ms = t_ms,
+        .fase = (uint32_t)((uint64_t)t_ms * a->velocidade / 1000),
+        .escala = a->escala,
+        .extra = a->extra,
+    };
+
+    // Passo de u e v em 8.8, para cobrir 0..255 de ponta a ponta sem divisões por pixel
+    uint32_t passo_u = largura > 1 ? (255u << 8) / (largura - 1) : 0;
+    uint32_t passo_v = altura > 1 ? (255u << 8) / (altura - 1) : 0;
+
+    for (uint y = 0; y < altura; y++) {
+        uint8_t v = (uint8_t)((y * passo_v + 128) >> 8);
+        for (uint x = 0; x < largura; x++) {
+            uint8_t u = (uint8_t)((x * passo_u + 128) >> 8);
+            uint8_t n = a->gerador(u, v, &c);
+            quadro[raster_indice_em(x, y, largura, altura)] = cor_escalada(a->r, a->g, a->b, n);
+        }
+    }
+}
+
+void executar_procedural(const AnimacaoProcedural *a, int buzzer_freq, int buzzer_duration) {
+    int num_quadros = (int)(a->duracao_ms * a->fps / 1000);
+
+    orcamento = (OrcamentoProcedural) {
+        .nome = a->nome,
+        .orcamento = clock_get_hz(clk_sys) / a->fps,
+    };
+    ciclos_init(); // SysTick do núcleo que renderiza
+
+    Agendador ag;
+    agendador_iniciar(&ag, a->fps * 1000);
+    for (int frame = 0; frame < num_quadros; frame++) {
+        uint32_t t0 = ciclos_agora();
+        procedural_renderizar(a, (uint32_t)frame * 1000 / a->fps, saida_led_quadro(), MATRIZ_LARGURA, MATRIZ_ALTURA);
+        uint32_t gasto = ciclos_desde(t0);
+
+        orcamento.quadros++;
+        orcamento.soma_ciclos += gasto;
+        if (gasto > orcamento.max_ciclos) {
+            orcamento.max_ciclos = gasto;
+        }
+        if (gasto > orcamento.orcamento) {
+            orcamento.estouros++;
+        }
+
+        saida_led_enviar();
+        if (buzzer_freq > 0 && buzzer_duration > 0 && frame % a->fps == 0) {
+            buzzer_tone(buzzer_freq, buzzer_duration); // Um toque por segundo
+        }
+        if (!agendador_esperar(&ag)) {
+            break; // Outra tecla foi pressionada
+        }
+    }
+}
+
+const OrcamentoProcedural *procedural_orcamento(void) {
+    return &orcamento;
+}
@@ -0,0 +1,60 @@
+#ifndef PROCEDURAL_H
+#define PROCEDURAL_H
+
+#include "pico/stdlib.h"
+#include "raster.h"
+
+// Estado do quadro, calculado uma vez por quadro e passado a cada pixel
+typedef struct {
+    uint32_t t_ms;     // Tempo desde o início da animação
+    uint32_t fase;     // t_ms * velocidade, em 1/256 de volta (não dá a volta)
+    int16_t escala;    // Repetições do padrão na matriz, em 1/16 (16 = uma vez)
+    int16_t extra;     // Parâmetro próprio de cada gerador
+} ContextoQuadro;
+
+// Intensidade 0..255 do ponto (u, v). u e v vão de 0 a 255 na largura e na altura,
+// qualquer que seja a resolução; só aritmética inteira e a tabela de seno.
+typedef uint8_t (*GeradorPixel)(uint8_t u, uint8_t v, const ContextoQuadro *c);
+
+// Animação calculada por pixel, sem quadros guardados
+typedef struct {
+    const char *nome;
+    GeradorPixel gerador;
+    int16_t velocidade;  // 1/256 de volta por segundo
+    int16_t escala;
+    int16_t extra;
+    uint16_t r, g, b;    // Cor em ponto fixo 8.8 (use COR_FX)
+    int fps;
+    uint32_t duracao_ms;
+} AnimacaoProcedural;
+
+// Geradores prontos
+uint8_t gerador_gradiente(uint8_t u, uint8_t v, const ContextoQuadro *c); // Faixas diagonais
+uint8_t gerador_onda(uint8_t u, uint8_t v, const ContextoQuadro *c);      // Seno; extra inclina a onda
+uint8_t gerador_espiral(uint8_t u, uint8_t v, const ContextoQuadro *c);   // extra = número de braços
+uint8_t gerador_plasma(uint8_t u, uint8_t v, const ContextoQuadro *c);    // Soma de quatro senos
+uint8_t gerador_faisca(uint8_t u, uint8_t v, const ContextoQuadro *c);    // escala = densidade (0..255)
+
+// Seno de um ângulo em 1/256 de volta, de -127 a 127
+int8_t seno8(uint8_t angulo);
+
+// Desenha o instante t_ms em `quadro` (largura x altura pontos, na ordem de
+// raster_indice_em: a do painel montado no tamanho da matriz)
+void procedural_renderizar(const AnimacaoProcedural *a, uint32_t t_ms, uint32_t *quadro, uint largura, uint altura);
+
+// Orçamento e uso de ciclos por quadro da última animação procedural executada
+typedef struct {
+    const char *nome;
+    uint32_t quadros;
+    uint32_t orcamento;  // Ciclos disponíveis por quadro no FPS da animação
+    uint32_t max_ciclos;
+    uint64_t soma_ciclos;
+    uint32_t estouros;   // Quadros cuja renderização passou do orçamento
+} OrcamentoProcedural;
+
+// Executa a animação na matriz pelo tempo configurado, medindo cada quadro
+void executar_procedural(const AnimacaoProcedural *a, int buzzer_freq, int buzzer_duration);
+
+const OrcamentoProcedural *procedural_orcamento(void);
+
+#endif
@@ -0,0 +1,19 @@
+#include <string.h>
+#include "quadros_prontos.h"
+#include "agendador.h"
+#include "buzzer.h"
+
+void executar_pronta(const AnimacaoPronta *a) {
+    Agendador ag;
+    agendador_iniciar(&ag, a->fps * 1000);
+    for (uint q = 0; q < a->num_quadros; q++) {
+        memcpy(saida_led_quadro(), a->quadros[q], sizeof(a->quadros[q]));
+        saida_led_enviar();
+        if (a->tons && a->tons[q][0] > 0) {
+            buzzer_tone(a->tons[q][0], a->tons[q][1]);
+        }
+        if (!agendador_esperar(&ag)) {
+            break; // Outra tecla foi pressionada
+        }
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef QUADROS_PRONTOS_H
+#define QUADROS_PRONTOS_H
+
+#include "pico/stdlib.h"
+#include "saida_led.h"
+
+// Animação já codificada em palavras GRB, gerada no build por compilar_animacoes
+// (host/) a partir das imagens e do manifesto em animacoes/. Os quadros ficam em
+// flash e tocar é só copiar cada um para a saída, sem conta por pixel.
+typedef struct {
+    const char *nome;
+    const uint32_t (*quadros)[NUM_PIXELS];
+    uint16_t num_quadros;
+    uint16_t fps;
+    const uint16_t (*tons)[2];  // Por quadro: frequência (0 = nenhum) e duração em ms; NULL = sem som
+} AnimacaoPronta;
+
+// Toca a animação uma vez; para antes se outra tecla for pressionada
+void executar_pronta(const AnimacaoPronta *a);
+
+#endif
@@ -0,0 +1,222 @@
+#include "raster.h"
+#include "raster.hpp"
+#include "saida_led.h"
+
+using namespace raster;
+
+// Layout de cada opção de MATRIZ_PAINEL, escolhido por especialização
+template <int N>
+struct Painel;
+
+template <>
+struct Painel<PAINEL_SERPENTINA> {
+    using Tipo = Serpentina<MATRIZ_LARGURA, MATRIZ_ALTURA>;
+};
+
+template <>
+struct Painel<PAINEL_POR_LINHAS> {
+    using Tipo = PorLinhas<MATRIZ_LARGURA, MATRIZ_ALTURA>;
+};
+
+template <>
+struct Painel<PAINEL_GIRADO_90> {
+    using Tipo = Girado90<Serpentina<MATRIZ_ALTURA, MATRIZ_LARGURA>>;
+};
+
+template <>
+struct Painel<PAINEL_GIRADO_180> {
+    using Tipo = Girado180<Serpentina<MATRIZ_LARGURA, MATRIZ_ALTURA>>;
+};
+
+template <>
+struct Painel<PAINEL_GIRADO_270> {
+    using Tipo = Girado270<Serpentina<MATRIZ_ALTURA, MATRIZ_LARGURA>>;
+};
+
+template <>
+struct Painel<PAINEL_ESPELHADO> {
+    using Tipo = Espelhado<Serpentina<MATRIZ_LARGURA, MATRIZ_ALTURA>>;
+};
+
+using PainelMatriz = Painel<MATRIZ_PAINEL>::Tipo;
+
+// Ordem em que os quadros das animações (QUADRO em animacao.h) foram escritos
+using Autoria = Serpentina<MATRIZ_LARGURA, MATRIZ_ALTURA>;
+
+static_assert(Mapa<PainelMatriz>::largura == MATRIZ_LARGURA && Mapa<PainelMatriz>::altura == MATRIZ_ALTURA,
+              "o painel precisa ter as dimensoes da matriz");
+static_assert(Mapa<PainelMatriz>::pixels == NUM_PIXELS, "a matriz precisa ter NUM_PIXELS pixels");
+
+extern "C" uint raster_indice(uint x, uint y) {
+    return Mapa<PainelMatriz>::indice(x, y);
+}
+
+extern "C" uint raster_indice_em(uint x, uint y, uint largura, uint altura) {
+    if (largura == MATRIZ_LARGURA && altura == MATRIZ_ALTURA) {
+        return Mapa<PainelMatriz>::indice(x, y);
+    }
+    return indice_serpentina(x, y, largura, altura);
+}
+
+extern "C" uint raster_indice_autoria(uint x, uint y) {
+    return Mapa<Autoria>::indice(x, y);
+}
+
+extern "C" void raster_preencher(uint32_t *quadro, uint32_t cor) {
+    Raster<PainelMatriz>(quadro).preencher(cor);
+}
+
+extern "C" void raster_niveis(uint32_t *quadro, const uint8_t *niveis, const uint32_t *tabela_par,
+                              const uint32_t *tabela_impar) {
+    Raster<PainelMatriz>(quadro).sprite(0, 0, Sprite<Autoria>{ niveis }, [=](uint8_t n, unsigned i) {
+        return (i & 1) ? tabela_impar[n] : tabela_par[n];
+    });
+}
+
+extern "C" void raster_indices(uint8_t *indices, const uint8_t *niveis) {
+    uint8_t painel[NUM_PIXELS + 1] = {}; // O nibble alto do último byte fica em 0
+    Copia<Autoria, PainelMatriz>::copiar(painel, niveis, [](uint8_t n, unsigned) { return n; });
+    for (unsigned i = 0; i < NUM_PIXELS; i += 2) {
+        indices[i / 2] = (uint8_t)(painel[i] | (painel[i + 1] << 4));
+    }
+}
+
+// Conferência dos layouts e das primitivas, tabela a tabela, a cada build
+
+// Tabela (x, y) -> índice de um layout, por linhas, para comparar com a esperada
+template <class P>
+constexpr std::array<unsigned, Mapa<P>::pixels> indices() {
+    std::array<unsigned, Mapa<P>::pixels> t{};
+    for (unsigned y = 0; y < Mapa<P>::altura; y++) {
+        for (unsigned x = 0; x < Mapa<P>::largura; x++) {
+            t[y * Mapa<P>::largura + x] = Mapa<P>::indice(x, y);
+        }
+    }
+    return t;
+}
+
+// O operator== de std::array só é constexpr a partir do C++20
+template <class T, size_t N>
+constexpr bool iguais(const std::array<T, N> &a, const std::array<T, N> &b) {
+    for (size_t i = 0; i < N; i++) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Cada posição da cadeia aparece uma vez só
+template <class P>
+constexpr bool permutacao() {
+    std::array<bool, Mapa<P>::pixels> visto{};
+    for (unsigned i : indices<P>()) {
+        if (i >= Mapa<P>::pixels || visto[i]) {
+            return false;
+        }
+        visto[i] = true;
+    }
+    return true;
+}
+
+// Painel de 3 x 2: a serpentina começa embaixo à direita
+//   3 4 5
+//   2 1 0
+using S32 = Serpentina<3, 2>;
+static_assert(iguais(indices<PorLinhas<3, 2>>(), std::array<unsigned, 6>{ 0, 1, 2, 3, 4, 5 }));
+static_assert(iguais(indices<S32>(), std::array<unsigned, 6>{ 3, 4, 5, 2, 1, 0 }));
+static_assert(iguais(indices<Girado90<S32>>(), std::array<unsigned, 6>{ 2, 3, 1, 4, 0, 5 }));
+static_assert(iguais(indices<Girado180<S32>>(), std::array<unsigned, 6>{ 0, 1, 2, 5, 4, 3 }));
+static_assert(iguais(indices<Girado270<S32>>(), std::array<unsigned, 6>{ 5, 0, 4, 1, 3, 2 }));
+static_assert(iguais(indices<Espelhado<S32>>(), std::array<unsigned, 6>{ 5, 4, 3, 0, 1, 2 }));
+static_assert(iguais(indices<Invertido<S32>>(), std::array<unsigned, 6>{ 2, 1, 0, 3, 4, 5 }));
+static_assert(Mapa<Girado90<S32>>::largura == 2 && Mapa<Girado90<S32>>::altura == 3);
+// Serpentina fora do tamanho da matriz, como a de raster_indice_em
+static_assert(iguais(indices<Serpentina<8, 3>>(),
+                     std::array<unsigned, 24>{ 23, 22, 21, 20, 19, 18, 17, 16,
+                                               8, 9, 10, 11, 12, 13, 14, 15,
+                                               7, 6, 5, 4, 3, 2, 1, 0 }));
+
+// A matriz de diagram.json: o pixel 0 é o canto de baixo à direita e o 24 o de cima à esquerda
+static_assert(Mapa<Autoria>::indice(4, 4) == 0 && Mapa<Autoria>::indice(0, 4) == 4);
+static_assert(Mapa<Autoria>::indice(0, 3) == 5 && Mapa<Autoria>::indice(0, 0) == 24);
+
+// Quatro giros voltam ao começo; dois espelhamentos também
+static_assert(iguais(indices<Girado90<Girado90<Girado90<Girado90<S32>>>>>(), indices<S32>()));
+static_assert(iguais(indices<Espelhado<Espelhado<S32>>>(), indices<S32>()));
+static_assert(iguais(indices<Girado180<S32>>(), indices<Espelhado<Invertido<S32>>>()));
+
+static_assert(permutacao<Painel<PAINEL_SERPENTINA>::Tipo>());
+static_assert(permutacao<Painel<PAINEL_POR_LINHAS>::Tipo>());
+static_assert(permutacao<Painel<PAINEL_GIRADO_90>::Tipo>());
+static_assert(permutacao<Painel<PAINEL_GIRADO_180>::Tipo>());
+static_assert(permutacao<Painel<PAINEL_GIRADO_270>::Tipo>());
+static_assert(permutacao<Painel<PAINEL_ESPELHADO>::Tipo>());
+
+// Primitivas: desenha num quadro do layout P e lê de volta por linhas; o resultado
+// tem que ser o mesmo em qualquer layout
+enum class Teste { LINHA, RETANGULO, SPRITE, TRANSPARENTE, QUADRO };
+
+template <class P>
+constexpr std::array<uint32_t, 6> desenhar(Teste teste) {
+    std::array<uint32_t, 6> pixels{};
+    Raster<P> r(pixels.data());
+    auto valor = [](uint8_t v, unsigned) { return uint32_t{ v }; };
+    constexpr uint8_t bloco[] = { 1, 2, 3, 4 };       // 2 x 2 por linhas
+    constexpr uint8_t mascara[] = { 0, 5, 0, 6 };
+    constexpr uint8_t cadeia[] = { 10, 11, 12, 13, 14, 15 }; // Na ordem da serpentina
+    switch (teste) {
+    case Teste::LINHA:
+        r.linha(0, 0, 2, 1, 1);
+        break;
+    case Teste::RETANGULO:
+        r.retangulo(-1, 1, 3, 5, 2); // Recortado à esquerda e embaixo
+        break;
+    case Teste::SPRITE:
+        r.sprite(2, -1, Sprite<PorLinhas<2, 2>>{ bloco }, valor); // Só o 3 aparece
+        break;
+    case Teste::TRANSPARENTE:
+        r.preencher(9);
+        r.sprite(0, 0, Sprite<PorLinhas<2, 2>>{ mascara }, valor, true);
+        break;
+    case Teste::QUADRO:
+        r.sprite(0, 0, Sprite<S32>{ cadeia }, valor);
+        break;
+    }
+    std::array<uint32_t, 6> imagem{};
+    for (unsigned y = 0; y < 2; y++) {
+        for (unsigned x = 0; x < 3; x++) {
+            imagem[y * 3 + x] = pixels[Mapa<P>::indice(x, y)];
+        }
+    }
+    return imagem;
+}
+
+struct CasoPrimitiva {
+    Teste teste;
+    std::array<uint32_t, 6> imagem; // Por linhas
+};
+
+static constexpr CasoPrimitiva casos[] = {
+    { Teste::LINHA, { 1, 0, 0, 0, 1, 1 } },
+    { Teste::RETANGULO, { 0, 0, 0, 2, 2, 0 } },
+    { Teste::SPRITE, { 0, 0, 3, 0, 0, 0 } },
+    { Teste::TRANSPARENTE, { 9, 5, 9, 9, 6, 9 } },
+    { Teste::QUADRO, { 13, 14, 15, 12, 11, 10 } },
+};
+
+template <class P>
+constexpr bool primitivas() {
+    for (const CasoPrimitiva &c : casos) {
+        if (!iguais(desenhar<P>(c.teste), c.imagem)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(primitivas<PorLinhas<3, 2>>());
+static_assert(primitivas<S32>()); // QUADRO pela cópia linear (mesmo layout)
+static_assert(primitivas<Girado180<S32>>());
+static_assert(primitivas<Espelhado<S32>>());
+static_assert(primitivas<Invertido<S32>>());
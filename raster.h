@@ -0,0 +1,60 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "pico/stdlib.h"
+
+// Desenho em (x, y) na matriz, com x = 0 à esquerda e y = 0 em cima, vista de
+// frente. A ordem da cadeia de LEDs do painel fica só aqui: as tabelas (x, y) ->
+// índice são geradas na compilação por raster.hpp (C++17), e o código C usa as
+// funções abaixo.
+
+// Dimensões da matriz de LEDs
+#define MATRIZ_LARGURA 5
+#define MATRIZ_ALTURA 5
+
+// Layouts do painel montado (MATRIZ_PAINEL, também uma opção do CMake)
+#define PAINEL_SERPENTINA 0   // Linhas alternadas a partir do canto de baixo à direita (diagram.json)
+#define PAINEL_POR_LINHAS 1   // De cima para baixo, cada linha da esquerda para a direita
+#define PAINEL_GIRADO_90 2    // A serpentina girada 90 graus no sentido horário
+#define PAINEL_GIRADO_180 3
+#define PAINEL_GIRADO_270 4
+#define PAINEL_ESPELHADO 5    // A serpentina espelhada (esquerda <-> direita)
+
+#ifndef MATRIZ_PAINEL
+#define MATRIZ_PAINEL PAINEL_SERPENTINA
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Posição na cadeia de LEDs do ponto (x, y) da matriz
+uint raster_indice(uint x, uint y);
+
+// Posição na cadeia do ponto (x, y) de um quadro de largura x altura: com as
+// dimensões da matriz, a do painel montado (raster_indice); com outras, uma cadeia
+// em serpentina desse tamanho, como a de diagram.json (faixas maiores ou menores)
+uint raster_indice_em(uint x, uint y, uint largura, uint altura);
+
+// Posição do ponto (x, y) nos quadros das animações (QUADRO em animacao.h), que
+// seguem a cadeia de diagram.json qualquer que seja o painel montado
+uint raster_indice_autoria(uint x, uint y);
+
+// Todos os pixels do quadro com a mesma cor (palavra GRB)
+void raster_preencher(uint32_t *quadro, uint32_t cor);
+
+// Desenha um quadro de níveis (0..15) de uma Animacao no quadro da saída. As
+// tabelas das animações foram escritas na ordem da cadeia de diagram.json; cada
+// nível vira tabela_par[n] nos índices pares dessa ordem e tabela_impar[n] nos
+// ímpares. Com o painel na mesma ordem, é uma consulta por pixel.
+void raster_niveis(uint32_t *quadro, const uint8_t *niveis, const uint32_t *tabela_par, const uint32_t *tabela_impar);
+
+// Mesmo quadro de níveis, guardado como índices de 4 bits na ordem do painel
+// (dois por byte, o pixel par no nibble baixo, como em animacao.h)
+void raster_indices(uint8_t *indices, const uint8_t *niveis);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef RASTER_HPP
+#define RASTER_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+// Camada de desenho em (x, y) para o código C++17: x = 0 na coluna da esquerda e
+// y = 0 na linha de cima, com a matriz vista de frente. O layout do painel (a
+// ordem em que a cadeia de LEDs passa pelos pontos) é um tipo; a tabela
+// (x, y) -> índice na cadeia de cada layout é gerada na compilação, e as cópias
+// entre dois quadros no mesmo layout viram um laço linear por especialização.
+// Nada disso custa em tempo de execução além de uma consulta por pixel.
+namespace raster {
+
+// Layouts básicos: cada um responde em que posição da cadeia fica o ponto (x, y)
+
+// Linha por linha, de cima para baixo e da esquerda para a direita
+template <unsigned L, unsigned A>
+struct PorLinhas {
+    static constexpr unsigned largura = L, altura = A;
+    static constexpr unsigned indice(unsigned x, unsigned y) { return y * L + x; }
+};
+
+// Linhas alternadas a partir do canto de baixo à direita: a primeira linha da
+// cadeia (a de baixo) vai da direita para a esquerda, a seguinte volta, e assim
+// por diante (a matriz de diagram.json). A função serve também para tamanhos
+// conhecidos só em tempo de execução.
+constexpr unsigned indice_serpentina(unsigned x, unsigned y, unsigned largura, unsigned altura) {
+    unsigned linha = altura - 1 - y;
+    return linha * largura + ((linha & 1) ? x : largura - 1 - x);
+}
+
+template <unsigned L, unsigned A>
+struct Serpentina {
+    static constexpr unsigned largura = L, altura = A;
+    static constexpr unsigned indice(unsigned x, unsigned y) { return indice_serpentina(x, y, L, A); }
+};
+
+// Transformações de um layout P, para painéis montados girados ou espelhados.
+// Giros no sentido horário; nos de 90 e 270 graus largura e altura trocam.
+template <class P>
+struct Girado90 {
+    static constexpr unsigned largura = P::altura, altura = P::largura;
+    static constexpr unsigned indice(unsigned x, unsigned y) { return P::indice(y, P::altura - 1 - x); }
+};
+
+template <class P>
+struct Girado180 {
+    static constexpr unsigned largura = P::largura, altura = P::altura;
+    static constexpr unsigned indice(unsigned x, unsigned y) {
+        return P::indice(P::largura - 1 - x, P::altura - 1 - y);
+    }
+};
+
+template <class P>
+struct Girado270 {
+    static constexpr unsigned largura = P::altura, altura = P::largura;
+    static constexpr unsigned indice(unsigned x, unsigned y) { return P::indice(P::largura - 1 - y, x); }
+};
+
+// Espelhado na horizontal (esquerda <-> direita)
+template <class P>
+struct Espelhado {
+    static constexpr unsigned largura = P::largura, altura = P::altura;
+    static constexpr unsigned indice(unsigned x, unsigned y) { return P::indice(P::largura - 1 - x, y); }
+};
+
+// Espelhado na vertical (cima <-> baixo)
+template <class P>
+struct Invertido {
+    static constexpr unsigned largura = P::largura, altura = P::altura;
+    static constexpr unsigned indice(unsigned x, unsigned y) { return P::indice(x, P::altura - 1 - y); }
+};
+
+// Tabela (x, y) -> índice na cadeia de um layout, montada na compilação. Os
+// layouts compostos (ex.: Girado90<Serpentina<...>>) viram uma consulta só.
+template <class P>
+struct Mapa {
+    static constexpr unsigned largura = P::largura, altura = P::altura;
+    static constexpr unsigned pixels = largura * altura;
+    using Indice = std::conditional_t<(pixels <= 256), uint8_t, uint16_t>;
+
+    static constexpr std::array<Indice, pixels> gerar() {
+        std::array<Indice, pixels> t{};
+        for (unsigned y = 0; y < altura; y++) {
+            for (unsigned x = 0; x < largura; x++) {
+                t[y * largura + x] = static_cast<Indice>(P::indice(x, y));
+            }
+        }
+        return t;
+    }
+
+    static constexpr std::array<Indice, pixels> tabela = gerar();
+
+    static constexpr unsigned indice(unsigned x, unsigned y) { return tabela[y * largura + x]; }
+};
+
+// Por linhas o índice é a própria posição: sem tabela
+template <unsigned L, unsigned A>
+struct Mapa<PorLinhas<L, A>> {
+    static constexpr unsigned largura = L, altura = A, pixels = L * A;
+    static constexpr unsigned indice(unsigned x, unsigned y) { return y * L + x; }
+};
+
+// Sprite de largura x altura valores do tipo T, guardados na ordem do layout P
+// (ex.: os quadros das animações, escritos na ordem da cadeia da matriz)
+template <class P, class T = uint8_t>
+struct Sprite {
+    const T *valores;
+};
+
+// Cópia de um sprite inteiro, na origem, para um quadro do mesmo tamanho.
+// `cor(valor, i)` converte o valor do índice i do sprite no pixel do destino
+// (uma palavra GRB, ou um índice de paleta).
+template <class Origem, class Destino>
+struct Copia {
+    template <class D, class T, class Cor>
+    static constexpr void copiar(D *destino, const T *origem, Cor cor) {
+        for (unsigned y = 0; y < Mapa<Origem>::altura; y++) {
+            for (unsigned x = 0; x < Mapa<Origem>::largura; x++) {
+                unsigned i = Mapa<Origem>::indice(x, y);
+                destino[Mapa<Destino>::indice(x, y)] = cor(origem[i], i);
+            }
+        }
+    }
+};
+
+// Mesmo layout dos dois lados: os índices coincidem e a cópia é linear
+template <class P>
+struct Copia<P, P> {
+    template <class D, class T, class Cor>
+    static constexpr void copiar(D *destino, const T *origem, Cor cor) {
+        for (unsigned i = 0; i < Mapa<P>::pixels; i++) {
+            destino[i] = cor(origem[i], i);
+        }
+    }
+};
+
+// Quadro de palavras GRB na ordem da cadeia do painel P
+template <class P>
+class Raster {
+public:
+    static constexpr int largura = Mapa<P>::largura, altura = Mapa<P>::altura;
+
+    explicit constexpr Raster(uint32_t *pixels) : pixels_(pixels) {}
+
+    static constexpr bool dentro(int x, int y) { return x >= 0 && x < largura && y >= 0 && y < altura; }
+
+    constexpr void pixel(int x, int y, uint32_t cor) {
+        if (dentro(x, y)) {
+            pixels_[Mapa<P>::indice(x, y)] = cor;
+        }
+    }
+
+    // A ordem não importa: todos os pixels recebem a mesma cor
+    constexpr void preencher(uint32_t cor) {
+        for (unsigned i = 0; i < Mapa<P>::pixels; i++) {
+            pixels_[i] = cor;
+        }
+    }
+
+    // Retângulo cheio, recortado nas bordas
+    constexpr void retangulo(int x, int y, int l, int a, uint32_t cor) {
+        int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+        int x1 = x + l > largura ? largura : x + l, y1 = y + a > altura ? altura : y + a;
+        for (int j = y0; j < y1; j++) {
+            for (int i = x0; i < x1; i++) {
+                pixels_[Mapa<P>::indice(i, j)] = cor;
+            }
+        }
+    }
+
+    // Bresenham de (x0, y0) a (x1, y1), com as duas pontas; pontos fora são ignorados
+    constexpr void linha(int x0, int y0, int x1, int y1, uint32_t cor) {
+        int dx = x1 > x0 ? x1 - x0 : x0 - x1, sx = x0 < x1 ? 1 : -1;
+        int dy = y1 > y0 ? y0 - y1 : y1 - y0, sy = y0 < y1 ? 1 : -1;
+        int erro = dx + dy;
+        while (true) {
+            pixel(x0, y0, cor);
+            if (x0 == x1 && y0 == y1) {
+                break;
+            }
+            int e2 = 2 * erro;
+            if (e2 >= dy) {
+                erro += dy;
+                x0 += sx;
+            }
+            if (e2 <= dx) {
+                erro += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    // Sprite com o canto de cima à esquerda em (x, y), recortado nas bordas.
+    // `cor(valor, i)` devolve a palavra GRB do valor no índice i do sprite;
+    // com transparente, os valores 0 não cobrem o que está embaixo.
+    template <class Origem, class T, class Cor>
+    constexpr void sprite(int x, int y, Sprite<Origem, T> s, Cor cor, bool transparente = false) {
+        constexpr int sl = Mapa<Origem>::largura, sa = Mapa<Origem>::altura;
+        if (!transparente && x == 0 && y == 0 && sl == largura && sa == altura) {
+            Copia<Origem, P>::copiar(pixels_, s.valores, cor);
+            return;
+        }
+        int i0 = x < 0 ? -x : 0, j0 = y < 0 ? -y : 0;
+        int i1 = x + sl > largura ? largura - x : sl, j1 = y + sa > altura ? altura - y : sa;
+        for (int j = j0; j < j1; j++) {
+            for (int i = i0; i < i1; i++) {
+                unsigned k = Mapa<Origem>::indice(i, j);
+                if (!transparente || s.valores[k] != 0) {
+                    pixels_[Mapa<P>::indice(x + i, y + j)] = cor(s.valores[k], k);
+                }
+            }
+        }
+    }
+
+private:
+    uint32_t *pixels_;
+};
+
+} // namespace raster
+
+#endif
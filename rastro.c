@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <string.h>
+#include "rastro.h"
+#include "hardware/sync.h"
+#include "pico/platform.h"
+
+#if RASTRO_ATIVO
+
+static const char *const nomes[RASTRO_TIPOS] = {
+    [RASTRO_QUADRO] = "quadro",
+    [RASTRO_SAIDA] = "saida",
+    [RASTRO_ACORDAR] = "acordar",
+    [RASTRO_TECLA] = "tecla",
+    [RASTRO_BUZZER] = "buzzer",
+};
+
+static const uint32_t limites_faixas[RASTRO_FAIXAS - 1] = {
+    1, 4, 16, 64, 256, 1024, 4096
+};
+
+// Um anel por núcleo: cada um só é escrito pelo seu núcleo (e pelas IRQs dele)
+typedef struct {
+    EventoRastro eventos[RASTRO_EVENTOS];
+    volatile uint32_t escrita;   // Total de eventos gravados (não dá a volta no índice)
+    EstatisticaRastro estatisticas[RASTRO_TIPOS];
+} AnelRastro;
+
+static AnelRastro aneis[2];
+
+volatile bool rastro_ligado = false;
+
+void rastro_registrar(TipoRastro tipo, uint32_t dado, uint32_t duracao_us) {
+    uint32_t agora = time_us_32();
+    uint nucleo = get_core_num();
+    AnelRastro *a = &aneis[nucleo];
+
+    // As IRQs deste núcleo também gravam; o outro núcleo tem o seu anel
+    uint32_t status = save_and_disable_interrupts();
+    uint32_t i = a->escrita;
+    a->eventos[i & (RASTRO_EVENTOS - 1)] = (EventoRastro) {
+        .tempo_us = agora - duracao_us,
+        .dado = dado,
+        .duracao_us = duracao_us > UINT16_MAX ? UINT16_MAX : (uint16_t)duracao_us,
+        .tipo = (uint8_t)tipo,
+        .nucleo = (uint8_t)nucleo,
+    };
+
+    EstatisticaRastro *e = &a->estatisticas[tipo];
+    e->quantidade++;
+    e->soma_us += duracao_us;
+    if (duracao_us > e->max_us) {
+        e->max_us = duracao_us;
+    }
+    int faixa = 0;
+    while (faixa < RASTRO_FAIXAS - 1 && duracao_us >= limites_faixas[faixa]) {
+        faixa++;
+    }
+    e->histograma[faixa]++;
+
+    a->escrita = i + 1;
+    restore_interrupts(status);
+}
+
+void rastro_definir(bool ligado) {
+    if (ligado && !rastro_ligado) {
+        memset(aneis, 0, sizeof(aneis));
+        __dmb(); // Zerado antes de qualquer núcleo voltar a gravar
+    }
+    rastro_ligado = ligado;
+}
+
+bool rastro_gravando(void) {
+    return rastro_ligado;
+}
+
+void rastro_relatorio(void) {
+    printf("Rastro: %s\n", rastro_ligado ? "ligado" : "desligado");
+    for (uint nucleo = 0; nucleo < 2; nucleo++) {
+        uint32_t gravados = aneis[nucleo].escrita;
+        if (gravados > 0) {
+            printf("  nucleo %u: %lu eventos (%lu sobrescritos)\n", nucleo, (unsigned long)gravados,
+                   (unsigned long)(gravados > RASTRO_EVENTOS ? gravados - RASTRO_EVENTOS : 0));
+        }
+    }
+
+    printf("%-8s %8s %8s %8s   <1 <4 <16 <64 <256 <1k <4k mais (us)\n", "tipo", "qtd", "media", "max");
+    for (int t = 0; t < RASTRO_TIPOS; t++) {
+        // Soma dos dois núcleos (lidos sem parar a gravação: é só um relatório)
+        EstatisticaRastro soma = { 0 };
+        for (uint nucleo = 0; nucleo < 2; nucleo++) {
+            const EstatisticaRastro *e = &aneis[nucleo].estatisticas[t];
+            soma.quantidade += e->quantidade;
+            soma.soma_us += e->soma_us;
+            soma.max_us = e->max_us > soma.max_us ? e->max_us : soma.max_us;
+            for (int f = 0; f < RASTRO_FAIXAS; f++) {
+                soma.histograma[f] += e->histograma[f];
+            }
+        }
+        if (soma.quantidade == 0) {
+            continue;
+        }
+        printf("%-8s %8lu %8lu %8lu  ", nomes[t], (unsigned long)soma.quantidade,
+               (unsigned long)(soma.soma_us / soma.quantidade), (unsigned long)soma.max_us);
+        for (int f = 0; f < RASTRO_FAIXAS; f++) {
+            printf(" %lu", (unsigned long)soma.histograma[f]);
+        }
+        printf("\n");
+    }
+}
+
+void rastro_despejar(void) {
+    // Para a gravação; um registro já em andamento no outro núcleo leva menos de 1 us
+    bool estava = rastro_ligado;
+    rastro_ligado = false;
+    sleep_us(20);
+    __dmb();
+
+    uint32_t inicio[2], quantidade[2];
+    uint total = 0;
+    for (uint nucleo = 0; nucleo < 2; nucleo++) {
+        uint32_t gravados = aneis[nucleo].escrita;
+        quantidade[nucleo] = gravados < RASTRO_EVENTOS ? gravados : RASTRO_EVENTOS;
+        inicio[nucleo] = gravados - quantidade[nucleo];
+        total += quantidade[nucleo];
+    }
+
+    stdio_flush(); // Nada de texto pendente no meio do despejo
+    uint8_t cabecalho[] = { 'R', 'S', RASTRO_VERSAO, (uint8_t)total, (uint8_t)(total >> 8) };
+    stdio_put_string((const char *)cabecalho, sizeof(cabecalho), false, false);
+    for (uint nucleo = 0; nucleo < 2; nucleo++) {
+        for (uint32_t k = 0; k < quantidade[nucleo]; k++) {
+            const EventoRastro *e = &aneis[nucleo].eventos[(inicio[nucleo] + k) & (RASTRO_EVENTOS - 1)];
+            stdio_put_string((const char *)e, sizeof(*e), false, false);
+        }
+    }
+    stdio_flush();
+
+    rastro_ligado = estava;
+}
+
+#else
+
+void rastro_definir(bool ligado) {
+    printf("Rastro removido na compilacao (RASTRO_ATIVO=0)\n");
+}
+
+bool rastro_gravando(void) {
+    return false;
+}
+
+void rastro_relatorio(void) {
+    printf("Rastro removido na compilacao (RASTRO_ATIVO=0)\n");
+}
+
+void rastro_despejar(void) {
+    // Despejo vazio, para o decodificador não ficar esperando
+    static const uint8_t vazio[] = { 'R', 'S', RASTRO_VERSAO, 0, 0 };
+    stdio_put_string((const char *)vazio, sizeof(vazio), false, false);
+    stdio_flush();
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef RASTRO_H
+#define RASTRO_H
+
+#include "pico/stdlib.h"
+
+// Rastro dos caminhos quentes: pontos de medição no render dos quadros, no envio
+// para a saída, nas esperas do agendador, na leitura das teclas e no buzzer. Cada
+// evento leva o instante no timer de 1 MHz e vai para um anel por núcleo (só o
+// próprio núcleo escreve nele, sem trava entre os núcleos), e cada tipo acumula
+// contagem, máximo e histograma das durações.
+//
+// Com RASTRO_ATIVO=0 os pontos somem na compilação. Compilado mas desligado
+// (rastro_ligado == false), cada ponto custa a leitura de uma variável e um desvio.
+
+#ifndef RASTRO_ATIVO
+#define RASTRO_ATIVO 1
+#endif
+
+// Eventos por núcleo no anel (potência de 2); os mais antigos são sobrescritos
+#define RASTRO_EVENTOS 256
+
+// Faixas do histograma de duração: < 1, 4, 16, 64, 256, 1024, 4096 us e acima
+#define RASTRO_FAIXAS 8
+
+typedef enum {
+    RASTRO_QUADRO,    // Decodificar e desenhar um quadro; dado = índice do quadro
+    RASTRO_SAIDA,     // Envio parado esperando o quadro anterior sair (DMA + reset)
+    RASTRO_ACORDAR,   // Atraso ao acordar de uma espera; dado = 1 se foi cancelada
+    RASTRO_TECLA,     // Da varredura do teclado até detect_key; dado = tecla
+    RASTRO_BUZZER,    // Chamada a buzzer_tone; dado = frequência em Hz
+    RASTRO_TIPOS
+} TipoRastro;
+
+// Formato do despejo binário: "RS", versão (1 byte), número de eventos (uint16
+// little-endian) e os eventos como estão na memória (EventoRastro, 12 bytes,
+// little-endian). Decodificado no PC por host/decodificar_rastro.c.
+#define RASTRO_VERSAO 1
+
+typedef struct {
+    uint32_t tempo_us;    // Início (time_us_32)
+    uint32_t dado;
+    uint16_t duracao_us;  // Saturada em 65535
+    uint8_t tipo;
+    uint8_t nucleo;
+} EventoRastro;
+
+typedef struct {
+    uint32_t quantidade;
+    uint32_t max_us;
+    uint64_t soma_us;
+    uint32_t histograma[RASTRO_FAIXAS];
+} EstatisticaRastro;
+
+#if RASTRO_ATIVO
+
+extern volatile bool rastro_ligado;
+
+void rastro_registrar(TipoRastro tipo, uint32_t dado, uint32_t duracao_us);
+
+// Marca o início de um trecho (0 com o rastro desligado)
+#define RASTRO_INICIO() (rastro_ligado ? time_us_32() : 0)
+
+// Fecha o trecho aberto por RASTRO_INICIO
+#define RASTRO_FIM(tipo, dado, inicio) \
+    do { \
+        if (rastro_ligado && (inicio) != 0) { \
+            rastro_registrar((tipo), (dado), time_us_32() - (inicio)); \
+        } \
+    } while (0)
+
+// Evento com a duração já medida (ex.: um atraso)
+#define RASTRO_EVENTO(tipo, dado, duracao_us) \
+    do { \
+        if (rastro_ligado) { \
+            rastro_registrar((tipo), (dado), (duracao_us)); \
+        } \
+    } while (0)
+
+#else
+
+#define RASTRO_INICIO() 0u
+#define RASTRO_FIM(tipo, dado, inicio) ((void)(inicio))
+#define RASTRO_EVENTO(tipo, dado, duracao_us) ((void)0)
+
+#endif
+
+// Liga zerando os anéis e as estatísticas, ou desliga mantendo o que foi gravado
+void rastro_definir(bool ligado);
+bool rastro_gravando(void);
+
+// Contagem, média, máximo e histograma de cada tipo no stdio (USB), em texto
+void rastro_relatorio(void);
+
+// Manda os eventos gravados no formato binário acima, em ordem de gravação por
+// núcleo. A gravação para durante o despejo e volta como estava.
+void rastro_despejar(void);
+
+#endif
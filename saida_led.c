@@ -0,0 +1,435 @@
+#include <string.h>
+#include "saida_led.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico/sem.h"
+#include "cores.h"
+#include "energia.h"
+#include "rastro.h"
+#include "matriz_led.pio.h"
+
+// Palavras que ainda podem estar na FIFO de TX (juntada) quando o DMA termina
+#define PROFUNDIDADE_FIFO 8
+
+// Bit do programa matriz_led e do paralelo: 10 ciclos a 8 MHz (800 kHz)
+#define TEMPO_BIT_NS 1250
+
+// No modo paralelo cada posição de pixel vira 24 bytes (um por bit) = 6 palavras
+#define PALAVRAS_POR_PIXEL_PARALELO 6
+
+// Dois buffers: um sendo transmitido pelo DMA e outro sendo desenhado
+static uint32_t buffers[2][SAIDA_MAX_PIXELS];
+static int indice_tras = 0;
+
+static ConfigSaida config;
+static uint total_pixels = 0;
+static uint inicio_faixa[SAIDA_MAX_FAIXAS];    // Índice do primeiro pixel de cada faixa
+static uint maior_faixa = 0;                   // Pixels da faixa mais longa
+
+// Serial: um canal por faixa, disparados juntos. Paralelo: só o canal 0.
+static int canais_dma[SAIDA_MAX_FAIXAS];
+static uint32_t mascara_canais = 0;
+// Canal da faixa mais longa: é o último a terminar, então só ele gera IRQ
+static int canal_irq = -1;
+// Tempo para a FIFO esvaziar depois do fim do DMA
+static uint32_t atraso_fifo_us = 0;
+
+// State machine de cada faixa (no paralelo, só a da faixa 0) e onde o programa
+// foi carregado em cada bloco PIO (-1: não usado), para refazer os tempos quando o
+// clk_sys muda
+static uint sm_faixa[SAIDA_MAX_FAIXAS];
+static int offset_programa[NUM_PIOS];
+static uint16_t instrucoes_sideset[4];
+static struct pio_program programa_sideset;
+
+// Dados transpostos do modo paralelo
+static uint32_t transposto[SAIDA_MAX_PIXELS * PALAVRAS_POR_PIXEL_PARALELO];
+
+// Evento aguardando o próximo envio para medir a latência (0 = nenhum)
+static volatile uint32_t marca_us = 0;
+static uint32_t quadros_enviados = 0;
+// Quadros idênticos ao que já estava nos LEDs, que não foram retransmitidos
+static uint32_t quadros_repetidos = 0;
+// Obriga o próximo envio a transmitir, mesmo que o quadro seja igual
+static volatile bool forcar_envio = true;
+static LatenciaSaida latencia = { .min_us = UINT32_MAX };
+
+// Modo de alta taxa: o último quadro publicado é reenviado a REFRESCO_HZ com
+// correção de gama e dithering temporal
+static volatile bool refresco_ativo = false;
+static alarm_pool_t *pool_refresco;
+static repeating_timer_t timer_refresco;
+static uint32_t quadro_refresco[SAIDA_MAX_PIXELS];
+static uint8_t erro_dither[SAIDA_MAX_PIXELS][4];
+static uint16_t tabela_gamma[256];
+static volatile uint32_t refrescos = 0;
+static volatile uint32_t refrescos_pulados = 0;
+
+// Liberado quando o quadro anterior terminou de sair e o tempo de reset passou
+static struct semaphore sem_livre;
+
+// Fim do tempo de reset: a linha já ficou em nível baixo o suficiente
+static int64_t fim_reset(alarm_id_t id, void *user_data) {
+    sem_release(&sem_livre);
+    return 0;
+}
+
+// Fim do DMA: as últimas palavras ainda estão na FIFO, então o tempo de reset
+// é contado a partir do momento em que elas terminam de sair
+static void dma_concluido(void) {
+    if (!dma_channel_get_irq0_status(canal_irq)) {
+        return;
+    }
+    dma_channel_acknowledge_irq0(canal_irq);
+    add_alarm_in_us(atraso_fifo_us + TEMPO_RESET_US, fim_reset, NULL, true);
+}
+
+// Bits 0..3 de um nibble espalhados no bit 0 de 4 bytes, o bit 3 no byte mais alto.
+// Deslocado de k, põe os bits de uma faixa no bit k de cada byte (pino base + k).
+static const uint32_t espalhar_nibble[16] = {
+    0x00000000, 0x00000001, 0x00000100, 0x00000101,
+    0x00010000, 0x00010001, 0x00010100, 0x00010101,
+    0x01000000, 0x01000001, 0x01000100, 0x01000101,
+    0x01010000, 0x01010001, 0x01010100, 0x01010101,
+};
+
+// Transpõe o quadro lógico para o programa paralelo: para cada posição de pixel,
+// 6 palavras (G, R e B, 8 bits cada, MSB primeiro), cada byte com um bit de cada
+// faixa. Faixas mais curtas recebem preto até o fim da mais longa.
+static void transpor(const uint32_t *quadro) {
+    uint32_t *saida = transposto;
+    for (uint p = 0; p < maior_faixa; p++) {
+        uint32_t palavras[PALAVRAS_POR_PIXEL_PARALELO] = {0};
+        for (uint k = 0; k < config.num_faixas; k++) {
+            if (p >= config.faixas[k].num_pixels) {
+                continue;
+            }
+            uint32_t grb = quadro[inicio_faixa[k] + p];
+            for (int c = 0; c < 3; c++) {
+                uint32_t byte = grb >> (24 - 8 * c);
+                palavras[2 * c] |= espalhar_nibble[(byte >> 4) & 0xF] << k;
+                palavras[2 * c + 1] |= espalhar_nibble[byte & 0xF] << k;
+            }
+        }
+        for (int i = 0; i < PALAVRAS_POR_PIXEL_PARALELO; i++) {
+            *saida++ = palavras[i];
+        }
+    }
+}
+
+static inline uint bits_faixa(uint k) {
+    return config.faixas[k].rgbw ? 32 : 24;
+}
+
+// Inicia a transmissão de um quadro lógico (o semáforo já foi adquirido)
+static void transmitir(const uint32_t *quadro) {
+    if (config.modo == SAIDA_PARALELA) {
+        transpor(quadro);
+        dma_channel_set_read_addr(canais_dma[0], transposto, true);
+        return;
+    }
+
+    // Todos os canais saem juntos, para as faixas andarem em paralelo
+    for (uint k = 0; k < config.num_faixas; k++) {
+        dma_channel_set_read_addr(canais_dma[k], quadro + inicio_faixa[k], false);
+    }
+    dma_start_channel_mask(mascara_canais);
+}
+
+static void registrar_envio(void) {
+    quadros_enviados++;
+
+    uint32_t marca = marca_us;
+    if (marca) {
+        uint32_t atraso = time_us_32() - marca;
+        marca_us = 0;
+        latencia.medicoes++;
+        latencia.ultima_us = atraso;
+        if (atraso < latencia.min_us) {
+            latencia.min_us = atraso;
+        }
+        if (atraso > latencia.max_us) {
+            latencia.max_us = atraso;
+        }
+    }
+}
+
+// Um canal (0..255) passa pela gama (8.8) e recebe o erro acumulado dos refrescos
+// anteriores; o que sobra abaixo de 1 LSB fica para o próximo refresco
+static inline uint32_t canal_dither(uint32_t palavra, int deslocamento, uint8_t *erro) {
+    uint32_t v = tabela_gamma[(palavra >> deslocamento) & 0xFF] + *erro;
+    *erro = v & 0xFF;
+    return (v >> 8) << deslocamento;
+}
+
+static bool refrescar(repeating_timer_t *t) {
+    if (!refresco_ativo) {
+        return true;
+    }
+
+    // Se o envio anterior ainda não terminou, este refresco é pulado
+    if (!sem_try_acquire(&sem_livre)) {
+        refrescos_pulados++;
+        return true;
+    }
+
+    const uint32_t *fonte = buffers[indice_tras ^ 1];
+    for (uint i = 0; i < total_pixels; i++) {
+        uint32_t p = fonte[i];
+        quadro_refresco[i] = canal_dither(p, 24, &erro_dither[i][0])
+                           | canal_dither(p, 16, &erro_dither[i][1])
+                           | canal_dither(p, 8, &erro_dither[i][2])
+                           | canal_dither(p, 0, &erro_dither[i][3]); // Branco das faixas RGBW
+    }
+    transmitir(quadro_refresco);
+    refrescos++;
+    return true;
+}
+
+// Canal de DMA que alimenta a FIFO de TX de uma state machine, no ritmo dela
+static int configurar_canal(PIO pio, uint sm, uint palavras) {
+    int canal = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(canal);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true)); // Ritmo ditado pela FIFO de TX
+    dma_channel_configure(canal, &c, &pio->txf[sm], NULL, palavras, false);
+    mascara_canais |= 1u << canal;
+    return canal;
+}
+
+// Atrasos de cada fase do programa com side-set para os tempos da configuração no
+// clk_sys atual, em programa_sideset. Retorna o divisor do PIO.
+static float tempos_sideset(void) {
+    TemposLed t = config.tempos ? *config.tempos : TEMPOS_WS2812B;
+    ws2812_sideset_timing ciclos;
+    if (!ws2812_sideset_timing_from_ns(t.t0h_ns, t.t1h_ns, t.periodo_ns, &ciclos)) {
+        panic("saida_led: tempos %u/%u/%u ns fora do alcance do PIO a %lu Hz", t.t0h_ns, t.t1h_ns,
+              t.periodo_ns, (unsigned long)clock_get_hz(clk_sys));
+    }
+    programa_sideset = ws2812_sideset_program_with_timing(&ciclos, instrucoes_sideset);
+    return ciclos.clkdiv;
+}
+
+static inline PIO pio_faixa(uint k) {
+    return config.modo == SAIDA_PARALELA ? config.faixas[0].pio : config.faixas[k].pio;
+}
+
+// Refaz divisor e atrasos para o novo clk_sys, com as state machines paradas
+static void reconfigurar_pio(void) {
+    uint num_sm = config.modo == SAIDA_PARALELA ? 1 : config.num_faixas;
+    for (uint k = 0; k < num_sm; k++) {
+        pio_sm_set_enabled(pio_faixa(k), sm_faixa[k], false);
+    }
+
+    // Os programas matriz_led e paralelo só mudam o divisor (10 ciclos a 8 MHz, com
+    // fração se o clock não for múltiplo); o com side-set pode mudar os atrasos
+    float divisor = clock_get_hz(clk_sys) / 8000000.0f;
+    if (config.modo == SAIDA_SERIAL && config.programa == SAIDA_PIO_SIDESET) {
+        struct pio_program anterior = programa_sideset;
+        divisor = tempos_sideset();
+        bool recarregado[NUM_PIOS] = { false };
+        for (uint k = 0; k < num_sm; k++) {
+            uint indice = pio_get_index(pio_faixa(k));
+            if (!recarregado[indice]) {
+                pio_remove_program(pio_faixa(k), &anterior, offset_programa[indice]);
+                pio_add_program_at_offset(pio_faixa(k), &programa_sideset, offset_programa[indice]);
+                recarregado[indice] = true;
+            }
+        }
+    }
+
+    for (uint k = 0; k < num_sm; k++) {
+        pio_sm_set_clkdiv(pio_faixa(k), sm_faixa[k], divisor);
+        pio_sm_clkdiv_restart(pio_faixa(k), sm_faixa[k]);
+        pio_sm_set_enabled(pio_faixa(k), sm_faixa[k], true);
+    }
+}
+
+// A troca do clk_sys espera o quadro em andamento (e o reset) terminar e segura a
+// saída até o PIO estar no ritmo novo; refrescos nesse meio tempo são pulados
+static void mudanca_clock(EtapaClock etapa) {
+    if (etapa == CLOCK_ANTES) {
+        sem_acquire_blocking(&sem_livre);
+        return;
+    }
+    reconfigurar_pio();
+    sem_release(&sem_livre);
+}
+
+void saida_led_init(const ConfigSaida *cfg) {
+    config = *cfg;
+    if (config.num_faixas == 0 || config.num_faixas > SAIDA_MAX_FAIXAS) {
+        panic("saida_led: %u faixas (max %d)", config.num_faixas, SAIDA_MAX_FAIXAS);
+    }
+
+    // A faixa mais longa é a que leva mais tempo: pixels x bits por pixel
+    uint maior = 0;
+    for (uint k = 0; k < config.num_faixas; k++) {
+        inicio_faixa[k] = total_pixels;
+        total_pixels += config.faixas[k].num_pixels;
+        if (bits_faixa(k) * config.faixas[k].num_pixels > bits_faixa(maior) * config.faixas[maior].num_pixels) {
+            maior = k;
+        }
+    }
+    maior_faixa = config.faixas[maior].num_pixels;
+    if (total_pixels > SAIDA_MAX_PIXELS) {
+        panic("saida_led: %u pixels (max %d)", total_pixels, SAIDA_MAX_PIXELS);
+    }
+
+    sem_init(&sem_livre, 1, 1);
+
+    for (uint i = 0; i < NUM_PIOS; i++) {
+        offset_programa[i] = -1;
+    }
+    if (config.modo == SAIDA_PARALELA) {
+        // Uma state machine no PIO da primeira faixa, com os pinos em sequência
+        PIO pio = config.faixas[0].pio;
+        uint base = config.faixas[0].pino;
+        for (uint k = 0; k < config.num_faixas; k++) {
+            if (config.faixas[k].pino != base + k) {
+                panic("saida_led: modo paralelo pede pinos consecutivos a partir de %u", base);
+            }
+            if (config.faixas[k].rgbw) {
+                panic("saida_led: modo paralelo so com faixas RGB");
+            }
+        }
+        uint offset = pio_add_program(pio, &matriz_led_paralelo_program);
+        uint sm = pio_claim_unused_sm(pio, true);
+        matriz_led_paralelo_program_init(pio, sm, offset, base, config.num_faixas);
+        sm_faixa[0] = sm;
+
+        canais_dma[0] = configurar_canal(pio, sm, maior_faixa * PALAVRAS_POR_PIXEL_PARALELO);
+        canal_irq = canais_dma[0];
+        // Cada palavra na FIFO leva 4 bits
+        atraso_fifo_us = (PROFUNDIDADE_FIFO * 4 * TEMPO_BIT_NS + 999) / 1000;
+    } else {
+        // O programa é carregado uma vez em cada bloco PIO usado
+        const struct pio_program *programa = &matriz_led_program;
+        float divisor = 0;
+        uint tempo_bit_ns = TEMPO_BIT_NS;
+        if (config.programa == SAIDA_PIO_SIDESET) {
+            divisor = tempos_sideset();
+            programa = &programa_sideset;
+            tempo_bit_ns = (config.tempos ? *config.tempos : TEMPOS_WS2812B).periodo_ns;
+        }
+
+        for (uint k = 0; k < config.num_faixas; k++) {
+            const FaixaLed *f = &config.faixas[k];
+            uint indice = pio_get_index(f->pio);
+            if (offset_programa[indice] < 0) {
+                offset_programa[indice] = pio_add_program(f->pio, programa);
+            }
+            uint sm = pio_claim_unused_sm(f->pio, true);
+            if (config.programa == SAIDA_PIO_SIDESET) {
+                ws2812_sideset_program_init(f->pio, sm, offset_programa[indice], f->pino, divisor, bits_faixa(k));
+            } else if (f->rgbw) {
+                panic("saida_led: faixa RGBW pede SAIDA_PIO_SIDESET");
+            } else {
+                matriz_led_program_init(f->pio, sm, offset_programa[indice], f->pino);
+            }
+            sm_faixa[k] = sm;
+            canais_dma[k] = configurar_canal(f->pio, sm, f->num_pixels);
+        }
+        canal_irq = canais_dma[maior];
+        atraso_fifo_us = (PROFUNDIDADE_FIFO * bits_faixa(maior) * tempo_bit_ns + 999) / 1000;
+    }
+
+    // A DMA_IRQ_0 é do núcleo de renderização: a tabela de vetores é uma só para os
+    // dois núcleos, e a mesma linha habilitada nos dois rodaria os handlers nos
+    // dois ao mesmo tempo. O handler é compartilhado com o microfone, que roda
+    // neste núcleo; o buzzer, no núcleo 0, usa a DMA_IRQ_1.
+    irq_add_shared_handler(DMA_IRQ_0, dma_concluido, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    dma_channel_set_irq0_enabled(canal_irq, true);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    // O timer do refresco roda num alarm pool próprio, criado neste núcleo, para
+    // disputar a CPU só com a renderização e não com o teclado e o áudio
+    // O timer só roda com o modo ligado, para não acordar a CPU à toa
+    gamma_tabela(tabela_gamma, GAMMA_PADRAO);
+    pool_refresco = alarm_pool_create_with_unused_hardware_alarm(1);
+
+    energia_observar(mudanca_clock);
+}
+
+uint saida_led_num_pixels(void) {
+    return total_pixels;
+}
+
+uint32_t *saida_led_quadro(void) {
+    return buffers[indice_tras];
+}
+
+void saida_led_enviar(void) {
+    if (refresco_ativo) {
+        // Só publica: o timer do refresco é quem transmite. A troca é uma escrita só,
+        // e o timer roda neste mesmo núcleo, então nunca vê a troca pela metade.
+        indice_tras ^= 1;
+        registrar_envio();
+        return;
+    }
+
+    // Quadro igual ao que está nos LEDs: nada a transmitir, e o buffer de trás
+    // continua valendo como base do próximo quadro
+    uint32_t *tras = buffers[indice_tras];
+    if (!forcar_envio && memcmp(tras, buffers[indice_tras ^ 1], total_pixels * sizeof(uint32_t)) == 0) {
+        quadros_repetidos++;
+        registrar_envio();
+        return;
+    }
+    forcar_envio = false;
+
+    uint32_t t0 = RASTRO_INICIO();
+    sem_acquire_blocking(&sem_livre); // Quadro anterior ainda saindo: o envio para aqui
+    RASTRO_FIM(RASTRO_SAIDA, total_pixels, t0);
+    uint32_t *frente = buffers[indice_tras];
+    indice_tras ^= 1;
+    transmitir(frente);
+    registrar_envio();
+}
+
+void saida_led_aguardar(void) {
+    sem_acquire_blocking(&sem_livre);
+    sem_release(&sem_livre);
+}
+
+void saida_led_marcar(uint32_t evento_us) {
+    marca_us = evento_us ? evento_us : 1;
+}
+
+uint32_t saida_led_quadros(void) {
+    return quadros_enviados;
+}
+
+uint32_t saida_led_repetidos(void) {
+    return quadros_repetidos;
+}
+
+const LatenciaSaida *saida_led_latencia(void) {
+    return &latencia;
+}
+
+void saida_led_definir_refresco(bool ativo) {
+    if (ativo == refresco_ativo) {
+        return;
+    }
+    if (ativo) {
+        refresco_ativo = true;
+        alarm_pool_add_repeating_timer_us(pool_refresco, -(1000000 / REFRESCO_HZ), refrescar, NULL, &timer_refresco);
+    } else {
+        forcar_envio = true; // Os LEDs ainda mostram a versão com dithering
+        refresco_ativo = false;
+        cancel_repeating_timer(&timer_refresco);
+    }
+}
+
+bool saida_led_refresco_ativo(void) {
+    return refresco_ativo;
+}
+
+void saida_led_refresco_contadores(uint32_t *enviados, uint32_t *pulados) {
+    *enviados = refrescos;
+    *pulados = refrescos_pulados;
+}
@@ -0,0 +1,113 @@
+#ifndef SAIDA_LED_H
+#define SAIDA_LED_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Número de LEDs da matriz 5x5 (tamanho dos quadros das animações)
+#define NUM_PIXELS 25
+
+// Limites da saída: faixas (lanes) e pixels no quadro lógico, somando todas as faixas
+#define SAIDA_MAX_FAIXAS 8
+#define SAIDA_MAX_PIXELS 256
+
+// Uma faixa de LEDs (fita ou painel encadeado): bloco PIO, pino de dados e pixels.
+// Em faixas RGBW (SK6812) cada palavra do quadro leva os 32 bits GRBW, com o branco
+// no byte baixo; nas RGB o byte baixo é ignorado.
+typedef struct {
+    PIO pio;
+    uint pino;
+    uint num_pixels;
+    bool rgbw;
+} FaixaLed;
+
+typedef enum {
+    SAIDA_SERIAL,   // Uma state machine e um canal de DMA por faixa, em pio0 ou pio1
+    SAIDA_PARALELA  // Uma state machine desloca até 8 faixas em pinos consecutivos
+} ModoSaida;
+
+// Programa PIO do modo serial
+typedef enum {
+    SAIDA_PIO_SET,      // matriz_led: 7 instruções, 10 ciclos a 8 MHz por bit, só RGB
+    SAIDA_PIO_SIDESET   // ws2812_sideset: 4 instruções, tempos configuráveis, RGB ou RGBW
+} ProgramaSaida;
+
+// Tempos de um bit em ns: alto do 0, alto do 1 e período. Valem para todas as
+// faixas do modo serial com SAIDA_PIO_SIDESET.
+typedef struct {
+    uint16_t t0h_ns;
+    uint16_t t1h_ns;
+    uint16_t periodo_ns;
+} TemposLed;
+
+// WS2812B: 400 ns / 800 ns em 1,25 us (800 kHz)
+#define TEMPOS_WS2812B ((TemposLed){ .t0h_ns = 400, .t1h_ns = 800, .periodo_ns = 1250 })
+
+// O quadro lógico é a concatenação das faixas, na ordem da tabela: os pixels
+// 0..n0-1 vão para a faixa 0, os n0..n0+n1-1 para a faixa 1, e assim por diante.
+// No modo paralelo todas usam o PIO da primeira faixa e pinos pino, pino+1, ...
+typedef struct {
+    const FaixaLed *faixas;
+    uint num_faixas;
+    ModoSaida modo;
+    ProgramaSaida programa;     // Só no modo serial; o paralelo tem programa próprio
+    const TemposLed *tempos;    // NULL: TEMPOS_WS2812B
+} ConfigSaida;
+
+// Tempo em nível baixo que o WS2812 precisa para travar (latch) o quadro.
+// As versões mais novas do WS2812B pedem 280 us; usamos uma folga.
+#define TEMPO_RESET_US 300
+
+// Taxa fixa do modo de alta taxa, independente do FPS das animações. Um quadro de
+// 25 pixels leva 0,75 ms mais o reset, então sobra folga até ~900 Hz; com faixas
+// mais longas os refrescos que não couberem são pulados.
+#define REFRESCO_HZ 400
+
+// Carrega o programa PIO e configura as state machines e os canais de DMA das faixas
+void saida_led_init(const ConfigSaida *config);
+
+// Pixels no quadro lógico (soma das faixas)
+uint saida_led_num_pixels(void);
+
+// Buffer de trás (quadro lógico), onde o próximo quadro (palavras GRB já codificadas)
+// é desenhado. Pode ser escrito enquanto o quadro anterior ainda está sendo transmitido.
+uint32_t *saida_led_quadro(void);
+
+// Publica o buffer de trás: espera o quadro anterior e o tempo de reset terminarem,
+// troca os buffers e inicia o DMA. Retorna sem esperar a transmissão. Um quadro
+// idêntico ao último transmitido não é retransmitido.
+void saida_led_enviar(void);
+
+// Bloqueia até o último quadro enviado ser transmitido e travado pelos LEDs
+void saida_led_aguardar(void);
+
+// Marca um evento (ex.: tecla pressionada, em time_us_32()); o próximo envio mede a
+// latência até ele. Pode ser chamada do outro núcleo: a marca é uma palavra só.
+void saida_led_marcar(uint32_t evento_us);
+
+// Liga/desliga o modo de alta taxa: o último quadro publicado é reenviado a
+// REFRESCO_HZ com correção de gama e dithering temporal (mais de 8 bits efetivos
+// nos níveis baixos). Pode ser chamada de qualquer núcleo.
+void saida_led_definir_refresco(bool ativo);
+bool saida_led_refresco_ativo(void);
+
+// Refrescos transmitidos e pulados (envio anterior ainda em andamento)
+void saida_led_refresco_contadores(uint32_t *enviados, uint32_t *pulados);
+
+// Quadros enviados desde o início
+uint32_t saida_led_quadros(void);
+
+// Quantos desses eram idênticos ao anterior e não foram retransmitidos
+uint32_t saida_led_repetidos(void);
+
+// Latência evento -> primeiro pixel: última, mínima e máxima, em microssegundos
+typedef struct {
+    uint32_t medicoes;
+    uint32_t ultima_us;
+    uint32_t min_us;
+    uint32_t max_us;
+} LatenciaSaida;
+
+const LatenciaSaida *saida_led_latencia(void);
+
+#endif
@@ -0,0 +1,144 @@
+#include "sequenciador.h"
+#include "compactacao.h"
+#include "agendador.h"
+#include "buzzer.h"
+#include "paleta.h"
+
+// Duração máxima de uma nota no buzzer; NOTA soa até o próximo evento de som
+#define NOTA_MAX_MS 60000
+
+static volatile uint16_t andamento = 100;
+static volatile uint32_t atraso_max_us = 0;
+
+// Conversão tique -> instante: um ponto de referência e o andamento a partir dele.
+// Cada mudança de andamento move a referência para o tempo calculado do evento,
+// não para o relógio, então o arredondamento não se acumula.
+typedef struct {
+    uint64_t us_ref;
+    uint32_t tique_ref;
+    uint32_t bpm;
+    uint32_t percentual;
+} Relogio;
+
+static uint64_t instante(const Relogio *r, uint32_t tique) {
+    uint64_t divisor = (uint64_t)r->bpm * r->percentual * SEQ_TIQUES_POR_BATIDA;
+    return r->us_ref + (uint64_t)(tique - r->tique_ref) * 60000000ull * 100 / divisor;
+}
+
+static void reancorar(Relogio *r, uint32_t tique, uint32_t bpm, uint32_t percentual) {
+    r->us_ref = instante(r, tique);
+    r->tique_ref = tique;
+    r->bpm = bpm;
+    r->percentual = percentual;
+}
+
+// Leva o leitor ao quadro q. Em ordem é só avançar; fora de ordem recomeça e
+// decodifica até lá (as animações têm poucas dezenas de quadros).
+static void posicionar(LeitorQuadros *l, int q) {
+    if (q >= l->anim->num_frames) {
+        return;
+    }
+    int proximo = l->quadro == l->anim->num_frames ? 0 : l->quadro;
+    if (q != proximo) {
+        leitor_iniciar(l, l->anim);
+        while (l->quadro < q) {
+            leitor_proximo(l);
+        }
+    }
+    leitor_proximo(l);
+}
+
+void executar_sequencia(const Sequencia *s) {
+    QuadroPaleta quadro;
+    paleta_cor(&quadro, s->anim->r, s->anim->g, s->anim->b);
+
+    LeitorQuadros leitor;
+    leitor_iniciar(&leitor, s->anim);
+    bool tem_quadro = false, soando = false;
+
+    Relogio relogio = {
+        .us_ref = time_us_64(),
+        .bpm = s->bpm,
+        .percentual = andamento,
+    };
+
+    for (const EventoSeq *e = s->eventos; ; ) {
+        uint32_t percentual = andamento;
+        if (percentual != relogio.percentual) {
+            reancorar(&relogio, e->tique, relogio.bpm, percentual);
+        }
+        uint64_t prazo = instante(&relogio, e->tique);
+        if (!agendador_esperar_ate(prazo)) {
+            break; // Outra tecla foi pressionada
+        }
+        uint32_t atraso = (uint32_t)(time_us_64() - prazo);
+        if (atraso > atraso_max_us) {
+            atraso_max_us = atraso;
+        }
+
+        // Todos os eventos do mesmo tique, com um envio só para os LEDs
+        bool desenhar = false, fim = false;
+        uint32_t tique = e->tique;
+        for (; e->tique == tique && !fim; e++) {
+            switch (e->tipo) {
+            case EVENTO_NOTA:
+                buzzer_tone(e->a, NOTA_MAX_MS);
+                soando = true;
+                break;
+            case EVENTO_SOLTA:
+                buzzer_tone(0, 0);
+                soando = false;
+                break;
+            case EVENTO_QUADRO:
+                posicionar(&leitor, e->a);
+                paleta_carregar(&quadro, leitor.niveis);
+                tem_quadro = true;
+                desenhar = true;
+                break;
+            case EVENTO_COR:
+                paleta_cor(&quadro, e->r, e->g, e->b);
+                desenhar = tem_quadro;
+                break;
+            case EVENTO_PALETA:
+                paleta_definir(&quadro, e->a, e->r, e->g, e->b);
+                desenhar = tem_quadro;
+                break;
+            case EVENTO_ANDAMENTO:
+                reancorar(&relogio, tique, e->a, relogio.percentual);
+                break;
+            case EVENTO_FIM:
+                fim = true;
+                break;
+            }
+        }
+
+        if (desenhar) {
+            paleta_desenhar(&quadro, saida_led_quadro());
+            saida_led_enviar();
+        }
+        if (fim) {
+            break;
+        }
+    }
+
+    if (soando) {
+        buzzer_tone(0, 0); // Não deixa uma nota presa se a sequência parou no meio
+    }
+}
+
+void sequenciador_definir_andamento(uint percentual) {
+    if (percentual < SEQ_ANDAMENTO_MIN) {
+        percentual = SEQ_ANDAMENTO_MIN;
+    } else if (percentual > SEQ_ANDAMENTO_MAX) {
+        percentual = SEQ_ANDAMENTO_MAX;
+    }
+    andamento = (uint16_t)percentual;
+}
+
+uint sequenciador_andamento(void) {
+    return andamento;
+}
+
+uint32_t sequenciador_atraso_max_us(void) {
+    return atraso_max_us;
+}
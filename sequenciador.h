@@ -0,0 +1,63 @@
+#ifndef SEQUENCIADOR_H
+#define SEQUENCIADOR_H
+
+#include "pico/stdlib.h"
+#include "animacao.h"
+
+// Sequências: uma lista de eventos ordenada pelo tempo, em tiques musicais, que
+// comanda o buzzer e os LEDs juntos. O tempo de cada evento é calculado a partir
+// do mesmo instante inicial no timer do hardware (time_us_64) e do andamento,
+// então som e imagem não se afastam, em qualquer andamento. A imagem é um quadro
+// com paleta (paleta.h): eventos COR e PALETA só mudam as cores da paleta.
+
+// Resolução: tiques por batida (semínima)
+#define SEQ_TIQUES_POR_BATIDA 120
+
+// Andamento global, em % do andamento escrito em cada sequência
+#define SEQ_ANDAMENTO_MIN 25
+#define SEQ_ANDAMENTO_MAX 400
+
+typedef enum {
+    EVENTO_NOTA,        // a = frequência em Hz; soa até o próximo NOTA ou SOLTA
+    EVENTO_SOLTA,       // Silencia
+    EVENTO_QUADRO,      // a = índice do quadro da animação da sequência
+    EVENTO_COR,         // r, g, b em 8.8: cor dos níveis de intensidade
+    EVENTO_PALETA,      // a = nível (índice da paleta), r, g, b em 8.8: cor cheia só desse nível
+    EVENTO_ANDAMENTO,   // a = batidas por minuto a partir deste tique
+    EVENTO_FIM,         // Fim da sequência (o último evento)
+} TipoEvento;
+
+typedef struct {
+    uint32_t tique;
+    uint16_t tipo;
+    uint16_t a;
+    uint16_t r, g, b;
+} EventoSeq;
+
+// Atalhos para escrever as listas; t em tiques
+#define SEQ_NOTA(t, hz)          { .tique = (t), .tipo = EVENTO_NOTA, .a = (hz) }
+#define SEQ_SOLTA(t)             { .tique = (t), .tipo = EVENTO_SOLTA }
+#define SEQ_QUADRO(t, q)         { .tique = (t), .tipo = EVENTO_QUADRO, .a = (q) }
+#define SEQ_COR(t, cr, cg, cb)   { .tique = (t), .tipo = EVENTO_COR, .r = (cr), .g = (cg), .b = (cb) }
+#define SEQ_PALETA(t, n, cr, cg, cb) { .tique = (t), .tipo = EVENTO_PALETA, .a = (n), .r = (cr), .g = (cg), .b = (cb) }
+#define SEQ_ANDAMENTO(t, bpm)    { .tique = (t), .tipo = EVENTO_ANDAMENTO, .a = (bpm) }
+#define SEQ_FIM(t)               { .tique = (t), .tipo = EVENTO_FIM }
+
+typedef struct {
+    const EventoSeq *eventos;   // Ordenados por tique, terminando em SEQ_FIM
+    const Animacao *anim;       // Quadros usados pelos eventos QUADRO (cor inicial: a da animação)
+    uint16_t bpm;               // Andamento inicial
+} Sequencia;
+
+// Toca a sequência; para antes se outra tecla for pressionada
+void executar_sequencia(const Sequencia *s);
+
+// Andamento global em % (100 = como escrito), limitado a SEQ_ANDAMENTO_MIN..MAX.
+// Pode ser mudado de qualquer núcleo, inclusive durante uma sequência.
+void sequenciador_definir_andamento(uint percentual);
+uint sequenciador_andamento(void);
+
+// Maior atraso de um evento em relação ao seu tempo, desde o início (us)
+uint32_t sequenciador_atraso_max_us(void);
+
+#endif
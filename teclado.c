@@ -0,0 +1,220 @@
+#include "teclado.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+static const char keys[4][4] = {
+    {'1', '2', '3', 'A'},
+    {'4', '5', '6', 'B'},
+    {'7', '8', '9', 'C'},
+    {'*', '0', '#', 'D'}
+};
+
+static const uint rows[4] = {ROW1, ROW2, ROW3, ROW4};
+static const uint cols[4] = {COL1, COL2, COL3, COL4};
+
+// Estado de debounce de cada tecla: um integrador que sobe com leituras "pressionada"
+// e desce com leituras "solta"; a tecla só muda de estado nos extremos
+typedef struct {
+    uint8_t integrador;
+    bool pressionada;
+    uint64_t proxima_repeticao_us;
+} EstadoTecla;
+
+static EstadoTecla estados[4][4];
+static int linha_atual = 0;
+static repeating_timer_t timer_varredura;
+
+// Espera por borda: com todas as teclas soltas por TECLADO_OCIOSO_MS, a varredura
+// para, as quatro linhas ficam em nível baixo e qualquer tecla derruba a sua coluna
+static volatile bool espera_borda = false;   // Permitida (modo ocioso)
+static volatile bool esperando = false;      // Varredura parada agora
+static uint ticks_soltas = 0;
+static volatile uint32_t bordas = 0;
+
+// Fila circular: escrita só pela IRQ do timer, lida só pelo código principal
+static EventoTecla fila[TECLADO_FILA];
+static volatile uint fila_inicio = 0;
+static volatile uint fila_fim = 0;
+static volatile uint pressionamentos_pendentes = 0;
+static volatile uint32_t perdidos = 0;
+
+static void publicar(char tecla, TipoEventoTecla tipo, uint64_t agora) {
+    uint proximo = (fila_fim + 1) % TECLADO_FILA;
+    if (proximo == fila_inicio) {
+        perdidos++;
+        return;
+    }
+
+    fila[fila_fim].tecla = tecla;
+    fila[fila_fim].tipo = tipo;
+    fila[fila_fim].tempo_us = agora;
+    fila_fim = proximo;
+
+    if (tipo == TECLA_PRESSIONADA) {
+        pressionamentos_pendentes++;
+    }
+    __sev(); // Acorda quem estiver esperando em WFE
+}
+
+static void atualizar_tecla(int i, int j, bool lida, uint64_t agora) {
+    EstadoTecla *e = &estados[i][j];
+
+    if (lida && e->integrador < TECLADO_DEBOUNCE) {
+        e->integrador++;
+    } else if (!lida && e->integrador > 0) {
+        e->integrador--;
+    }
+
+    if (!e->pressionada && e->integrador == TECLADO_DEBOUNCE) {
+        e->pressionada = true;
+        e->proxima_repeticao_us = agora + TECLADO_ATRASO_REPETICAO_MS * 1000;
+        publicar(keys[i][j], TECLA_PRESSIONADA, agora);
+    } else if (e->pressionada && e->integrador == 0) {
+        e->pressionada = false;
+        publicar(keys[i][j], TECLA_SOLTA, agora);
+    } else if (e->pressionada && agora >= e->proxima_repeticao_us) {
+        e->proxima_repeticao_us += TECLADO_INTERVALO_REPETICAO_MS * 1000;
+        publicar(keys[i][j], TECLA_REPETIDA, agora);
+    }
+}
+
+static void habilitar_bordas(bool habilitar) {
+    for (int j = 0; j < 4; j++) {
+        // Habilitar também descarta bordas antigas ainda registradas
+        gpio_set_irq_enabled(cols[j], GPIO_IRQ_EDGE_FALL, habilitar);
+    }
+}
+
+// Para a varredura com todas as linhas em nível baixo. Retorna false (e a
+// varredura continua) se alguma coluna já estiver baixa: essa tecla não geraria borda.
+static bool parar_varredura(void) {
+    for (int i = 0; i < 4; i++) {
+        gpio_put(rows[i], 0);
+    }
+    habilitar_bordas(true);
+    for (int j = 0; j < 4; j++) {
+        if (gpio_get(cols[j]) == 0) {
+            habilitar_bordas(false);
+            for (int i = 0; i < 4; i++) {
+                gpio_put(rows[i], i != linha_atual);
+            }
+            return false;
+        }
+    }
+    esperando = true;
+    return true;
+}
+
+static bool varrer_linha(repeating_timer_t *t);
+
+// Volta a varrer a partir da linha 0; o debounce começa do zero, como num boot
+static void retomar_varredura(void) {
+    habilitar_bordas(false);
+    esperando = false;
+    ticks_soltas = 0;
+    linha_atual = 0;
+    for (int i = 0; i < 4; i++) {
+        gpio_put(rows[i], i != 0);
+    }
+    add_repeating_timer_us(-TECLADO_TICK_US, varrer_linha, NULL, &timer_varredura);
+}
+
+static void borda_coluna(uint gpio, uint32_t eventos) {
+    if (esperando) {
+        bordas++;
+        retomar_varredura();
+    }
+}
+
+// A cada tick lê as colunas da linha ativada no tick anterior (já estabilizada)
+// e ativa a próxima linha
+static bool varrer_linha(repeating_timer_t *t) {
+    uint64_t agora = time_us_64();
+
+    bool alguma = false;
+    for (int j = 0; j < 4; j++) {
+        atualizar_tecla(linha_atual, j, gpio_get(cols[j]) == 0, agora);
+        alguma |= estados[linha_atual][j].integrador > 0;
+    }
+    ticks_soltas = alguma ? 0 : ticks_soltas + 1;
+
+    // Retornar false cancela o timer até a próxima borda
+    if (espera_borda && ticks_soltas >= TECLADO_OCIOSO_MS * 1000 / TECLADO_TICK_US && parar_varredura()) {
+        return false;
+    }
+
+    gpio_put(rows[linha_atual], 1);
+    linha_atual = (linha_atual + 1) % 4;
+    gpio_put(rows[linha_atual], 0);
+    return true;
+}
+
+void teclado_init(void) {
+    // Configuração das linhas como saída
+    for (int i = 0; i < 4; i++) {
+        gpio_init(rows[i]);
+        gpio_set_dir(rows[i], GPIO_OUT);
+        gpio_put(rows[i], 1);
+    }
+
+    // Configuração das colunas como entrada com pull-up
+    for (int i = 0; i < 4; i++) {
+        gpio_init(cols[i]);
+        gpio_set_dir(cols[i], GPIO_IN);
+        gpio_pull_up(cols[i]);
+    }
+
+    linha_atual = 0;
+    gpio_put(rows[linha_atual], 0);
+
+    // Bordas de descida nas colunas acordam o teclado parado (IRQ deste núcleo)
+    gpio_set_irq_callback(borda_coluna);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    // Atraso negativo: o período é contado de início a início, sem deriva
+    add_repeating_timer_us(-TECLADO_TICK_US, varrer_linha, NULL, &timer_varredura);
+}
+
+bool teclado_ler_evento(EventoTecla *ev) {
+    if (fila_inicio == fila_fim) {
+        return false;
+    }
+
+    *ev = fila[fila_inicio];
+    __dmb(); // Termina a leitura antes de liberar a posição para a IRQ
+    fila_inicio = (fila_inicio + 1) % TECLADO_FILA;
+
+    if (ev->tipo == TECLA_PRESSIONADA) {
+        uint32_t status = save_and_disable_interrupts();
+        pressionamentos_pendentes--;
+        restore_interrupts(status);
+    }
+    return true;
+}
+
+bool teclado_tecla_pendente(void) {
+    return pressionamentos_pendentes > 0;
+}
+
+uint32_t teclado_eventos_perdidos(void) {
+    return perdidos;
+}
+
+void teclado_definir_espera_borda(bool permitir) {
+    espera_borda = permitir;
+    if (!permitir) {
+        uint32_t status = save_and_disable_interrupts();
+        if (esperando) {
+            retomar_varredura();
+        }
+        restore_interrupts(status);
+    }
+}
+
+bool teclado_varrendo(void) {
+    return !esperando;
+}
+
+uint32_t teclado_bordas(void) {
+    return bordas;
+}
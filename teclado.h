@@ -0,0 +1,68 @@
+#ifndef TECLADO_H
+#define TECLADO_H
+
+#include "pico/stdlib.h"
+
+// Teclado Matricial
+#define ROW1 10
+#define ROW2 9
+#define ROW3 8
+#define ROW4 6
+
+#define COL1 5
+#define COL2 4
+#define COL3 3
+#define COL4 2
+
+// Uma linha é lida a cada tick, então a matriz inteira é varrida a cada 4 ticks
+#define TECLADO_TICK_US 1000
+
+// Leituras estáveis seguidas (da mesma linha) para aceitar uma mudança: 5 x 4 ms = 20 ms
+#define TECLADO_DEBOUNCE 5
+
+// Repetição automática enquanto a tecla fica pressionada
+#define TECLADO_ATRASO_REPETICAO_MS 500
+#define TECLADO_INTERVALO_REPETICAO_MS 150
+
+// Teclas todas soltas por esse tempo param a varredura até uma borda (modo ocioso)
+#define TECLADO_OCIOSO_MS 100
+
+// Capacidade da fila de eventos (potência de 2)
+#define TECLADO_FILA 16
+
+typedef enum {
+    TECLA_PRESSIONADA,
+    TECLA_SOLTA,
+    TECLA_REPETIDA
+} TipoEventoTecla;
+
+typedef struct {
+    char tecla;
+    uint8_t tipo;       // TipoEventoTecla
+    uint64_t tempo_us;  // Momento em que o evento foi aceito
+} EventoTecla;
+
+// Configura os GPIOs do teclado e inicia a varredura em segundo plano (IRQ de timer)
+void teclado_init(void);
+
+// Retira o próximo evento da fila; retorna false se ela estiver vazia
+bool teclado_ler_evento(EventoTecla *ev);
+
+// Indica se há algum pressionamento na fila ainda não lido
+bool teclado_tecla_pendente(void);
+
+// Eventos descartados porque a fila estava cheia
+uint32_t teclado_eventos_perdidos(void);
+
+// Permite parar a varredura com as teclas soltas: as linhas ficam em nível baixo e
+// uma borda de descida em qualquer coluna a retoma (o timer de 1 ms deixa de
+// acordar a CPU). A tecla que acorda passa pelo debounce normal, com até um tick a mais.
+void teclado_definir_espera_borda(bool permitir);
+
+// false enquanto a varredura está parada esperando uma borda
+bool teclado_varrendo(void);
+
+// Vezes que uma borda retomou a varredura
+uint32_t teclado_bordas(void);
+
+#endif
@@ -0,0 +1,251 @@
+#include <string.h>
+#include "texto.h"
+#include "procedural.h"
+#include "saida_led.h"
+#include "agendador.h"
+#include "cores.h"
+#include "hardware/sync.h"
+
+// Glifo: colunas da esquerda para a direita, bit 0 = linha de cima
+typedef struct {
+    uint8_t largura;
+    uint8_t colunas[5];
+} Glifo;
+
+// ASCII de ' ' (32) a '_' (95); as minúsculas usam as maiúsculas
+static const Glifo fonte[] = {
+    { 2, { 0x00, 0x00, 0x00, 0x00, 0x00 } }, // ' '
+    { 1, { 0x17, 0x00, 0x00, 0x00, 0x00 } }, // '!'
+    { 3, { 0x03, 0x00, 0x03, 0x00, 0x00 } }, // '"'
+    { 5, { 0x0A, 0x1F, 0x0A, 0x1F, 0x0A } }, // '#'
+    { 5, { 0x12, 0x15, 0x1F, 0x15, 0x09 } }, // '$'
+    { 5, { 0x11, 0x08, 0x04, 0x02, 0x11 } }, // '%'
+    { 4, { 0x0A, 0x15, 0x0A, 0x10, 0x00 } }, // '&'
+    { 1, { 0x03, 0x00, 0x00, 0x00, 0x00 } }, // '\''
+    { 2, { 0x0E, 0x11, 0x00, 0x00, 0x00 } }, // '('
+    { 2, { 0x11, 0x0E, 0x00, 0x00, 0x00 } }, // ')'
+    { 3, { 0x05, 0x02, 0x05, 0x00, 0x00 } }, // '*'
+    { 3, { 0x04, 0x0E, 0x04, 0x00, 0x00 } }, // '+'
+    { 2, { 0x10, 0x08, 0x00, 0x00, 0x00 } }, // ','
+    { 3, { 0x04, 0x04, 0x04, 0x00, 0x00 } }, // '-'
+    { 1, { 0x10, 0x00, 0x00, 0x00, 0x00 } }, // '.'
+    { 4, { 0x08, 0x04, 0x02, 0x01, 0x00 } }, // '/'
+    { 4, { 0x0E, 0x11, 0x11, 0x0E, 0x00 } }, // '0'
+    { 3, { 0x12, 0x1F, 0x10, 0x00, 0x00 } }, // '1'
+    { 4, { 0x19, 0x15, 0x15, 0x12, 0x00 } }, // '2'
+    { 4, { 0x11, 0x15, 0x15, 0x0A, 0x00 } }, // '3'
+    { 4, { 0x07, 0x04, 0x04, 0x1F, 0x00 } }, // '4'
+    { 4, { 0x17, 0x15, 0x15, 0x09, 0x00 } }, // '5'
+    { 4, { 0x0E, 0x15, 0x15, 0x08, 0x00 } }, // '6'
+    { 4, { 0x01, 0x19, 0x05, 0x03, 0x00 } }, // '7'
+    { 4, { 0x0A, 0x15, 0x15, 0x0A, 0x00 } }, // '8'
+    { 4, { 0x02, 0x15, 0x15, 0x0E, 0x00 } }, // '9'
+    { 1, { 0x0A, 0x00, 0x00, 0x00, 0x00 } }, // ':'
+    { 2, { 0x10, 0x0A, 0x00, 0x00, 0x00 } }, // ';'
+    { 3, { 0x04, 0x0A, 0x11, 0x00, 0x00 } }, // '<'
+    { 3, { 0x0A, 0x0A, 0x0A, 0x00, 0x00 } }, // '='
+    { 3, { 0x11, 0x0A, 0x04, 0x00, 0x00 } }, // '>'
+    { 4, { 0x01, 0x15, 0x05, 0x02, 0x00 } }, // '?'
+    { 5, { 0x0E, 0x11, 0x15, 0x15, 0x06 } }, // '@'
+    { 4, { 0x1E, 0x05, 0x05, 0x1E, 0x00 } }, // 'A'
+    { 4, { 0x1F, 0x15, 0x15, 0x0A, 0x00 } }, // 'B'
+    { 4, { 0x0E, 0x11, 0x11, 0x11, 0x00 } }, // 'C'
+    { 4, { 0x1F, 0x11, 0x11, 0x0E, 0x00 } }, // 'D'
+    { 4, { 0x1F, 0x15, 0x15, 0x11, 0x00 } }, // 'E'
+    { 4, { 0x1F, 0x05, 0x05, 0x01, 0x00 } }, // 'F'
+    { 4, { 0x0E, 0x11, 0x15, 0x1D, 0x00 } }, // 'G'
+    { 4, { 0x1F, 0x04, 0x04, 0x1F, 0x00 } }, // 'H'
+    { 3, { 0x11, 0x1F, 0x11, 0x00, 0x00 } }, // 'I'
+    { 4, { 0x08, 0x10, 0x11, 0x0F, 0x00 } }, // 'J'
+    { 4, { 0x1F, 0x04, 0x0A, 0x11, 0x00 } }, // 'K'
+    { 4, { 0x1F, 0x10, 0x10, 0x10, 0x00 } }, // 'L'
+    { 5, { 0x1F, 0x02, 0x04, 0x02, 0x1F } }, // 'M'
+    { 5, { 0x1F, 0x02, 0x04, 0x08, 0x1F } }, // 'N'
+    { 4, { 0x0E, 0x11, 0x11, 0x0E, 0x00 } }, // 'O'
+    { 4, { 0x1F, 0x05, 0x05, 0x02, 0x00 } }, // 'P'
+    { 5, { 0x0E, 0x11, 0x19, 0x1E, 0x10 } }, // 'Q'
+    { 4, { 0x1F, 0x05, 0x0D, 0x12, 0x00 } }, // 'R'
+    { 4, { 0x12, 0x15, 0x15, 0x09, 0x00 } }, // 'S'
+    { 5, { 0x01, 0x01, 0x1F, 0x01, 0x01 } }, // 'T'
+    { 4, { 0x0F, 0x10, 0x10, 0x0F, 0x00 } }, // 'U'
+    { 5, { 0x07, 0x08, 0x10, 0x08, 0x07 } }, // 'V'
+    { 5, { 0x1F, 0x08, 0x04, 0x08, 0x1F } }, // 'W'
+    { 5, { 0x11, 0x0A, 0x04, 0x0A, 0x11 } }, // 'X'
+    { 5, { 0x01, 0x02, 0x1C, 0x02, 0x01 } }, // 'Y'
+    { 4, { 0x19, 0x15, 0x15, 0x13, 0x00 } }, // 'Z'
+    { 2, { 0x1F, 0x11, 0x00, 0x00, 0x00 } }, // '['
+    { 4, { 0x01, 0x02, 0x04, 0x08, 0x00 } }, // '\\'
+    { 2, { 0x11, 0x1F, 0x00, 0x00, 0x00 } }, // ']'
+    { 3, { 0x02, 0x01, 0x02, 0x00, 0x00 } }, // '^'
+    { 4, { 0x10, 0x10, 0x10, 0x10, 0x00 } }, // '_'
+};
+
+#define PRIMEIRO ' '
+#define ULTIMO '_'
+
+// Letra base de U+00C0..U+00FF (À..ÿ), para desenhar os acentuados sem o acento
+static const char latin1_base[] = "AAAAAAACEEEEIIIIDNOOOOOXOUUUUYPSAAAAAAACEEEEIIIIDNOOOOO/OUUUUYPY";
+
+// Lê um caractere de `*p` (UTF-8) e avança; retorna o código ASCII do glifo
+static char proximo_caractere(const char **p) {
+    uint8_t c = (uint8_t)*(*p)++;
+    if (c >= 0x80) {
+        uint8_t b = (uint8_t)**p;
+        bool latin1 = (c == 0xC3) && (b & 0xC0) == 0x80;
+        while ((**p & 0xC0) == 0x80) {
+            (*p)++; // Bytes de continuação
+        }
+        return latin1 ? latin1_base[b & 0x3F] : '?';
+    }
+    if (c >= 'a' && c <= 'z') {
+        c -= 'a' - 'A';
+    }
+    return (c >= PRIMEIRO && c <= ULTIMO) ? (char)c : '?';
+}
+
+// Percorre o texto coluna a coluna: as do glifo e depois uma vazia
+typedef struct {
+    const char *p;
+    const Glifo *glifo;   // NULL: fim do texto
+    uint coluna;          // Próxima coluna do glifo (largura = a coluna vazia)
+    uint letra;           // Índice da letra atual, sem contar os espaços
+    bool espaco;
+} Cursor;
+
+static void cursor_proximo_glifo(Cursor *c) {
+    if (*c->p == '\0') {
+        c->glifo = NULL;
+        return;
+    }
+    if (c->glifo && !c->espaco) {
+        c->letra++;
+    }
+    char ch = proximo_caractere(&c->p);
+    c->glifo = &fonte[ch - PRIMEIRO];
+    c->espaco = ch == ' ';
+    c->coluna = 0;
+}
+
+static void cursor_iniciar(Cursor *c, const char *texto) {
+    *c = (Cursor) { .p = texto };
+    cursor_proximo_glifo(c);
+}
+
+// Bits da próxima coluna (0 depois do fim) e a letra a que ela pertence
+static uint8_t cursor_coluna(Cursor *c, uint *letra) {
+    if (!c->glifo) {
+        return 0;
+    }
+    uint8_t bits = c->coluna < c->glifo->largura ? c->glifo->colunas[c->coluna] : 0;
+    *letra = c->letra;
+    if (++c->coluna > c->glifo->largura) {
+        cursor_proximo_glifo(c);
+    }
+    return bits;
+}
+
+// Pula n colunas, um glifo inteiro por vez quando dá
+static void cursor_pular(Cursor *c, uint n) {
+    while (n > 0 && c->glifo) {
+        uint resto = c->glifo->largura + 1 - c->coluna;
+        if (n >= resto) {
+            n -= resto;
+            cursor_proximo_glifo(c);
+        } else {
+            c->coluna += n;
+            n = 0;
+        }
+    }
+}
+
+uint texto_largura(const char *texto) {
+    uint largura = 0;
+    while (*texto) {
+        largura += fonte[proximo_caractere(&texto) - PRIMEIRO].largura + 1;
+    }
+    return largura;
+}
+
+void texto_renderizar(const char *texto, const EstiloTexto *e, uint32_t posicao,
+                      uint32_t *quadro, uint largura, uint altura) {
+    // O pixel x mostra a coluna (x + posicao / 256 - largura) do texto, misturada
+    // com a seguinte na proporção da fração
+    int inicio = (int)(posicao >> 8) - (int)largura;
+    uint fracao = posicao & 0xFF;
+    uint topo = altura > FONTE_ALTURA ? (altura - FONTE_ALTURA) / 2 : 0;
+
+    Cursor cursor;
+    cursor_iniciar(&cursor, texto);
+    if (inicio > 0) {
+        cursor_pular(&cursor, (uint)inicio);
+    }
+
+    // Coluna à esquerda (a) e à direita (b) do pixel, com a letra de cada uma
+    int coluna = inicio;
+    uint letra_a = 0, letra_b = 0;
+    uint8_t a = coluna >= 0 ? cursor_coluna(&cursor, &letra_a) : 0;
+
+    for (uint x = 0; x < largura; x++) {
+        coluna++;
+        uint8_t b = coluna >= 0 ? cursor_coluna(&cursor, &letra_b) : 0;
+
+        for (uint y = 0; y < altura; y++) {
+            uint linha = y - topo; // Fora da fonte dá um valor grande
+            uint32_t pixel = 0;
+            if (linha < FONTE_ALTURA) {
+                uint peso_a = (a >> linha) & 1 ? 256 - fracao : 0;
+                uint peso_b = (b >> linha) & 1 ? fracao : 0;
+                if (peso_a + peso_b > 0) {
+                    // As duas colunas só acendem juntas dentro da mesma letra (há
+                    // sempre uma coluna vazia entre letras), então uma cor basta
+                    const CorTexto *cor = &e->paleta[(peso_a ? letra_a : letra_b) % e->num_cores];
+                    uint n = peso_a + peso_b;
+                    pixel = cor_escalada(cor->r, cor->g, cor->b, (uint8_t)(n > 255 ? 255 : n));
+                }
+            }
+            quadro[raster_indice_em(x, y, largura, altura)] = pixel;
+        }
+
+        a = b;
+        letra_a = letra_b;
+    }
+}
+
+void executar_texto(const char *texto, const EstiloTexto *e) {
+    uint32_t passagem = (MATRIZ_LARGURA + texto_largura(texto)) << 8;
+
+    Agendador ag;
+    agendador_iniciar(&ag, e->fps * 1000);
+    for (uint32_t q = 0; ; q++) {
+        uint64_t deslocamento = (uint64_t)q * e->pixels_por_segundo * 256 / e->fps;
+        if (e->voltas > 0 && deslocamento >= (uint64_t)passagem * e->voltas) {
+            break;
+        }
+        texto_renderizar(texto, e, (uint32_t)(deslocamento % passagem), saida_led_quadro(),
+                         MATRIZ_LARGURA, MATRIZ_ALTURA);
+        saida_led_enviar();
+        if (!agendador_esperar(&ag)) {
+            break; // Outra tecla foi pressionada
+        }
+    }
+}
+
+// Dois buffers: o novo texto é escrito no que não está em uso e só então publicado
+static char textos[2][TEXTO_MAX + 1] = { "OLA!" };
+static volatile uint texto_atual = 0;
+
+void texto_definir(const char *texto) {
+    uint proximo = texto_atual ^ 1;
+    strncpy(textos[proximo], texto, TEXTO_MAX);
+    textos[proximo][TEXTO_MAX] = '\0';
+    __dmb(); // O texto precisa estar visível antes do índice
+    texto_atual = proximo;
+}
+
+void executar_texto_definido(const EstiloTexto *e) {
+    char copia[TEXTO_MAX + 1];
+    uint atual = texto_atual;
+    __dmb();
+    memcpy(copia, textos[atual], sizeof(copia));
+    executar_texto(copia, e);
+}
@@ -0,0 +1,53 @@
+#ifndef TEXTO_H
+#define TEXTO_H
+
+#include "pico/stdlib.h"
+
+// Texto rolante: uma fonte de 5 linhas em flash, cada glifo guardado como colunas
+// (um byte por coluna, bit 0 = linha de cima) com largura variável. A cada quadro
+// o texto é desenhado direto no quadro da saída a partir da posição de rolagem,
+// sem quadros calculados antes para cada texto. A posição tem 8 bits de fração:
+// entre duas colunas, cada pixel divide o brilho entre elas e o texto desliza
+// suavemente em vez de pular uma coluna inteira.
+
+#define FONTE_ALTURA 5
+
+// Bytes (UTF-8) do texto definido em tempo de execução (ex.: pelo USB)
+#define TEXTO_MAX 64
+
+// Cor em ponto fixo 8.8 (use COR_FX)
+typedef struct {
+    uint16_t r, g, b;
+} CorTexto;
+
+typedef struct {
+    const CorTexto *paleta;       // Cor de cada letra, em ciclo (espaços não contam)
+    uint num_cores;
+    uint16_t pixels_por_segundo;  // Velocidade da rolagem, em colunas por segundo
+    uint16_t fps;
+    uint16_t voltas;              // Passagens do texto pela matriz (0 = até outra tecla)
+} EstiloTexto;
+
+// Largura do texto em colunas, com uma coluna vazia depois de cada letra.
+// Aceita ASCII e as letras acentuadas do Latin-1 em UTF-8 (desenhadas sem acento);
+// minúsculas saem como maiúsculas e o resto vira '?'.
+uint texto_largura(const char *texto);
+
+// Desenha o texto em `quadro` (largura x altura pontos, na ordem de
+// raster_indice_em: a do painel montado no tamanho da matriz) na posição
+// `posicao`, em 1/256 de coluna: 0 põe a primeira coluna logo depois da borda
+// direita, e (largura + texto_largura) * 256 tira a última pela borda esquerda.
+// Com altura maior que a fonte, o texto fica centralizado na vertical.
+void texto_renderizar(const char *texto, const EstiloTexto *e, uint32_t posicao,
+                      uint32_t *quadro, uint largura, uint altura);
+
+// Rola o texto na matriz; para antes se outra tecla for pressionada
+void executar_texto(const char *texto, const EstiloTexto *e);
+
+// Texto definido em tempo de execução (cortado em TEXTO_MAX bytes). Pode ser
+// trocado de um núcleo enquanto o outro rola o texto anterior: são dois buffers e
+// executar_texto_definido trabalha numa cópia tirada no início.
+void texto_definir(const char *texto);
+void executar_texto_definido(const EstiloTexto *e);
+
+#endif